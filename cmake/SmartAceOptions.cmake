@@ -15,4 +15,9 @@ macro(configure_smartace)
     else()
         message(FATAL_ERROR "Invalid integer model: ${INT_MODEL}")
     endif()
+
+    option(REENTRANT "Gives each thread its own runtime state (use with --reentrant)." OFF)
+    if(REENTRANT)
+        add_definitions(-DMC_USE_REENTRANT)
+    endif()
 endmacro()
@@ -1,3 +1,8 @@
 # A simple target to build the interactive model.
 add_executable(icmodel ${EXE_SRCS_COMMON} ${EXE_HARNESSED_CPP})
 target_link_libraries(icmodel verify_interactive)
+
+# An optimized build of the interactive model, for long sessions.
+add_executable(icmodel-fast ${EXE_SRCS_COMMON} ${EXE_HARNESSED_CPP})
+target_link_libraries(icmodel-fast verify_interactive -flto)
+set_target_properties(icmodel-fast PROPERTIES COMPILE_FLAGS "-O3 -flto")
@@ -86,6 +86,7 @@ if(KLEE_EXE)
     if(KLEE_LIB AND LLVM_LINK_EXE)
         set(KLEE_FLAGS "")
         list(APPEND KLEE_FLAGS "-DMC_USE_STDINT")
+        list(APPEND KLEE_FLAGS "-DMC_USE_SYMBOLIC")
         list(APPEND KLEE_FLAGS "-emit-llvm")
         list(APPEND KLEE_FLAGS "-c")
         list(APPEND KLEE_FLAGS "-g")
@@ -1,29 +1,63 @@
+# If the model is generated with --snapshots, then world states are cached across inputs.
+# Snapshots copy the world bytewise, so they are only cached with the stdint integer model.
+set(FUZZ_DEFS MC_USE_COVERAGE)
+if(INT_MODEL STREQUAL "${INT_MODEL_STDINT}")
+    list(APPEND FUZZ_DEFS MC_USE_SNAPSHOTS)
+endif()
+
 # Links cmodel.c with the fuzzer harness.
-add_executable(fuzztest ${EXE_SRCS_COMMON} ${EXE_SRCS_CPP} libverify/verify_libfuzzer.cpp)
+add_executable(
+    fuzztest
+    ${EXE_SRCS_COMMON}
+    ${EXE_SRCS_CPP}
+    libverify/verify_libfuzzer.cpp
+    libverify/verify_profile.cpp
+)
+target_compile_definitions(fuzztest PRIVATE ${FUZZ_DEFS})
 target_link_libraries(fuzztest -fsanitize=fuzzer,address)
 set_target_properties(fuzztest PROPERTIES COMPILE_FLAGS "-g -fsanitize=fuzzer,address")
 
+# Links cmodel.c with the seed generator.
+# Each seed executes one transaction of the model, as encoded for fuzztest.
+add_executable(
+    fuzzseed
+    ${EXE_SRCS_COMMON}
+    ${EXE_SRCS_CPP}
+    libverify/verify_seedgen.cpp
+)
+
 # Adds a command to generate the corpus directory.
-# This is where fuzzer results are cached.
+# This is where fuzzer results are cached, starting from the generated seeds.
 set(CORPUS_DIR "corpus_dir")
 set(CORPUS_DIR_FULL "${CMAKE_BINARY_DIR}/${CORPUS_DIR}")
 add_custom_command(
     OUTPUT ${CORPUS_DIR}
     COMMAND ${CMAKE_COMMAND} -E make_directory ${CORPUS_DIR_FULL}
+    COMMAND "${CMAKE_BINARY_DIR}/fuzzseed" ${CORPUS_DIR_FULL}
+    DEPENDS fuzzseed
 )
 
+# The dictionary generated alongside the model.
+set(FUZZ_DICT "${CMAKE_CURRENT_SOURCE_DIR}/fuzz.dict")
+
 # Parameters to configure libfuzzer.
 set(FUZZ_MAX_LEN "0" CACHE STRING "Maximum length of a test input (forwarded).")
 set(FUZZ_RUNS "1000000" CACHE STRING "Number of individual test runs (forwarded).")
 set(FUZZ_TIMEOUT "15" CACHE STRING "Timeout in seconds (forwarded).")
 
 # User-facing command to generate fuzztest, and execute it with the default arguments.
+# Inputs are not reduced, as an input resumed from a snapshot does not reach the edges of its
+# cached prefix, and may therefore appear to lose features.
 set(CMODEL_FUZZ_ARGS "")
 list(APPEND CMODEL_FUZZ_ARGS "-max_len=${FUZZ_MAX_LEN}")
 list(APPEND CMODEL_FUZZ_ARGS "-runs=${FUZZ_RUNS}")
 list(APPEND CMODEL_FUZZ_ARGS "-timeout=${FUZZ_TIMEOUT}")
 list(APPEND CMODEL_FUZZ_ARGS "-use_value_profile=1")
 list(APPEND CMODEL_FUZZ_ARGS "-print_final_stats=1")
+list(APPEND CMODEL_FUZZ_ARGS "-reduce_inputs=0")
+if(EXISTS ${FUZZ_DICT})
+    list(APPEND CMODEL_FUZZ_ARGS "-dict=${FUZZ_DICT}")
+endif()
 add_custom_target(
     fuzz
     COMMAND "${CMAKE_BINARY_DIR}/fuzztest" ${CORPUS_DIR} ${CMODEL_FUZZ_ARGS}
@@ -31,3 +65,91 @@ add_custom_target(
     COMMAND_EXPAND_LISTS
 )
 add_dependencies(fuzz fuzztest)
+
+# Links cmodel.c with the fuzzer harness, optimized for throughput.
+# Sanitizers are disabled, so findings should be confirmed with fuzz-confirm.
+set(FUZZ_FAST_FLAGS "-g -O3 -flto -fsanitize=fuzzer")
+add_executable(
+    fuzztest-fast
+    ${EXE_SRCS_COMMON}
+    ${EXE_SRCS_CPP}
+    libverify/verify_libfuzzer.cpp
+    libverify/verify_profile.cpp
+)
+target_compile_definitions(fuzztest-fast PRIVATE ${FUZZ_DEFS})
+target_link_libraries(fuzztest-fast -flto -fsanitize=fuzzer)
+
+# If enabled, fuzztest-fast is built in three stages. First, an instrumented build replays the
+# corpus. Second, the raw profiles are merged. Third, fuzztest-fast is built with the profile.
+# The profile is kept until fuzztest.profdata is removed, or the instrumented build changes. To
+# profile a larger corpus, remove fuzztest.profdata, and then rebuild fuzztest-fast from clean.
+option(FUZZ_PGO "Optimizes fuzztest-fast with a profile of the corpus (requires llvm-profdata)." OFF)
+if(FUZZ_PGO)
+    find_program(
+        LLVM_PROFDATA_EXE
+        NAMES "llvm-profdata-10" "llvm-profdata"
+        DOC "Path to llvm-profdata executable"
+    )
+    if(NOT LLVM_PROFDATA_EXE)
+        message(FATAL_ERROR "FUZZ_PGO requires llvm-profdata.")
+    endif()
+
+    add_executable(
+        fuzztest-pgo
+        ${EXE_SRCS_COMMON}
+        ${EXE_SRCS_CPP}
+        libverify/verify_libfuzzer.cpp
+        libverify/verify_profile.cpp
+    )
+    target_compile_definitions(fuzztest-pgo PRIVATE ${FUZZ_DEFS})
+    target_link_libraries(fuzztest-pgo -fsanitize=fuzzer -fprofile-instr-generate)
+    set_target_properties(
+        fuzztest-pgo PROPERTIES COMPILE_FLAGS "-O3 -fsanitize=fuzzer -fprofile-instr-generate"
+    )
+
+    # Running with -runs=0 executes each input of the corpus once, and then exits.
+    set(FUZZ_PROFILE_RAW "${CMAKE_BINARY_DIR}/fuzztest_profraw")
+    set(FUZZ_PROFILE "${CMAKE_BINARY_DIR}/fuzztest.profdata")
+    add_custom_command(
+        OUTPUT ${FUZZ_PROFILE}
+        COMMAND ${CMAKE_COMMAND} -E remove_directory ${FUZZ_PROFILE_RAW}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${FUZZ_PROFILE_RAW}
+        COMMAND
+            ${CMAKE_COMMAND} -E env "LLVM_PROFILE_FILE=${FUZZ_PROFILE_RAW}/%p.profraw"
+            "${CMAKE_BINARY_DIR}/fuzztest-pgo" -runs=0 ${CORPUS_DIR_FULL}
+        COMMAND ${LLVM_PROFDATA_EXE} merge "-output=${FUZZ_PROFILE}" ${FUZZ_PROFILE_RAW}
+        DEPENDS fuzztest-pgo ${CORPUS_DIR}
+    )
+    add_custom_target(fuzz-profile DEPENDS ${FUZZ_PROFILE})
+
+    add_dependencies(fuzztest-fast fuzz-profile)
+    set(FUZZ_FAST_FLAGS "${FUZZ_FAST_FLAGS} -fprofile-instr-use=${FUZZ_PROFILE}")
+endif()
+set_target_properties(fuzztest-fast PROPERTIES COMPILE_FLAGS "${FUZZ_FAST_FLAGS}")
+
+# User-facing command to generate fuzztest-fast, and execute it with the default arguments.
+# Failing inputs are written to fast_findings, rather than to the working directory.
+set(FUZZ_FINDINGS "fast_findings")
+set(FUZZ_FINDINGS_FULL "${CMAKE_BINARY_DIR}/${FUZZ_FINDINGS}")
+add_custom_target(
+    fuzz-fast
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${FUZZ_FINDINGS_FULL}
+    COMMAND
+        "${CMAKE_BINARY_DIR}/fuzztest-fast" ${CORPUS_DIR} ${CMODEL_FUZZ_ARGS}
+        "-artifact_prefix=${FUZZ_FINDINGS_FULL}/"
+    DEPENDS ${CORPUS_DIR}
+    COMMAND_EXPAND_LISTS
+)
+add_dependencies(fuzz-fast fuzztest-fast)
+
+# User-facing command to replay each finding of fuzztest-fast with fuzztest.
+add_custom_target(
+    fuzz-confirm
+    COMMAND
+        ${CMAKE_COMMAND}
+        "-DFUZZ_EXE=${CMAKE_BINARY_DIR}/fuzztest"
+        "-DFUZZ_FINDINGS=${FUZZ_FINDINGS_FULL}"
+        "-DFUZZ_TIMEOUT=${FUZZ_TIMEOUT}"
+        -P "${MC_CMAKE_DIR}/ReplayFindings.cmake"
+)
+add_dependencies(fuzz-confirm fuzztest)
@@ -0,0 +1,35 @@
+# Replays each finding of the optimized fuzzer with the sanitized fuzzer.
+# A finding is confirmed if it also fails in the sanitized build.
+#
+# Usage: cmake -DFUZZ_EXE=<fuzzer> -DFUZZ_FINDINGS=<dir> [-DFUZZ_TIMEOUT=<s>] -P ReplayFindings.cmake
+
+if(NOT FUZZ_EXE OR NOT FUZZ_FINDINGS)
+    message(FATAL_ERROR "FUZZ_EXE and FUZZ_FINDINGS must be set.")
+endif()
+if(NOT FUZZ_TIMEOUT)
+    set(FUZZ_TIMEOUT "15")
+endif()
+
+file(GLOB findings "${FUZZ_FINDINGS}/*")
+set(total 0)
+set(confirmed 0)
+foreach(finding ${findings})
+    math(EXPR total "${total} + 1")
+    execute_process(
+        COMMAND ${FUZZ_EXE} "-timeout=${FUZZ_TIMEOUT}" ${finding}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE log
+        ERROR_VARIABLE log
+    )
+    if(result EQUAL 0)
+        message(STATUS "Not reproduced: ${finding}")
+    else()
+        math(EXPR confirmed "${confirmed} + 1")
+        message(STATUS "Confirmed: ${finding}\n${log}")
+    endif()
+endforeach()
+
+message(STATUS "Confirmed ${confirmed} of ${total} findings.")
+if(confirmed GREATER 0)
+    message(FATAL_ERROR "Findings were reproduced by ${FUZZ_EXE}.")
+endif()
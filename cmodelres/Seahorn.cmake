@@ -46,6 +46,7 @@ foreach(d ${CMODEL_COMPILE_DEFS_RAW})
     list(APPEND CMODEL_COMPILE_DEFS "-D${d}")
 endforeach(d)
 list(APPEND CMODEL_COMPILE_DEFS "-DMC_USE_EXTERNAL_NONDET")
+list(APPEND CMODEL_COMPILE_DEFS "-DMC_USE_SYMBOLIC")
 
 # Sets solver mode.
 set(HORN_SOLVER_LIA "lia")
@@ -0,0 +1,37 @@
+# Links cmodel.c with the random simulation runtime.
+# The model must be generated with --reentrant, as runs share the process.
+file(STRINGS "${CMAKE_CURRENT_SOURCE_DIR}/cmodel.h" SIM_REENTRANT REGEX "^#define SOL_MODEL_REENTRANT")
+if(NOT SIM_REENTRANT)
+    message(WARNING "simtest requires a model generated with --reentrant, and will not build.")
+endif()
+find_package(Threads REQUIRED)
+add_executable(
+    simtest
+    ${EXE_SRCS_COMMON}
+    ${EXE_SRCS_CPP}
+    libverify/verify_random.cpp
+    libverify/verify_profile.cpp
+)
+target_compile_definitions(simtest PRIVATE MC_USE_REENTRANT MC_USE_COVERAGE)
+target_link_libraries(simtest Threads::Threads ${Boost_PROGRAM_OPTIONS_LIBRARIES})
+set_target_properties(simtest PROPERTIES COMPILE_FLAGS "-O2")
+
+# Parameters to configure the simulation.
+set(SIM_THREADS "0" CACHE STRING "Number of simulation threads, or 0 for all cores (forwarded).")
+set(SIM_RUNS "100000" CACHE STRING "Number of runs across all threads (forwarded).")
+set(SIM_DEPTH "64" CACHE STRING "Maximum number of transactions per run (forwarded).")
+set(SIM_SEED "1" CACHE STRING "Seed of the first run (forwarded).")
+
+# User-facing command to generate simtest, and execute it with the default arguments.
+# Failing runs are added to failures.txt, as the simtest arguments which replay them.
+set(CMODEL_SIM_ARGS "")
+list(APPEND CMODEL_SIM_ARGS "--threads=${SIM_THREADS}")
+list(APPEND CMODEL_SIM_ARGS "--runs=${SIM_RUNS}")
+list(APPEND CMODEL_SIM_ARGS "--depth=${SIM_DEPTH}")
+list(APPEND CMODEL_SIM_ARGS "--seed=${SIM_SEED}")
+add_custom_target(
+    simulate
+    COMMAND "${CMAKE_BINARY_DIR}/simtest" ${CMODEL_SIM_ARGS}
+    COMMAND_EXPAND_LISTS
+)
+add_dependencies(simulate simtest)
@@ -224,6 +224,16 @@ RoleExtractor::RoleExtractor(
         {
             check_map_conformance(var);
         }
+        else if (type->category() == Type::Category::Array)
+        {
+            // As with mappings, entries are never addresses.
+            auto array = dynamic_cast<ArrayType const*>(type);
+            auto base_type = array->baseType();
+            if (base_type->category() == Type::Category::Address)
+            {
+                record_violation(AddressViolation::Type::ValueType, var);
+            }
+        }
         else if (type->category() == Type::Category::Struct)
         {
             auto structure = dynamic_cast<StructType const*>(var->type());
@@ -56,7 +56,7 @@ AnalysisStack::AnalysisStack(
 	InheritanceModel const& _model,
 	std::vector<SourceUnit const*> _full,
 	AnalysisSettings const&_settings
-)
+): M_SETTINGS(_settings)
 {
 	m_structure_store = make_shared<StructureStore>();
 
@@ -157,6 +157,16 @@ shared_ptr<TypeAnalyzer const> AnalysisStack::types() const
 	return m_types;
 }
 
+AnalysisSettings const& AnalysisStack::settings() const
+{
+	return M_SETTINGS;
+}
+
+size_t AnalysisStack::next_site() const
+{
+	return m_site_count++;
+}
+
 // -------------------------------------------------------------------------- //
 
 }
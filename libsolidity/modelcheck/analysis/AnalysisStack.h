@@ -62,6 +62,34 @@ struct AnalysisSettings
     bool escalate_reqs = false;
     // If true, fallbacks through sends and transfers are allowed.
     bool allow_fallbacks = false;
+    // If true, map entries accessed several times in a row are cached (see
+    // MapAccessCache).
+    bool cache_map_reads = false;
+    // If true, loops with an inferred bound are bounded in the model (see
+    // LoopBounds). Each loop of exactly n iterations, with n at most
+    // unroll_limit, is instead unrolled.
+    bool bound_loops = false;
+    size_t unroll_limit = 8;
+    // If true, keccak256 is passed the encoded bytes of its operands, whenever
+    // they are of simple types. Otherwise, keccak256 is overapproximated.
+    bool native_crypto = false;
+    // If true, commuting transactions are only scheduled in a single canonical
+    // order (see PartialOrderReduction).
+    bool reduce_order = false;
+    // If true, interchangeable users are only chosen in a single canonical
+    // order (see AddressSpace).
+    bool reduce_users = false;
+    // If true, all globals are lifted into a context owned by run_model, so
+    // that several instances of the model may run at once.
+    bool reentrant = false;
+    // If true, the world state is offered to the runtime between transactions,
+    // and setup may be replaced by restoring a cached world state.
+    bool snapshots = false;
+    // If true, transactions which can neither change the state of the model
+    // nor fail an assertion are not scheduled (see StateFootprint).
+    bool elide_getters = false;
+    // If true, each transaction, require and assume is labeled for coverage.
+    bool instrument = false;
 };
 
 // -------------------------------------------------------------------------- //
@@ -114,7 +142,18 @@ public:
     // Returns the type analyzer.
     std::shared_ptr<TypeAnalyzer const> types() const;
 
+    // Returns the settings used to configure this stack.
+    AnalysisSettings const& settings() const;
+
+    // Returns a new site, to label a require or assume of the model. Sites are
+    // unique to this stack, and are allocated from zero as the model is built.
+    size_t next_site() const;
+
 private:
+    AnalysisSettings const M_SETTINGS;
+
+    mutable size_t m_site_count = 0;
+
     std::shared_ptr<StructureStore> m_structure_store;
     std::shared_ptr<AllocationGraph> m_allocation_graph;
     std::shared_ptr<FlatModel> m_flat_model;
@@ -213,6 +213,12 @@ FlatContract::FlatContract(
             {
                 m_vars.push_back(v);
                 extractor.record(v);
+
+                auto const* TYPENAME = v->typeName();
+                if (auto array = dynamic_cast<ArrayTypeName const*>(TYPENAME))
+                {
+                    m_arrays.push_back(array);
+                }
             }
             else if (v->visibility() == Declaration::Visibility::Private ||
                      v->visibility() == Declaration::Visibility::Default)
@@ -320,6 +326,11 @@ vector<Mapping const*> const& FlatContract::mappings() const
     return m_mappings;
 }
 
+vector<ArrayTypeName const*> const& FlatContract::arrays() const
+{
+    return m_arrays;
+}
+
 vector<EnumDefinition const*> const& FlatContract::enums() const
 {
     return m_enums;
@@ -143,6 +143,9 @@ public:
     // Returns the mappings defiend (directly) by this contract.
     std::vector<Mapping const*> const& mappings() const;
 
+    // Returns the fixed-length arrays defined (directly) by this contract.
+    std::vector<ArrayTypeName const*> const& arrays() const;
+
     // Returns the enums used by this contract.
     std::vector<EnumDefinition const*> const& enums() const;
 
@@ -162,6 +165,7 @@ private:
     InheritanceTree m_tree;
 
     std::vector<Mapping const*> m_mappings;
+    std::vector<ArrayTypeName const*> m_arrays;
 
     std::vector<EnumDefinition const*> m_enums;
 };
@@ -32,6 +32,288 @@ vector<FunctionDefinition const*> Library::functions() const
 
 // -------------------------------------------------------------------------- //
 
+SafeMathMatcher::SafeMathMatcher(FunctionDefinition const& _func)
+    : M_FUNC(_func)
+{
+    static map<string, Token> const OPS({
+        {"add", Token::Add},
+        {"sub", Token::Sub},
+        {"mul", Token::Mul},
+        {"div", Token::Div},
+        {"mod", Token::Mod}
+    });
+
+    // Checks the signature of the method.
+    auto const OP = OPS.find(_func.name());
+    if (OP == OPS.end()) return;
+    if (!_func.isImplemented()) return;
+    if (_func.stateMutability() != StateMutability::Pure) return;
+
+    auto const& PARAMS = _func.parameters();
+    auto const& RVS = _func.returnParameters();
+    if (PARAMS.size() != 2 && PARAMS.size() != 3) return;
+    if (RVS.size() != 1) return;
+
+    auto const* TYPE = RVS[0]->annotation().type;
+    auto const* INT_TYPE = dynamic_cast<IntegerType const*>(TYPE);
+    if (!INT_TYPE || INT_TYPE->isSigned()) return;
+    if (*PARAMS[0]->annotation().type != *TYPE) return;
+    if (*PARAMS[1]->annotation().type != *TYPE) return;
+    if (PARAMS.size() == 3)
+    {
+        auto msg = dynamic_cast<ArrayType const*>(PARAMS[2]->annotation().type);
+        if (!msg || !msg->isString()) return;
+    }
+
+    // Checks the body of the method.
+    m_token = OP->second;
+    auto const& STMTS = _func.body().statements();
+    if (match_forward(STMTS) || match_body(STMTS))
+    {
+        m_op = OP->first;
+    }
+}
+
+string const& SafeMathMatcher::op() const
+{
+    return m_op;
+}
+
+bool SafeMathMatcher::match_forward(
+    vector<ASTPointer<Statement>> const& _stmts
+) const
+{
+    if (_stmts.size() != 1) return false;
+
+    auto const* RETURN = dynamic_cast<Return const*>(_stmts[0].get());
+    if (!RETURN || !RETURN->expression()) return false;
+
+    auto const* CALL = dynamic_cast<FunctionCall const*>(RETURN->expression());
+    if (!CALL || !CALL->names().empty()) return false;
+    if (CALL->annotation().kind != FunctionCallKind::FunctionCall) return false;
+
+    auto const* ID = dynamic_cast<Identifier const*>(&CALL->expression());
+    if (!ID) return false;
+
+    auto const* CALLEE = dynamic_cast<FunctionDefinition const*>(
+        ID->annotation().referencedDeclaration
+    );
+    if (!CALLEE || CALLEE == &M_FUNC) return false;
+    if (CALLEE->scope() != M_FUNC.scope()) return false;
+
+    auto const& ARGS = CALL->arguments();
+    if (ARGS.size() != 2 && ARGS.size() != 3) return false;
+    if (!is_param(*ARGS[0], 0) || !is_param(*ARGS[1], 1)) return false;
+    if (ARGS.size() == 3 && !is_message(*ARGS[2])) return false;
+
+    return (SafeMathMatcher(*CALLEE).op() == M_FUNC.name());
+}
+
+bool SafeMathMatcher::match_body(vector<ASTPointer<Statement>> const& _stmts)
+{
+    // Multiplication first handles zero, so that its check cannot divide by it.
+    size_t i = 0;
+    if (m_token == Token::Mul)
+    {
+        if (_stmts.empty() || !match_zero_guard(*_stmts[0])) return false;
+        ++i;
+    }
+
+    // Addition and multiplication are checked by their result.
+    bool const CHECK_AFTER = (m_token == Token::Add || m_token == Token::Mul);
+
+    auto const COUNT = _stmts.size() - i;
+    if (CHECK_AFTER)
+    {
+        if (COUNT != 3) return false;
+        return match_result(*_stmts[i])
+            && match_check(*_stmts[i + 1])
+            && match_return(*_stmts[i + 2]);
+    }
+    else if (COUNT == 2)
+    {
+        return match_check(*_stmts[i]) && match_return(*_stmts[i + 1]);
+    }
+    else if (COUNT == 3)
+    {
+        return match_check(*_stmts[i])
+            && match_result(*_stmts[i + 1])
+            && match_return(*_stmts[i + 2]);
+    }
+    return false;
+}
+
+bool SafeMathMatcher::match_zero_guard(Statement const& _stmt) const
+{
+    auto const* IF = dynamic_cast<IfStatement const*>(&_stmt);
+    if (!IF || IF->falseStatement()) return false;
+
+    auto const* COND = as_binop(IF->condition(), Token::Equal);
+    if (!COND) return false;
+    if (!is_param(COND->leftExpression(), 0)) return false;
+    if (!is_zero(COND->rightExpression())) return false;
+
+    auto const* BODY = &IF->trueStatement();
+    if (auto const* BLOCK = dynamic_cast<Block const*>(BODY))
+    {
+        if (BLOCK->statements().size() != 1) return false;
+        BODY = BLOCK->statements()[0].get();
+    }
+
+    auto const* RETURN = dynamic_cast<Return const*>(BODY);
+    return (RETURN && RETURN->expression() && is_zero(*RETURN->expression()));
+}
+
+bool SafeMathMatcher::match_result(Statement const& _stmt)
+{
+    using DeclStmt = VariableDeclarationStatement;
+    auto const* DECL = dynamic_cast<DeclStmt const*>(&_stmt);
+    if (!DECL || DECL->declarations().size() != 1) return false;
+
+    auto const& VAR = DECL->declarations()[0];
+    if (!VAR || !DECL->initialValue() || !is_op(*DECL->initialValue()))
+    {
+        return false;
+    }
+
+    auto const* TYPE = M_FUNC.returnParameters()[0]->annotation().type;
+    if (*VAR->annotation().type != *TYPE) return false;
+
+    m_result = VAR.get();
+    return true;
+}
+
+bool SafeMathMatcher::match_check(Statement const& _stmt) const
+{
+    auto const* STMT = dynamic_cast<ExpressionStatement const*>(&_stmt);
+    if (!STMT) return false;
+
+    auto const* CALL = dynamic_cast<FunctionCall const*>(&STMT->expression());
+    if (!CALL || !CALL->names().empty()) return false;
+
+    auto const* TYPE = dynamic_cast<FunctionType const*>(
+        CALL->expression().annotation().type
+    );
+    if (!TYPE || TYPE->kind() != FunctionType::Kind::Require) return false;
+
+    auto const& ARGS = CALL->arguments();
+    if (ARGS.size() != 1 && ARGS.size() != 2) return false;
+    if (ARGS.size() == 2 && !is_message(*ARGS[1])) return false;
+    return is_check(*ARGS[0]);
+}
+
+bool SafeMathMatcher::match_return(Statement const& _stmt) const
+{
+    auto const* RETURN = dynamic_cast<Return const*>(&_stmt);
+    if (!RETURN || !RETURN->expression()) return false;
+
+    auto const& EXPR = *RETURN->expression();
+    return (m_result ? is_result(EXPR) : is_op(EXPR));
+}
+
+bool SafeMathMatcher::is_check(Expression const& _expr) const
+{
+    switch (m_token)
+    {
+    case Token::Add:
+        // c >= a
+        if (auto const* CHECK = as_binop(_expr, Token::GreaterThanOrEqual))
+        {
+            return is_result(CHECK->leftExpression())
+                && is_param(CHECK->rightExpression(), 0);
+        }
+        return false;
+    case Token::Sub:
+        // b <= a
+        if (auto const* CHECK = as_binop(_expr, Token::LessThanOrEqual))
+        {
+            return is_param(CHECK->leftExpression(), 1)
+                && is_param(CHECK->rightExpression(), 0);
+        }
+        return false;
+    case Token::Mul:
+        // c / a == b
+        if (auto const* CHECK = as_binop(_expr, Token::Equal))
+        {
+            auto const* QUOT = as_binop(CHECK->leftExpression(), Token::Div);
+            return QUOT
+                && is_result(QUOT->leftExpression())
+                && is_param(QUOT->rightExpression(), 0)
+                && is_param(CHECK->rightExpression(), 1);
+        }
+        return false;
+    case Token::Div:
+    case Token::Mod:
+        // b > 0 or b != 0
+        {
+            auto const* CHECK = as_binop(_expr, Token::GreaterThan);
+            if (!CHECK) CHECK = as_binop(_expr, Token::NotEqual);
+            return CHECK
+                && is_param(CHECK->leftExpression(), 1)
+                && is_zero(CHECK->rightExpression());
+        }
+    default:
+        return false;
+    }
+}
+
+bool SafeMathMatcher::is_op(Expression const& _expr) const
+{
+    auto const* OP = as_binop(_expr, m_token);
+    return OP
+        && is_param(OP->leftExpression(), 0)
+        && is_param(OP->rightExpression(), 1);
+}
+
+bool SafeMathMatcher::is_param(Expression const& _expr, size_t _i) const
+{
+    if (auto id = dynamic_cast<Identifier const*>(&_expr))
+    {
+        auto const* DECL = id->annotation().referencedDeclaration;
+        return (DECL == M_FUNC.parameters()[_i].get());
+    }
+    return false;
+}
+
+bool SafeMathMatcher::is_result(Expression const& _expr) const
+{
+    if (!m_result) return false;
+    if (auto id = dynamic_cast<Identifier const*>(&_expr))
+    {
+        return (id->annotation().referencedDeclaration == m_result);
+    }
+    return false;
+}
+
+bool SafeMathMatcher::is_message(Expression const& _expr) const
+{
+    if (auto lit = dynamic_cast<Literal const*>(&_expr))
+    {
+        return (lit->token() == Token::StringLiteral);
+    }
+    return (M_FUNC.parameters().size() == 3 && is_param(_expr, 2));
+}
+
+bool SafeMathMatcher::is_zero(Expression const& _expr)
+{
+    if (auto lit = dynamic_cast<Literal const*>(&_expr))
+    {
+        return (lit->token() == Token::Number && lit->value() == "0");
+    }
+    return false;
+}
+
+BinaryOperation const* SafeMathMatcher::as_binop(
+    Expression const& _expr, Token _op
+)
+{
+    auto const* OP = dynamic_cast<BinaryOperation const*>(&_expr);
+    if (OP && OP->getOperator() == _op) return OP;
+    return nullptr;
+}
+
+// -------------------------------------------------------------------------- //
+
 LibrarySummary::LibrarySummary(
     CallGraph const& _calls, shared_ptr<StructureStore> _store
 ) {
@@ -60,6 +342,12 @@ LibrarySummary::LibrarySummary(
         if (contract->isLibrary())
         {
             libraries[contract].push_back(func);
+
+            SafeMathMatcher matcher(*func);
+            if (!matcher.op().empty())
+            {
+                m_checked_ops[func] = matcher.op();
+            }
         }
     }
 
@@ -77,6 +365,13 @@ vector<shared_ptr<Library const>> LibrarySummary::view() const
     return m_libraries;
 }
 
+string LibrarySummary::checked_op(FunctionDefinition const& _func) const
+{
+    auto const RES = m_checked_ops.find(&_func);
+    if (RES == m_checked_ops.end()) return "";
+    return RES->second;
+}
+
 // -------------------------------------------------------------------------- //
 
 }
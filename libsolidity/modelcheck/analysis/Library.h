@@ -6,9 +6,12 @@
 
 #pragma once
 
+#include <libsolidity/ast/AST.h>
 #include <libsolidity/modelcheck/analysis/Structure.h>
 
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace dev
@@ -43,6 +46,79 @@ private:
     std::vector<FunctionDefinition const*> m_functions;
 };
 
+/**
+ * Determines if a library method has the shape of an OpenZeppelin SafeMath
+ * operation. Such a method is pure, and maps two unsigned integers of one type
+ * (and possibly an error message) to a third. Its body must be one of:
+ * 1. A call to another such method, which forwards both arguments.
+ * 2. A require of the canonical check for the operation, and a return of the
+ *    operation applied to both arguments, either directly or through a local.
+ * The canonical checks are `c >= a` for add, `b <= a` for sub, `c / a == b` for
+ * mul (after returning zero if `a == 0`), and `b > 0` or `b != 0` for div and
+ * mod. The check of add and mul follows the operation, whereas the check of
+ * sub, div and mod precedes it.
+ */
+class SafeMathMatcher
+{
+public:
+    // Matches _func against the SafeMath operations.
+    SafeMathMatcher(FunctionDefinition const& _func);
+
+    // Returns the name of the matched operation (add, sub, mul, div or mod). If
+    // the method does not match, then the empty string is returned.
+    std::string const& op() const;
+
+private:
+    FunctionDefinition const& M_FUNC;
+
+    std::string m_op;
+    Token m_token = Token::Illegal;
+
+    // The local which holds the result of the operation, if any.
+    VariableDeclaration const* m_result = nullptr;
+
+    // Returns true if _stmts forwards the arguments to an overload of this
+    // method, as in `return op(a, b, "msg");`.
+    bool match_forward(std::vector<ASTPointer<Statement>> const& _stmts) const;
+
+    // Returns true if _stmts computes, checks, and returns the operation.
+    bool match_body(std::vector<ASTPointer<Statement>> const& _stmts);
+
+    // Returns true if _stmt is `if (a == 0) return 0;`, with or without braces.
+    bool match_zero_guard(Statement const& _stmt) const;
+
+    // Returns true if _stmt is `uint c = a op b;`. The local is recorded.
+    bool match_result(Statement const& _stmt);
+
+    // Returns true if _stmt is `require(<check>)` or `require(<check>, msg)`.
+    bool match_check(Statement const& _stmt) const;
+
+    // Returns true if _stmt returns the operation, or the local holding it.
+    bool match_return(Statement const& _stmt) const;
+
+    // Returns true if _expr is the canonical check for the operation.
+    bool is_check(Expression const& _expr) const;
+
+    // Returns true if _expr is `a op b`.
+    bool is_op(Expression const& _expr) const;
+
+    // Returns true if _expr references the _i-th parameter of the method.
+    bool is_param(Expression const& _expr, size_t _i) const;
+
+    // Returns true if _expr references the local holding the result.
+    bool is_result(Expression const& _expr) const;
+
+    // Returns true if _expr is an error message: either a literal, or the
+    // message parameter.
+    bool is_message(Expression const& _expr) const;
+
+    // Returns true if _expr is the literal zero.
+    static bool is_zero(Expression const& _expr);
+
+    // Returns _expr as a binary operation, if it applies operator _op.
+    static BinaryOperation const* as_binop(Expression const& _expr, Token _op);
+};
+
 /**
  * Summarizes all libraries used within a call graph.
  */
@@ -57,8 +133,14 @@ public:
     // Gives view of all accessible libraries.
     std::vector<std::shared_ptr<Library const>> view() const;
 
+    // If _func is a SafeMath operation, then the name of the operation is
+    // returned. Otherwise, the empty string is returned.
+    std::string checked_op(FunctionDefinition const& _func) const;
+
 private:
     std::vector<std::shared_ptr<Library const>> m_libraries;
+
+    std::map<FunctionDefinition const*, std::string> m_checked_ops;
 };
 
 // -------------------------------------------------------------------------- //
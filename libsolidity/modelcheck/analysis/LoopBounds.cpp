@@ -0,0 +1,415 @@
+#include <libsolidity/modelcheck/analysis/LoopBounds.h>
+
+#include <libsolidity/modelcheck/utils/AST.h>
+#include <libsolidity/modelcheck/utils/General.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+// Bounds of at least this size are discarded.
+bigint const MAX_ITERATIONS = bigint(1) << 32;
+
+// Returns true if _expr is an integer constant, and then sets _val to its
+// value.
+bool as_constant(Expression const& _expr, bigint & _val)
+{
+    auto const& EXPR = ExpressionCleaner(_expr).clean();
+    auto const* TYPE = EXPR.annotation().type;
+    if (auto rat = dynamic_cast<RationalNumberType const*>(TYPE))
+    {
+        if (rat->isFractional() || !rat->integerType()) return false;
+        auto const LIT = rat->literalValue(nullptr);
+        _val = rat->isNegative() ? bigint(u2s(LIT)) : bigint(LIT);
+        return true;
+    }
+    else if (auto id = dynamic_cast<Identifier const*>(&EXPR))
+    {
+        auto const* DECL = dynamic_cast<VariableDeclaration const*>(
+            id->annotation().referencedDeclaration
+        );
+        if (DECL && DECL->isConstant() && DECL->value())
+        {
+            return as_constant(*DECL->value(), _val);
+        }
+    }
+    else if (auto mem = dynamic_cast<MemberAccess const*>(&EXPR))
+    {
+        auto const* ARR = dynamic_cast<ArrayType const*>(
+            mem->expression().annotation().type
+        );
+        if (ARR && !ARR->isDynamicallySized() && mem->memberName() == "length")
+        {
+            _val = bigint(ARR->length());
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the local integer variable named by _expr, or nullptr.
+VariableDeclaration const* as_counter(Expression const& _expr)
+{
+    auto const& EXPR = ExpressionCleaner(_expr).clean();
+    auto const* ID = dynamic_cast<Identifier const*>(&EXPR);
+    if (!ID) return nullptr;
+
+    auto const* DECL = dynamic_cast<VariableDeclaration const*>(
+        ID->annotation().referencedDeclaration
+    );
+    if (!DECL || !DECL->isLocalVariable()) return nullptr;
+    if (!dynamic_cast<IntegerType const*>(DECL->annotation().type))
+    {
+        return nullptr;
+    }
+    return DECL;
+}
+
+// If _stmt sets a local integer variable to a constant, then the variable is
+// returned, and _start is set to the constant.
+VariableDeclaration const* as_init(Statement const& _stmt, bigint & _start)
+{
+    if (auto decl = dynamic_cast<VariableDeclarationStatement const*>(&_stmt))
+    {
+        if (decl->declarations().size() != 1) return nullptr;
+        auto const* VAR = decl->declarations()[0].get();
+        auto const* INIT = decl->initialValue();
+        if (!VAR || !INIT || !as_constant(*INIT, _start)) return nullptr;
+        if (!dynamic_cast<IntegerType const*>(VAR->annotation().type))
+        {
+            return nullptr;
+        }
+        return VAR;
+    }
+    else if (auto expr_stmt = dynamic_cast<ExpressionStatement const*>(&_stmt))
+    {
+        auto const& EXPR = ExpressionCleaner(expr_stmt->expression()).clean();
+        auto const* ASSIGN = dynamic_cast<Assignment const*>(&EXPR);
+        if (!ASSIGN || ASSIGN->assignmentOperator() != Token::Assign)
+        {
+            return nullptr;
+        }
+        if (!as_constant(ASSIGN->rightHandSide(), _start)) return nullptr;
+        return as_counter(ASSIGN->leftHandSide());
+    }
+    return nullptr;
+}
+
+// If _expr compares _counter to a constant, then true is returned. The
+// comparison is normalized to `_counter _op _limit`.
+bool as_cond(
+    Expression const& _expr,
+    VariableDeclaration const& _counter,
+    Token & _op,
+    bigint & _limit
+)
+{
+    auto const& EXPR = ExpressionCleaner(_expr).clean();
+    auto const* BINOP = dynamic_cast<BinaryOperation const*>(&EXPR);
+    if (!BINOP) return false;
+
+    auto const& LHS = BINOP->leftExpression();
+    auto const& RHS = BINOP->rightExpression();
+    _op = BINOP->getOperator();
+    if (as_counter(LHS) == &_counter && as_constant(RHS, _limit))
+    {
+        return (_op == Token::LessThan
+             || _op == Token::LessThanOrEqual
+             || _op == Token::NotEqual);
+    }
+    else if (as_counter(RHS) == &_counter && as_constant(LHS, _limit))
+    {
+        if (_op == Token::GreaterThan) _op = Token::LessThan;
+        else if (_op == Token::GreaterThanOrEqual) _op = Token::LessThanOrEqual;
+        return (_op == Token::LessThan
+             || _op == Token::LessThanOrEqual
+             || _op == Token::NotEqual);
+    }
+    return false;
+}
+
+// If _stmt increments _counter by a positive constant, then true is returned,
+// and _step is set to the constant.
+bool as_step(
+    Statement const& _stmt, VariableDeclaration const& _counter, bigint & _step
+)
+{
+    auto const* EXPR_STMT = dynamic_cast<ExpressionStatement const*>(&_stmt);
+    if (!EXPR_STMT) return false;
+
+    auto const& EXPR = ExpressionCleaner(EXPR_STMT->expression()).clean();
+    if (auto op = dynamic_cast<UnaryOperation const*>(&EXPR))
+    {
+        _step = 1;
+        if (op->getOperator() != Token::Inc) return false;
+        return (as_counter(op->subExpression()) == &_counter);
+    }
+    else if (auto assign = dynamic_cast<Assignment const*>(&EXPR))
+    {
+        if (assign->assignmentOperator() != Token::AssignAdd) return false;
+        if (as_counter(assign->leftHandSide()) != &_counter) return false;
+        return (as_constant(assign->rightHandSide(), _step) && _step > 0);
+    }
+    return false;
+}
+
+// Determines if a statement may write to a counter, or may end an iteration of
+// the enclosing loop early.
+class LoopBodySniffer : public ASTConstVisitor
+{
+public:
+    LoopBodySniffer(Statement const& _stmt, VariableDeclaration const& _counter)
+    : M_COUNTER(_counter)
+    {
+        _stmt.accept(*this);
+    }
+
+    bool writes() const { return m_writes; }
+    bool exits() const { return m_exits; }
+    bool continues() const { return m_continues; }
+
+protected:
+    bool visit(Assignment const& _node) override
+    {
+        {
+            ScopedSwap<bool> swap(m_lval, true);
+            _node.leftHandSide().accept(*this);
+        }
+        _node.rightHandSide().accept(*this);
+        return false;
+    }
+
+    bool visit(UnaryOperation const& _node) override
+    {
+        auto const OP = _node.getOperator();
+        bool const WRITES = (OP == Token::Inc || OP == Token::Dec
+                          || OP == Token::Delete);
+        ScopedSwap<bool> swap(m_lval, m_lval || WRITES);
+        _node.subExpression().accept(*this);
+        return false;
+    }
+
+    bool visit(IndexAccess const& _node) override
+    {
+        _node.baseExpression().accept(*this);
+        if (_node.indexExpression())
+        {
+            ScopedSwap<bool> swap(m_lval, false);
+            _node.indexExpression()->accept(*this);
+        }
+        return false;
+    }
+
+    bool visit(FunctionCall const& _node) override
+    {
+        ScopedSwap<bool> swap(m_lval, false);
+        _node.expression().accept(*this);
+        for (auto const& arg : _node.arguments())
+        {
+            arg->accept(*this);
+        }
+        return false;
+    }
+
+    bool visit(Identifier const& _node) override
+    {
+        if (m_lval && _node.annotation().referencedDeclaration == &M_COUNTER)
+        {
+            m_writes = true;
+        }
+        return false;
+    }
+
+    bool visit(WhileStatement const&) override
+    {
+        ++m_depth;
+        return true;
+    }
+
+    bool visit(ForStatement const&) override
+    {
+        ++m_depth;
+        return true;
+    }
+
+    void endVisit(WhileStatement const&) override { --m_depth; }
+    void endVisit(ForStatement const&) override { --m_depth; }
+
+    void endVisit(Break const&) override { if (m_depth == 0) m_exits = true; }
+    void endVisit(Return const&) override { m_exits = true; }
+
+    void endVisit(Continue const&) override
+    {
+        if (m_depth == 0) m_continues = true;
+    }
+
+private:
+    VariableDeclaration const& M_COUNTER;
+
+    size_t m_depth = 0;
+    bool m_lval = false;
+
+    bool m_writes = false;
+    bool m_exits = false;
+    bool m_continues = false;
+};
+
+// Computes the iterations of `for (i = _start; i _op _limit; i += _step)`. If
+// the counter may overflow, then false is returned.
+bool count_iterations(
+    bigint const& _start,
+    Token _op,
+    bigint const& _limit,
+    bigint const& _step,
+    IntegerType const& _type,
+    bigint & _iterations
+)
+{
+    if (_op == Token::NotEqual)
+    {
+        if (_limit < _start || (_limit - _start) % _step != 0) return false;
+        _iterations = (_limit - _start) / _step;
+    }
+    else
+    {
+        // The last value of the counter, for which the body may run.
+        bigint const LAST = (_op == Token::LessThan) ? _limit - 1 : _limit;
+        _iterations = 0;
+        if (LAST >= _start) _iterations = (LAST - _start) / _step + 1;
+    }
+
+    if (_iterations >= MAX_ITERATIONS) return false;
+    return (_start + _iterations * _step <= _type.maxValue());
+}
+}
+
+// -------------------------------------------------------------------------- //
+
+LoopBounds::LoopBounds(Block const& _body)
+{
+    _body.accept(*this);
+}
+
+bool LoopBounds::find(BreakableStatement const& _loop, Bound & _bound) const
+{
+    auto const RES = m_bounds.find(&_loop);
+    if (RES == m_bounds.end()) return false;
+    _bound = RES->second;
+    return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool LoopBounds::visit(Block const& _node)
+{
+    ScopedSwap<Statement const*> prev_swap(m_prev, nullptr);
+    ScopedSwap<Statement const*> curr_swap(m_curr, nullptr);
+    for (auto const& stmt : _node.statements())
+    {
+        m_curr = stmt.get();
+        stmt->accept(*this);
+        m_prev = stmt.get();
+    }
+    return false;
+}
+
+bool LoopBounds::visit(ForStatement const& _node)
+{
+    auto const* INIT = _node.initializationExpression();
+    auto const* COND = _node.condition();
+    auto const* STEP = _node.loopExpression();
+    if (COND && STEP)
+    {
+        record(_node, INIT, *COND, *STEP, {&_node.body()}, false);
+    }
+
+    _node.body().accept(*this);
+    return false;
+}
+
+bool LoopBounds::visit(WhileStatement const& _node)
+{
+    // The step is the last statement of the body, and the initialization must
+    // be the statement directly before the loop.
+    if (!_node.isDoWhile())
+    {
+        Statement const* step = &_node.body();
+        vector<Statement const*> body;
+        if (auto block = dynamic_cast<Block const*>(step))
+        {
+            auto const& STMTS = block->statements();
+            step = STMTS.empty() ? nullptr : STMTS.back().get();
+            for (size_t i = 0; i + 1 < STMTS.size(); ++i)
+            {
+                body.push_back(STMTS[i].get());
+            }
+        }
+
+        auto const* INIT = (m_curr == &_node) ? m_prev : nullptr;
+        if (step)
+        {
+            record(_node, INIT, _node.condition(), *step, body, true);
+        }
+    }
+
+    _node.body().accept(*this);
+    return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+void LoopBounds::record(
+    BreakableStatement const& _loop,
+    Statement const* _init,
+    Expression const& _cond,
+    Statement const& _step,
+    vector<Statement const*> const& _body,
+    bool _skips
+)
+{
+    if (!_init) return;
+
+    bigint start;
+    auto const* COUNTER = as_init(*_init, start);
+    if (!COUNTER) return;
+
+    Token op;
+    bigint limit;
+    if (!as_cond(_cond, *COUNTER, op, limit)) return;
+
+    bigint step;
+    if (!as_step(_step, *COUNTER, step)) return;
+
+    // The counter must only be written by its step.
+    bool exact = true;
+    for (auto const* stmt : _body)
+    {
+        LoopBodySniffer sniffer(*stmt, *COUNTER);
+        if (sniffer.writes()) return;
+        if (sniffer.continues() && _skips) return;
+        if (sniffer.exits() || sniffer.continues()) exact = false;
+    }
+
+    auto const& TYPE = dynamic_cast<IntegerType const&>(
+        *COUNTER->annotation().type
+    );
+    bigint iterations;
+    if (!count_iterations(start, op, limit, step, TYPE, iterations)) return;
+
+    m_bounds[&_loop] = Bound{static_cast<size_t>(iterations), exact};
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
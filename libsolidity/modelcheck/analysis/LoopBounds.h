@@ -0,0 +1,87 @@
+/**
+ * Infers iteration bounds for the loops of a function body. The c-model does
+ * not otherwise bound its loops, so a bounded model checker must unroll each
+ * loop to a single global bound. If the iteration count of a loop is known, the
+ * model may instead carry this bound, or unroll the loop itself.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <map>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Finds the loops of a block which are controlled by an integer counter. Such a
+ * loop has the form `for (i = c1; i op c2; i += k) body`, or has the form
+ * `i = c1; while (i op c2) { body; i += k; }`, where op is one of <, <=, or !=,
+ * c1 and c2 are constants, k is a positive constant, and i is a local variable
+ * not written by body. The step `i += k` may also be written `i++` or `++i`.
+ *
+ * If the loop has no break, continue or return statements, then its bound is
+ * exact, as the loop runs to completion unless the transaction reverts. Else,
+ * the bound is an upper bound.
+ */
+class LoopBounds : public ASTConstVisitor
+{
+public:
+    // The bound of a single loop.
+    struct Bound
+    {
+        // The maximum number of iterations of the loop.
+        size_t iterations;
+        // If true, the body always runs to completion, exactly iterations
+        // times, unless the transaction reverts.
+        bool exact;
+    };
+
+    // Infers the bounds of all loops within _body.
+    explicit LoopBounds(Block const& _body);
+
+    // If a bound is known for _loop, then it is written to _bound and true is
+    // returned.
+    bool find(BreakableStatement const& _loop, Bound & _bound) const;
+
+protected:
+    bool visit(Block const& _node) override;
+    bool visit(ForStatement const& _node) override;
+    bool visit(WhileStatement const& _node) override;
+
+private:
+    // The current statement of the innermost block, and the statement before.
+    Statement const* m_curr = nullptr;
+    Statement const* m_prev = nullptr;
+
+    std::map<BreakableStatement const*, Bound> m_bounds;
+
+    // Records a bound for _loop, if its counter is initialized by _init, is
+    // compared by _cond, and is stepped by _step. The remaining statements of
+    // the loop are given by _body. If _skips is set, then a continue statement
+    // would skip _step, and the loop is then unbounded.
+    void record(
+        BreakableStatement const& _loop,
+        Statement const* _init,
+        Expression const& _cond,
+        Statement const& _step,
+        std::vector<Statement const*> const& _body,
+        bool _skips
+    );
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
@@ -0,0 +1,430 @@
+#include <libsolidity/modelcheck/analysis/MapAccessCache.h>
+
+#include <libsolidity/modelcheck/analysis/FunctionCall.h>
+#include <libsolidity/modelcheck/analysis/Mapping.h>
+#include <libsolidity/modelcheck/utils/AST.h>
+#include <libsolidity/modelcheck/utils/General.h>
+#include <libsolidity/modelcheck/utils/Types.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+// Determines if an expression has side-effects, other than a failed require or
+// assert. Conversions are assumed to be free of side-effects.
+class SideEffectSniffer : public ASTConstVisitor
+{
+public:
+    explicit SideEffectSniffer(Expression const& _expr) { _expr.accept(*this); }
+
+    bool found() const { return m_found; }
+
+protected:
+    bool visit(Assignment const&) override
+    {
+        m_found = true;
+        return false;
+    }
+
+    bool visit(UnaryOperation const& _node) override
+    {
+        auto const OP = _node.getOperator();
+        if (OP == Token::Inc || OP == Token::Dec || OP == Token::Delete)
+        {
+            m_found = true;
+        }
+        return !m_found;
+    }
+
+    bool visit(FunctionCall const& _node) override
+    {
+        auto const KIND = _node.annotation().kind;
+        if (KIND == FunctionCallKind::TypeConversion) return true;
+        if (KIND == FunctionCallKind::FunctionCall)
+        {
+            auto const GROUP = FunctionCallAnalyzer(_node).classify();
+            if (GROUP == FunctionCallAnalyzer::CallGroup::Assert) return true;
+            if (GROUP == FunctionCallAnalyzer::CallGroup::Require) return true;
+        }
+        m_found = true;
+        return false;
+    }
+
+private:
+    bool m_found = false;
+};
+
+bool has_side_effect(Expression const& _expr)
+{
+    return SideEffectSniffer(_expr).found();
+}
+
+using DeclStmt = VariableDeclarationStatement;
+
+bool is_map_access(IndexAccess const& _node)
+{
+    auto const& BASE_TYPE = *_node.baseExpression().annotation().type;
+    return (BASE_TYPE.category() == Type::Category::Mapping);
+}
+}
+
+// -------------------------------------------------------------------------- //
+
+vector<MapAccessCache::Slot> const MapAccessCache::EMPTY;
+
+MapAccessCache::MapAccessCache(Block const& _body)
+{
+    _body.accept(*this);
+}
+
+string MapAccessCache::name(size_t _id)
+{
+    return "mapvar_" + to_string(_id);
+}
+
+vector<MapAccessCache::Slot> const& MapAccessCache::opens(
+    Statement const& _stmt
+) const
+{
+    auto const RES = m_opens.find(&_stmt);
+    return (RES == m_opens.end()) ? EMPTY : RES->second;
+}
+
+bool MapAccessCache::reads_slot(IndexAccess const& _node, size_t & _id) const
+{
+    auto const RES = m_reads.find(&_node);
+    if (RES == m_reads.end()) return false;
+    _id = RES->second;
+    return true;
+}
+
+bool MapAccessCache::writes_slot(IndexAccess const& _node, size_t & _id) const
+{
+    auto const RES = m_writes.find(&_node);
+    if (RES == m_writes.end()) return false;
+    _id = RES->second;
+    return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool MapAccessCache::visit(Block const& _node)
+{
+    auto const ALL = [](Entry const&) { return true; };
+    for (auto const& stmt : _node.statements())
+    {
+        if (is_straight_line(*stmt))
+        {
+            analyze(*stmt);
+        }
+        else
+        {
+            drop_if(ALL);
+            stmt->accept(*this);
+        }
+    }
+    drop_if(ALL);
+    return false;
+}
+
+bool MapAccessCache::visit(IndexAccess const& _node)
+{
+    if (!m_stmt || m_conditional || !is_map_access(_node)) return true;
+
+    // Only complete accesses are recorded, but the keys may also read maps.
+    FlatIndex idx(_node);
+    for (auto const* key : idx.indices())
+    {
+        key->accept(*this);
+    }
+
+    Entry entry;
+    if (resolve_entry(_node, entry))
+    {
+        find_live(entry).push_back(Access{&_node, false, m_stmt});
+    }
+    return false;
+}
+
+bool MapAccessCache::visit(Conditional const& _node)
+{
+    _node.condition().accept(*this);
+
+    ScopedSwap<bool> swap(m_conditional, true);
+    _node.trueExpression().accept(*this);
+    _node.falseExpression().accept(*this);
+    return false;
+}
+
+bool MapAccessCache::visit(BinaryOperation const& _node)
+{
+    auto const OP = _node.getOperator();
+    if (OP != Token::And && OP != Token::Or) return true;
+
+    _node.leftExpression().accept(*this);
+
+    ScopedSwap<bool> swap(m_conditional, true);
+    _node.rightExpression().accept(*this);
+    return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool MapAccessCache::is_straight_line(Statement const& _stmt)
+{
+    if (auto expr_stmt = dynamic_cast<ExpressionStatement const*>(&_stmt))
+    {
+        auto const& EXPR = ExpressionCleaner(expr_stmt->expression()).clean();
+        if (auto assign = dynamic_cast<Assignment const*>(&EXPR))
+        {
+            auto const& LHS = ExpressionCleaner(assign->leftHandSide()).clean();
+            if (dynamic_cast<TupleExpression const*>(&LHS)) return false;
+            if (has_side_effect(LHS)) return false;
+            return !has_side_effect(assign->rightHandSide());
+        }
+        else if (auto op = dynamic_cast<UnaryOperation const*>(&EXPR))
+        {
+            auto const OP = op->getOperator();
+            if (OP == Token::Inc || OP == Token::Dec)
+            {
+                auto const& SUB = ExpressionCleaner(op->subExpression());
+                return (dynamic_cast<Identifier const*>(&SUB.clean()));
+            }
+        }
+        return !has_side_effect(EXPR);
+    }
+    else if (auto decl = dynamic_cast<DeclStmt const*>(&_stmt))
+    {
+        if (decl->declarations().size() != 1) return false;
+        if (!decl->declarations()[0]) return false;
+        auto const* INIT = decl->initialValue();
+        return (!INIT || !has_side_effect(*INIT));
+    }
+    else if (auto ret = dynamic_cast<Return const*>(&_stmt))
+    {
+        return (!ret->expression() || !has_side_effect(*ret->expression()));
+    }
+    return false;
+}
+
+bool MapAccessCache::resolve_entry(IndexAccess const& _node, Entry & _entry)
+{
+    // The entry must be complete, and of a type that may be cached.
+    if (!is_map_access(_node)) return false;
+    auto const& TYPE = *_node.annotation().type;
+    if (TYPE.category() == Type::Category::Mapping) return false;
+    if (!is_wrapped_type(TYPE)) return false;
+
+    // The map must be a state variable, or else it may have an alias.
+    FlatIndex idx(_node);
+    auto const& BASE = ExpressionCleaner(idx.base()).clean();
+    auto const* BASE_ID = dynamic_cast<Identifier const*>(&BASE);
+    if (!BASE_ID || !idx.decl().isStateVariable()) return false;
+
+    _entry.first = &idx.decl();
+    _entry.second.clear();
+    for (auto const* key : idx.indices())
+    {
+        auto const& KEY = ExpressionCleaner(*key).clean();
+        if (auto id = dynamic_cast<Identifier const*>(&KEY))
+        {
+            auto const* DECL = id->annotation().referencedDeclaration;
+            if (!dynamic_cast<VariableDeclaration const*>(DECL)) return false;
+            _entry.second.emplace_back(DECL, "");
+        }
+        else if (auto lit = dynamic_cast<Literal const*>(&KEY))
+        {
+            auto const NONE = Literal::SubDenomination::None;
+            if (lit->subDenomination() != NONE) return false;
+            _entry.second.emplace_back(nullptr, "literal " + lit->value());
+        }
+        else if (auto mem = dynamic_cast<MemberAccess const*>(&KEY))
+        {
+            auto const& MSG = mem->expression();
+            auto const* MSG_ID = dynamic_cast<Identifier const*>(&MSG);
+            if (!MSG_ID || MSG_ID->name() != "msg") return false;
+            auto const* MSG_DECL = MSG_ID->annotation().referencedDeclaration;
+            if (!dynamic_cast<MagicVariableDeclaration const*>(MSG_DECL))
+            {
+                return false;
+            }
+            if (mem->memberName() != "sender") return false;
+            _entry.second.emplace_back(nullptr, "msg.sender");
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+void MapAccessCache::analyze(Statement const& _stmt)
+{
+    ScopedSwap<Statement const*> swap(m_stmt, &_stmt);
+
+    if (auto expr_stmt = dynamic_cast<ExpressionStatement const*>(&_stmt))
+    {
+        auto const& EXPR = ExpressionCleaner(expr_stmt->expression()).clean();
+        if (auto assign = dynamic_cast<Assignment const*>(&EXPR))
+        {
+            // A compound assignment also reads its destination.
+            auto const& LHS = ExpressionCleaner(assign->leftHandSide()).clean();
+            auto const* MAP = LValueSniffer<IndexAccess>(LHS).find();
+            if (assign->assignmentOperator() != Token::Assign || !MAP
+                || !is_map_access(*MAP))
+            {
+                LHS.accept(*this);
+            }
+            else
+            {
+                FlatIndex idx(*MAP);
+                for (auto const* key : idx.indices())
+                {
+                    key->accept(*this);
+                }
+            }
+            assign->rightHandSide().accept(*this);
+
+            // The destination is written after all reads.
+            if (MAP)
+            {
+                // Array entries are neither cached, nor used as keys.
+                if (is_map_access(*MAP)) write_entry(*MAP);
+            }
+            else if (auto id = LValueSniffer<Identifier>(LHS).find())
+            {
+                write_variable(*id->annotation().referencedDeclaration);
+            }
+        }
+        else if (auto op = dynamic_cast<UnaryOperation const*>(&EXPR))
+        {
+            auto const& SUB = ExpressionCleaner(op->subExpression()).clean();
+            auto const* ID = dynamic_cast<Identifier const*>(&SUB);
+            if (ID && (op->getOperator() == Token::Inc
+                    || op->getOperator() == Token::Dec))
+            {
+                write_variable(*ID->annotation().referencedDeclaration);
+            }
+            else
+            {
+                EXPR.accept(*this);
+            }
+        }
+        else
+        {
+            EXPR.accept(*this);
+        }
+    }
+    else if (auto decl = dynamic_cast<DeclStmt const*>(&_stmt))
+    {
+        if (decl->initialValue()) decl->initialValue()->accept(*this);
+    }
+    else if (auto ret = dynamic_cast<Return const*>(&_stmt))
+    {
+        if (ret->expression()) ret->expression()->accept(*this);
+    }
+}
+
+void MapAccessCache::write_entry(IndexAccess const& _node)
+{
+    // If the entry is unknown, then any entry may be overwritten.
+    Entry entry;
+    if (!resolve_entry(_node, entry))
+    {
+        drop_if([](Entry const&) { return true; });
+        return;
+    }
+
+    // Other entries of the same map may have the same keys at runtime.
+    drop_if([&](Entry const& _other) {
+        return (_other.first == entry.first && _other.second != entry.second);
+    });
+
+    find_live(entry).push_back(Access{&_node, true, m_stmt});
+}
+
+void MapAccessCache::write_variable(Declaration const& _decl)
+{
+    drop_if([&](Entry const& _entry) {
+        for (auto const& key : _entry.second)
+        {
+            if (key.first == &_decl) return true;
+        }
+        return false;
+    });
+}
+
+vector<MapAccessCache::Access> & MapAccessCache::find_live(
+    Entry const& _entry
+)
+{
+    for (auto & live : m_live)
+    {
+        if (live.first == _entry) return live.second;
+    }
+    m_live.emplace_back(_entry, vector<Access>());
+    return m_live.back().second;
+}
+
+template <typename Pred>
+void MapAccessCache::drop_if(Pred _pred)
+{
+    decltype(m_live) kept;
+    for (auto & live : m_live)
+    {
+        if (_pred(live.first))
+        {
+            drop(live.second);
+        }
+        else
+        {
+            kept.push_back(move(live));
+        }
+    }
+    m_live = move(kept);
+}
+
+void MapAccessCache::drop(vector<Access> const& _accesses)
+{
+    // A slot is only useful if some read follows the first access.
+    size_t last_read = 0;
+    for (size_t i = 1; i < _accesses.size(); ++i)
+    {
+        if (!_accesses[i].write) last_read = i;
+    }
+    if (last_read == 0) return;
+
+    size_t const ID = m_next_id++;
+    auto const& FIRST = _accesses.front();
+    m_opens[FIRST.stmt].push_back(Slot{ID, FIRST.node, !FIRST.write});
+
+    for (size_t i = 0; i < _accesses.size(); ++i)
+    {
+        if (!_accesses[i].write)
+        {
+            m_reads[_accesses[i].node] = ID;
+        }
+        else if (i < last_read)
+        {
+            m_writes[_accesses[i].node] = ID;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
@@ -0,0 +1,147 @@
+/**
+ * Plans the caching of map entries within a function body. Each Read_<map> or
+ * Write_<map> call dispatches over all keys of the map. If an entry is accessed
+ * several times within straight-line code, then the entry may be kept in a
+ * temporary, so that only the first read dispatches.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Finds map entries which are accessed more than once within a straight-line
+ * region of some block. A region is a maximal sequence of statements, in which
+ * the only side-effect of each statement is a single top-level assignment (or
+ * increment), and the only calls are to require, to assert, or are conversions.
+ *
+ * Within a region, an entry is identified by its map (a state variable) and by
+ * its keys (each a variable, a literal, or msg.sender). An entry is dropped if
+ * one of its key variables is written, or if any other entry of the same map is
+ * written, as the keys may alias. When the entry is dropped, it is assigned a
+ * slot if it was read at least once after its first access.
+ *
+ * A slot is declared before the statement of its first access. If this access
+ * is a read, then the slot is initialized by the read, and all reads are then
+ * served by the slot. Otherwise, the slot is set by the first write. Writes
+ * still update the map, but also update the slot if it is read later on.
+ *
+ * Reads which may not be evaluated (i.e., under ?:, && or ||) are never served
+ * by a slot, as the slot would then load the entry unconditionally.
+ */
+class MapAccessCache : public ASTConstVisitor
+{
+public:
+    // A temporary which caches a single map entry.
+    struct Slot
+    {
+        // A unique identifier for this slot.
+        size_t id;
+        // The first access to the entry.
+        IndexAccess const* access;
+        // If true, the first access is a read, and initializes the slot.
+        bool load;
+    };
+
+    // Plans the caching of all map entries accessed within _body.
+    explicit MapAccessCache(Block const& _body);
+
+    // Returns the name of the temporary for slot _id.
+    static std::string name(size_t _id);
+
+    // Returns the slots which must be declared before _stmt is executed.
+    std::vector<Slot> const& opens(Statement const& _stmt) const;
+
+    // If the map read at _node is served by a slot, then true is returned and
+    // the slot identifier is written to _id.
+    bool reads_slot(IndexAccess const& _node, size_t & _id) const;
+
+    // If the map write at _node must also update a slot, then true is returned
+    // and the slot identifier is written to _id.
+    bool writes_slot(IndexAccess const& _node, size_t & _id) const;
+
+protected:
+    bool visit(Block const& _node) override;
+    bool visit(IndexAccess const& _node) override;
+    bool visit(Conditional const& _node) override;
+    bool visit(BinaryOperation const& _node) override;
+
+private:
+    // A single key of an entry is either a declaration, or a fixed value.
+    using Key = std::pair<Declaration const*, std::string>;
+    using Entry = std::pair<VariableDeclaration const*, std::vector<Key>>;
+
+    // A single read or write of an entry, and the statement it belongs to.
+    struct Access
+    {
+        IndexAccess const* node;
+        bool write;
+        Statement const* stmt;
+    };
+
+    static std::vector<Slot> const EMPTY;
+
+    size_t m_next_id = 0;
+
+    // The statement of the current region being analyzed, or nullptr.
+    Statement const* m_stmt = nullptr;
+
+    // If true, the expression being analyzed may not be evaluated.
+    bool m_conditional = false;
+
+    // The entries of the current region, in order of first access.
+    std::vector<std::pair<Entry, std::vector<Access>>> m_live;
+
+    std::map<Statement const*, std::vector<Slot>> m_opens;
+    std::map<IndexAccess const*, size_t> m_reads;
+    std::map<IndexAccess const*, size_t> m_writes;
+
+    // Returns true if _stmt may belong to a region.
+    static bool is_straight_line(Statement const& _stmt);
+
+    // If _node is a complete access to a map state variable, of a wrapped value
+    // type, and with stable keys, then its entry is written to _entry and true
+    // is returned.
+    static bool resolve_entry(IndexAccess const& _node, Entry & _entry);
+
+    // Records all accesses of the statement _stmt, within the current region.
+    void analyze(Statement const& _stmt);
+
+    // Returns the accesses to _entry within the current region.
+    std::vector<Access> & find_live(Entry const& _entry);
+
+    // Records a write to the map entry at _node.
+    void write_entry(IndexAccess const& _node);
+
+    // Records a write to the variable _decl.
+    void write_variable(Declaration const& _decl);
+
+    // Drops all live entries for which _pred holds.
+    template <typename Pred>
+    void drop_if(Pred _pred);
+
+    // Drops a single entry, assigning it a slot if this is beneficial.
+    void drop(std::vector<Access> const& _accesses);
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
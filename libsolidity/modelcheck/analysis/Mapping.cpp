@@ -37,6 +37,41 @@ bool MappingExtractor::visit(Mapping const& _node)
 
 // -------------------------------------------------------------------------- //
 
+vector<string> const& MapDeflate::FlatMap::fields(size_t _width) const
+{
+    auto & table = m_fields[_width];
+    if (table.empty())
+    {
+        // Each suffix is computed once.
+        vector<string> suffixes;
+        suffixes.reserve(_width);
+        for (size_t i = 0; i < _width; ++i)
+        {
+            suffixes.push_back("_" + to_string(i));
+        }
+
+        // Names are extended one key at a time, in lexicographical order.
+        vector<string> names{"data"};
+        for (size_t depth = 0; depth < key_types.size(); ++depth)
+        {
+            vector<string> next;
+            next.reserve(names.size() * _width);
+            for (auto const& prefix : names)
+            {
+                for (auto const& suffix : suffixes)
+                {
+                    next.push_back(prefix + suffix);
+                }
+            }
+            names = move(next);
+        }
+        table = move(names);
+    }
+    return table;
+}
+
+// -------------------------------------------------------------------------- //
+
 MapDeflate::Record MapDeflate::query(Mapping const& _map)
 {
     const string STRUCT_TO_MAP_ERR =
@@ -64,6 +64,15 @@ public:
         std::string name;
         std::vector<ElementaryTypeName const*> key_types;
         TypeName const* value_type;
+
+        // Returns the field name of each entry, if each key takes on _width
+        // values. Names are indexed by KeyIterator::ordinal(). The table for
+        // each width is built on first use, and is then shared by all
+        // generators. A table is never invalidated by later calls.
+        std::vector<std::string> const& fields(size_t _width) const;
+
+    private:
+        mutable std::map<size_t, std::vector<std::string>> m_fields;
     };
     using Record = std::shared_ptr<FlatMap const>;
 
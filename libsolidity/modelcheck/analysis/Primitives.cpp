@@ -162,11 +162,18 @@ void PrimitiveTypeGenerator::declare_primitive(
     ostream& _out, string const& _type, string const& _data
 )
 {
-    CStructDef decl(_type, make_shared<CParams>(CParams{
-        make_shared<CVarDecl>(_data, "v")
-    }));
-
     string const TYPEDEF = _type + "_t";
+    if (PrimitiveToRaw::is_unwrapped(_out))
+    {
+        _out << CTypedef(_data, TYPEDEF);
+    }
+    else
+    {
+        CStructDef decl(_type, make_shared<CParams>(CParams{
+            make_shared<CVarDecl>(_data, "v")
+        }));
+        _out << decl << *decl.make_typedef(TYPEDEF);
+    }
 
     auto id = InitFunction(TYPEDEF).call_id();
     auto raw_val = make_shared<CVarDecl>(_data, "v");
@@ -178,8 +185,7 @@ void PrimitiveTypeGenerator::declare_primitive(
         make_shared<CReturn>(tmp_dcl->id())
     });
 
-    _out << decl << *decl.make_typedef(TYPEDEF)
-         << CFuncDef(id, {raw_val}, block, CFuncDef::Modifier::INLINE);
+    _out << CFuncDef(id, {raw_val}, block, CFuncDef::Modifier::INLINE);
 }
 
 // -------------------------------------------------------------------------- //
@@ -2,7 +2,8 @@
  * SmartACE wraps all primitive Solidity types in singleton structures. This
  * allows for more flexability in analysis (the compiler is aware of these types
  * now). This file analyzes source units to determine which primitives are in
- * use.
+ * use. If a stream is unwrapped (see PrimitiveToRaw::unwrap), then plain
+ * typedefs are printed instead.
  * 
  * @date 2019
  */
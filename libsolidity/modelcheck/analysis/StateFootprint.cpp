@@ -0,0 +1,341 @@
+#include <libsolidity/modelcheck/analysis/StateFootprint.h>
+
+#include <libsolidity/modelcheck/analysis/FunctionCall.h>
+#include <libsolidity/modelcheck/analysis/Inheritance.h>
+#include <libsolidity/modelcheck/utils/Function.h>
+#include <libsolidity/modelcheck/utils/General.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+bool intersects(
+    StateFootprint::VariableSet const& _lhs,
+    StateFootprint::VariableSet const& _rhs
+)
+{
+    for (auto var : _lhs)
+    {
+        if (_rhs.find(var) != _rhs.end()) return true;
+    }
+    return false;
+}
+}
+
+// -------------------------------------------------------------------------- //
+
+StateFootprint::StateFootprint(
+    FlatContract const& _contract, FunctionDefinition const& _func
+): M_CONTRACT(_contract)
+{
+    m_writes_balance = _func.isPayable();
+    follow(_func);
+}
+
+StateFootprint::VariableSet const& StateFootprint::reads() const
+{
+    return m_reads;
+}
+
+StateFootprint::VariableSet const& StateFootprint::writes() const
+{
+    return m_writes;
+}
+
+bool StateFootprint::reads_time() const
+{
+    return m_reads_time;
+}
+
+bool StateFootprint::reads_balance() const
+{
+    return m_reads_balance;
+}
+
+bool StateFootprint::writes_balance() const
+{
+    return m_writes_balance;
+}
+
+bool StateFootprint::is_opaque() const
+{
+    return m_opaque;
+}
+
+bool StateFootprint::asserts() const
+{
+    return m_asserts;
+}
+
+bool StateFootprint::preserves_state(bool _readonly) const
+{
+    // The assertions of an opaque transaction are unknown.
+    if (m_opaque || m_asserts) return false;
+    if (_readonly) return true;
+    return (m_writes.empty() && !m_writes_balance);
+}
+
+bool StateFootprint::conflicts(StateFootprint const& _other, bool _shared) const
+{
+    // Nothing is known about an opaque transaction.
+    if (m_opaque || _other.m_opaque) return true;
+
+    // The harness may advance time between transactions. If both transactions
+    // observe time, then their order is observable.
+    if (m_reads_time && _other.m_reads_time) return true;
+
+    // Balances are not tracked per address.
+    if (m_writes_balance)
+    {
+        if (_other.m_reads_balance || _other.m_writes_balance) return true;
+    }
+    if (_other.m_writes_balance && m_reads_balance) return true;
+
+    // Each write is also recorded as a read.
+    if (_shared)
+    {
+        if (intersects(m_writes, _other.m_reads)) return true;
+        if (intersects(m_reads, _other.m_writes)) return true;
+    }
+    return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool StateFootprint::visit(ModifierInvocation const& _node)
+{
+    if (_node.arguments())
+    {
+        for (auto arg : (*_node.arguments()))
+        {
+            visit_expr(*arg, false);
+        }
+    }
+
+    string const& target = _node.name()->name();
+    for (auto match : M_CONTRACT.modifiers())
+    {
+        if (match->name() == target && m_visited.insert(match).second)
+        {
+            match->body().accept(*this);
+        }
+    }
+
+    return false;
+}
+
+bool StateFootprint::visit(Assignment const& _node)
+{
+    visit_expr(_node.leftHandSide(), true);
+    visit_expr(_node.rightHandSide(), false);
+    return false;
+}
+
+bool StateFootprint::visit(UnaryOperation const& _node)
+{
+    Token const OP = _node.getOperator();
+    bool const IS_WRITE = (OP == Token::Inc)
+                       || (OP == Token::Dec)
+                       || (OP == Token::Delete);
+    visit_expr(_node.subExpression(), IS_WRITE);
+    return false;
+}
+
+bool StateFootprint::visit(FunctionCall const& _node)
+{
+    ScopedSwap<bool> write_scope(m_write, false);
+    ScopedSwap<bool> deref_scope(m_deref, false);
+
+    // Casts and structure constructors only read their arguments.
+    if (_node.annotation().kind != FunctionCallKind::FunctionCall)
+    {
+        for (auto arg : _node.arguments())
+        {
+            arg->accept(*this);
+        }
+        return false;
+    }
+
+    FunctionCallAnalyzer call(_node);
+    if (call.is_low_level())
+    {
+        m_opaque = true;
+        return false;
+    }
+
+    switch (call.classify())
+    {
+    case FunctionCallAnalyzer::CallGroup::Method:
+        if (call.is_in_library())
+        {
+            // The bound argument is passed as a storage reference.
+            if (auto ctx = call.context())
+            {
+                ctx->accept(*this);
+            }
+            follow(call.method_decl());
+        }
+        else if (call.is_super())
+        {
+            // Diamond inheritance is over-approximated by all candidates.
+            auto const* raw = M_CONTRACT.tree().raw();
+            for (auto base : raw->annotation().linearizedBaseContracts)
+            {
+                for (auto func : base->definedFunctions())
+                {
+                    if (collid(*func, call.method_decl())) follow(*func);
+                }
+            }
+        }
+        else if (call.context())
+        {
+            m_opaque = true;
+        }
+        else if (auto match = M_CONTRACT.try_resolve(call.method_decl()))
+        {
+            follow(*match);
+        }
+        else
+        {
+            follow(call.method_decl());
+        }
+        break;
+    case FunctionCallAnalyzer::CallGroup::Push:
+    case FunctionCallAnalyzer::CallGroup::Pop:
+        visit_expr(_node.expression(), true);
+        break;
+    case FunctionCallAnalyzer::CallGroup::Blockhash:
+        m_reads_time = true;
+        break;
+    case FunctionCallAnalyzer::CallGroup::Assert:
+        m_asserts = true;
+        break;
+    case FunctionCallAnalyzer::CallGroup::Delegate:
+    case FunctionCallAnalyzer::CallGroup::Constructor:
+    case FunctionCallAnalyzer::CallGroup::Send:
+    case FunctionCallAnalyzer::CallGroup::Transfer:
+    case FunctionCallAnalyzer::CallGroup::Destruct:
+    case FunctionCallAnalyzer::CallGroup::UnhandledCall:
+        m_opaque = true;
+        break;
+    default:
+        break;
+    }
+
+    for (auto arg : call.args())
+    {
+        arg->accept(*this);
+    }
+
+    return false;
+}
+
+bool StateFootprint::visit(MemberAccess const& _node)
+{
+    auto const& base = _node.expression();
+    auto const* base_type = base.annotation().type;
+    if (auto magic = dynamic_cast<MagicType const*>(base_type))
+    {
+        if (magic->kind() == MagicType::Kind::Block) m_reads_time = true;
+    }
+    else if (_node.memberName() == "balance")
+    {
+        m_reads_balance = true;
+    }
+
+    bool const IS_WRITE = m_write || escapes(_node.annotation().type);
+    ScopedSwap<bool> write_scope(m_write, IS_WRITE);
+    ScopedSwap<bool> deref_scope(m_deref, true);
+    base.accept(*this);
+    return false;
+}
+
+bool StateFootprint::visit(IndexAccess const& _node)
+{
+    bool const IS_WRITE = m_write || escapes(_node.annotation().type);
+    {
+        ScopedSwap<bool> write_scope(m_write, IS_WRITE);
+        ScopedSwap<bool> deref_scope(m_deref, true);
+        _node.baseExpression().accept(*this);
+    }
+
+    if (auto idx = _node.indexExpression())
+    {
+        visit_expr(*idx, false);
+    }
+
+    return false;
+}
+
+bool StateFootprint::visit(Identifier const& _node)
+{
+    auto const* ref = _node.annotation().referencedDeclaration;
+    if (auto decl = dynamic_cast<VariableDeclaration const*>(ref))
+    {
+        if (decl->isStateVariable() && !decl->isConstant())
+        {
+            m_reads.insert(decl);
+            if (m_write || escapes(_node.annotation().type))
+            {
+                m_writes.insert(decl);
+            }
+        }
+    }
+    else if (dynamic_cast<MagicVariableDeclaration const*>(ref))
+    {
+        if (_node.name() == "now") m_reads_time = true;
+    }
+    return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+void StateFootprint::follow(FunctionDefinition const& _func)
+{
+    if (!m_visited.insert(&_func).second) return;
+
+    if (!_func.isImplemented())
+    {
+        m_opaque = true;
+        return;
+    }
+
+    for (auto mod : _func.modifiers())
+    {
+        mod->accept(*this);
+    }
+    _func.body().accept(*this);
+}
+
+void StateFootprint::visit_expr(Expression const& _expr, bool _write)
+{
+    ScopedSwap<bool> write_scope(m_write, _write);
+    ScopedSwap<bool> deref_scope(m_deref, false);
+    _expr.accept(*this);
+}
+
+bool StateFootprint::escapes(TypePointer _type) const
+{
+    if (m_deref || !_type) return false;
+    if (_type->category() == Type::Category::Mapping) return true;
+    if (auto ref = dynamic_cast<ReferenceType const*>(_type))
+    {
+        return (ref->location() == DataLocation::Storage);
+    }
+    return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
@@ -0,0 +1,119 @@
+/**
+ * Over-approximates the contract state touched by a single transaction. This is
+ * used to determine which transactions commute.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <set>
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+class FlatContract;
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Computes the read and write sets of a transaction, with respect to the state
+ * variables of the contract against which it executes. All modifiers and all
+ * internal calls (including library calls) are followed.
+ *
+ * All analysis is flow-insensitive and field-insensitive. That is, an access to
+ * any member or entry of a state variable is treated as an access to the entire
+ * variable. If a storage reference escapes (e.g., it is bound to a local storage
+ * pointer, or is passed to another method), then the referenced variable is
+ * assumed to be written.
+ */
+class StateFootprint : public ASTConstVisitor
+{
+public:
+    using VariableSet = std::set<VariableDeclaration const*>;
+
+    // Summarizes a transaction to _func, as executed against _contract.
+    StateFootprint(FlatContract const& _contract, FunctionDefinition const& _func);
+
+    // Returns all state variables the transaction may read.
+    VariableSet const& reads() const;
+
+    // Returns all state variables the transaction may write.
+    VariableSet const& writes() const;
+
+    // Returns true if the block number, block timestamp, or block hash is read.
+    bool reads_time() const;
+
+    // Returns true if the balance of any address is read.
+    bool reads_balance() const;
+
+    // Returns true if the balance of the contract may change.
+    bool writes_balance() const;
+
+    // Returns true if the transaction may leave the contract (e.g., external
+    // calls, transfers and allocations). In this case, the footprint is unknown.
+    bool is_opaque() const;
+
+    // Returns true if the transaction may call assert.
+    bool asserts() const;
+
+    // Returns true if the transaction can neither change the state of the model
+    // nor fail an assertion. If _readonly is set, then the transaction is known
+    // not to write state (e.g., it is view or pure).
+    bool preserves_state(bool _readonly) const;
+
+    // Returns true if this transaction and _other may not commute. If _shared
+    // is false, then the transactions execute against distinct contracts.
+    bool conflicts(StateFootprint const& _other, bool _shared) const;
+
+protected:
+    bool visit(ModifierInvocation const& _node) override;
+    bool visit(Assignment const& _node) override;
+    bool visit(UnaryOperation const& _node) override;
+    bool visit(FunctionCall const& _node) override;
+    bool visit(MemberAccess const& _node) override;
+    bool visit(IndexAccess const& _node) override;
+    bool visit(Identifier const& _node) override;
+
+private:
+    // Follows a call to _func, if it has not yet been analyzed.
+    void follow(FunctionDefinition const& _func);
+
+    // Visits _expr, where _write indicates if _expr is written.
+    void visit_expr(Expression const& _expr, bool _write);
+
+    // Returns true if the current expression, of type _type, escapes.
+    bool escapes(TypePointer _type) const;
+
+    FlatContract const& M_CONTRACT;
+
+    // All methods analyzed so far.
+    std::set<CallableDeclaration const*> m_visited;
+
+    // If true, the current expression is the destination of a write.
+    bool m_write = false;
+
+    // If true, the current expression is the base of a member or index access.
+    bool m_deref = false;
+
+    VariableSet m_reads;
+    VariableSet m_writes;
+
+    bool m_reads_time = false;
+    bool m_reads_balance = false;
+    bool m_writes_balance = false;
+    bool m_opaque = false;
+    bool m_asserts = false;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
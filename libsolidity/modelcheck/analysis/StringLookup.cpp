@@ -59,6 +59,11 @@ uint32_t StringLookup::lookup(Literal const& _node) const
     return res->second;
 }
 
+uint32_t StringLookup::count() const
+{
+    return m_curr_index;
+}
+
 void StringLookup::endVisit(Literal const& _node)
 {
     if (_node.token() == Token::StringLiteral)
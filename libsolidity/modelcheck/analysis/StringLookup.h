@@ -39,6 +39,10 @@ public:
     // literal is not a string.
     uint32_t lookup(Literal const& _node) const;
 
+    // Returns the number of values in use. Values are numbered from 0, and the
+    // empty string is always 0.
+    uint32_t count() const;
+
 protected:
     void endVisit(Literal const& _node) override;
 
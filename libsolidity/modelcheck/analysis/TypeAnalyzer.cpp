@@ -36,6 +36,8 @@ map<string, string> const TypeAnalyzer::m_global_context_types({
 
 set<string> const TypeAnalyzer::m_global_simple_values({"now"});
 
+size_t const TypeAnalyzer::MAX_ARRAY_LENGTH = (1 << 16);
+
 // -------------------------------------------------------------------------- //
 
 TypeAnalyzer::TypeAnalyzer(
@@ -60,7 +62,7 @@ TypeAnalyzer::TypeAnalyzer(
 
         for (auto e : contract->definedEnums())
         {
-            m_type_lookup.insert({e, get_simple_ctype(*e->type())});
+            set_type(*e, get_simple_ctype(*e->type()));
         }
 
         for (auto structure : contract->definedStructs())
@@ -68,12 +70,12 @@ TypeAnalyzer::TypeAnalyzer(
             ostringstream struct_oss;
             struct_oss << cname << "_Struct_" << escape_decl_name(*structure);
 
-            m_name_lookup.insert({structure, struct_oss.str()});
-            m_type_lookup.insert({structure, "struct " + struct_oss.str()});
+            set_name(*structure, struct_oss.str());
+            set_type(*structure, "struct " + struct_oss.str());
         }
 
-        m_name_lookup.insert({contract, cname});
-        m_type_lookup.insert({contract, "struct " + cname});
+        set_name(*contract, cname);
+        set_type(*contract, "struct " + cname);
     }
 
     // Pass 2: assign types to all member fields and methods, such that their
@@ -90,6 +92,7 @@ TypeAnalyzer::TypeAnalyzer(
 
         for (auto decl : con->stateVariables())
         {
+            ScopedSwap<bool> swap(m_is_state, true);
             decl->accept(*this);
         }
     }
@@ -104,8 +107,8 @@ TypeAnalyzer::TypeAnalyzer(
             returnParams->accept(*this);
         }
 
-        //m_name_lookup.insert({fun, FunctionSpecialization(*fun).name(0)});
-        m_type_lookup.insert({fun, get_type(*returnParams)});
+        //set_name(*fun, FunctionSpecialization(*fun).name(0));
+        set_type(*fun, get_type(*returnParams));
     }
     for (auto modifier : _calls.applied_modifiers())
     {
@@ -131,17 +134,18 @@ bool TypeAnalyzer::is_pointer(Identifier const& _id) const
     return RES != m_in_storage.end() && RES->second;
 }
 
-string TypeAnalyzer::get_type(ASTNode const& _node) const
+string const& TypeAnalyzer::get_type(ASTNode const& _node) const
 {
-    if (m_type_lookup.find(&_node) == m_type_lookup.end())
+    auto const& RES = m_type_lookup.find(&_node);
+    if (RES == m_type_lookup.end())
     {
         string name = get_error_type(&_node);
         throw runtime_error("get_type called on unknown ASTNode: " + name);
     }
-    return m_type_lookup.find(&_node)->second;
+    return m_strings[RES->second];
 }
 
-string TypeAnalyzer::get_name(ASTNode const& _node) const
+string const& TypeAnalyzer::get_name(ASTNode const& _node) const
 {
     auto const& RES = m_name_lookup.find(&_node);
     if (RES == m_name_lookup.end())
@@ -149,7 +153,7 @@ string TypeAnalyzer::get_name(ASTNode const& _node) const
         string name = get_error_type(&_node);
         throw runtime_error("get_name called on unknown ASTNode: " + name);
     }
-    return RES->second;
+    return m_strings[RES->second];
 }
 
 // -------------------------------------------------------------------------- //
@@ -207,25 +211,45 @@ CExprPtr TypeAnalyzer::init_val_by_simple_type(Type const& _type)
 
 CExprPtr TypeAnalyzer::get_init_val(TypeName const& _typename) const
 {
+    auto slot = init_val_slot(_typename);
+    if (slot && *slot) return *slot;
+
+    CExprPtr init_val;
     if (has_simple_type(_typename))
     {
-        return init_val_by_simple_type(*_typename.annotation().type);
+        init_val = init_val_by_simple_type(*_typename.annotation().type);
     }
-    return InitFunction(*this, _typename).defaulted();
+    else
+    {
+        init_val = InitFunction(*this, _typename).defaulted();
+    }
+
+    if (slot) *slot = init_val;
+    return init_val;
 }
 
 CExprPtr TypeAnalyzer::get_init_val(Declaration const& _decl) const
 {
+    auto slot = init_val_slot(_decl);
+    if (slot && *slot) return *slot;
+
+    CExprPtr init_val;
     if (has_simple_type(_decl))
     {
-        return init_val_by_simple_type(*_decl.type());
+        init_val = init_val_by_simple_type(*_decl.type());
     }
-    return InitFunction(*this, _decl).defaulted();
+    else
+    {
+        init_val = InitFunction(*this, _decl).defaulted();
+    }
+
+    if (slot) *slot = init_val;
+    return init_val;
 }
 
 // -------------------------------------------------------------------------- //
 
-MapDeflate TypeAnalyzer::map_db() const { return m_map_db; }
+MapDeflate const& TypeAnalyzer::map_db() const { return m_map_db; }
 
 // -------------------------------------------------------------------------- //
 
@@ -244,10 +268,10 @@ bool TypeAnalyzer::visit(VariableDeclaration const& _node)
 
         auto const& VAR_TYPENAME = *_node.typeName();
         VAR_TYPENAME.accept(*this);
-        m_type_lookup.insert({&_node, get_type(VAR_TYPENAME)});
+        set_type(_node, get_type(VAR_TYPENAME));
         if (!has_simple_type(VAR_TYPENAME))
         {
-            m_name_lookup.insert({&_node, get_name(VAR_TYPENAME)});
+            set_name(_node, get_name(VAR_TYPENAME));
         }
     }
 
@@ -256,17 +280,17 @@ bool TypeAnalyzer::visit(VariableDeclaration const& _node)
 
 bool TypeAnalyzer::visit(ElementaryTypeName const& _node)
 {
-    m_type_lookup.insert({&_node, get_simple_ctype(*_node.annotation().type)});
+    set_type(_node, get_simple_ctype(*_node.annotation().type));
     return false;
 }
 
 bool TypeAnalyzer::visit(UserDefinedTypeName const& _node)
 {
     auto const& REF = *_node.annotation().referencedDeclaration;
-    m_type_lookup.insert({&_node, get_type(REF)});
+    set_type(_node, get_type(REF));
     if (!has_simple_type(REF))
     {
-        m_name_lookup.insert({&_node, get_name(REF)});
+        set_name(_node, get_name(REF));
     }
     return false;
 }
@@ -278,9 +302,11 @@ bool TypeAnalyzer::visit(FunctionTypeName const&)
 
 bool TypeAnalyzer::visit(Mapping const& _node)
 {
+    ScopedSwap<bool> swap(m_is_state, false);
+
     auto const& record = m_map_db.query(_node);
-    m_name_lookup.insert({&_node, record->name});
-    m_type_lookup.insert({&_node, "struct " + record->name});
+    set_name(_node, record->name);
+    set_type(_node, "struct " + record->name);
 
     for (auto const* key : record->key_types)
     {
@@ -291,18 +317,60 @@ bool TypeAnalyzer::visit(Mapping const& _node)
     return false;
 }
 
-bool TypeAnalyzer::visit(ArrayTypeName const&)
+bool TypeAnalyzer::visit(ArrayTypeName const& _node)
 {
-    throw runtime_error("Array type unsupported.");
+    if (m_name_lookup.find(&_node) != m_name_lookup.end()) return false;
+
+    auto const& TYPE = dynamic_cast<ArrayType const&>(*_node.annotation().type);
+    if (!m_is_state || TYPE.isDynamicallySized())
+    {
+        throw runtime_error("Array type unsupported.");
+    }
+    else if (TYPE.length() > MAX_ARRAY_LENGTH)
+    {
+        throw runtime_error("Array length unsupported.");
+    }
+
+    _node.baseType().accept(*this);
+    if (!has_simple_type(_node.baseType()))
+    {
+        throw runtime_error("Array of compound type unsupported.");
+    }
+
+    // Arrays of the same element type and length share a name, so that one
+    // array may be assigned to another.
+    string const LEN = to_string(static_cast<size_t>(TYPE.length()));
+    string const NAME = "Array_" + get_type(_node.baseType()) + "_" + LEN;
+    set_name(_node, NAME);
+    set_type(_node, "struct " + NAME);
+
+    return false;
 }
 
 bool TypeAnalyzer::visit(IndexAccess const& _node)
 {
+    // Arrays are indexed directly, with one index per access.
+    auto const& BASE = _node.baseExpression();
+    if (BASE.annotation().type->category() == Type::Category::Array)
+    {
+        if (!_node.indexExpression())
+        {
+            throw runtime_error("Array access with null index.");
+        }
+
+        set_type(_node, get_simple_ctype(*_node.annotation().type));
+
+        _node.indexExpression()->accept(*this);
+        BASE.accept(*this);
+
+        return false;
+    }
+
     FlatIndex idx(_node);
     auto const& record = m_map_db.resolve(idx.decl());
 
-    m_type_lookup.insert({&_node, get_type(*record->value_type)});
-    m_name_lookup.insert({&_node, record->name});
+    set_type(_node, get_type(*record->value_type));
+    set_name(_node, record->name);
 
     for (auto const* idx_expr : idx.indices())
     {
@@ -329,20 +397,20 @@ void TypeAnalyzer::endVisit(ParameterList const& _node)
         ctype = get_type(PARAM);
         if (!has_simple_type(PARAM))
         {
-            m_name_lookup.insert({&_node, get_name(PARAM)});
+            set_name(_node, get_name(PARAM));
         }
     }
-    m_type_lookup.insert({&_node, ctype});
+    set_type(_node, ctype);
 }
 
 void TypeAnalyzer::endVisit(MemberAccess const& _node)
 {
     if (auto decl = member_access_to_decl(_node))
     {
-        m_type_lookup.insert({&_node, get_type(*decl)});
+        set_type(_node, get_type(*decl));
         if (!has_simple_type(*decl))
         {
-            m_name_lookup.insert({&_node, get_name(*decl)});
+            set_name(_node, get_name(*decl));
         }
     }
 }
@@ -359,13 +427,13 @@ void TypeAnalyzer::endVisit(Identifier const& _node)
     auto const MAGIC_RES = m_global_context_types.find(NODE_NAME);
     if (MAGIC_RES != m_global_context_types.end())
     {
-        m_type_lookup.insert({&_node, MAGIC_RES->second});
+        set_type(_node, MAGIC_RES->second);
         m_in_storage.insert({&_node, false});
 
         auto const MAGIC_SIMPLE = m_global_simple_values.find(NODE_NAME);
         if (MAGIC_SIMPLE != m_global_simple_values.end())
         {
-            m_name_lookup.insert({&_node, NODE_NAME});
+            set_name(_node, NODE_NAME);
         }
     }
     else
@@ -382,17 +450,54 @@ void TypeAnalyzer::endVisit(Identifier const& _node)
             loc = var->referenceLocation();
         }
 
-        m_type_lookup.insert({&_node, get_type(*ref)});
+        set_type(_node, get_type(*ref));
         m_in_storage.insert({&_node, loc == VariableDeclaration::Storage});
         if (!has_simple_type(*ref))
         {
-            m_name_lookup.insert({&_node, get_name(*ref)});
+            set_name(_node, get_name(*ref));
         }
     }
 }
 
 // -------------------------------------------------------------------------- //
 
+size_t TypeAnalyzer::intern(string const& _str)
+{
+    auto const RES = m_string_ids.find(_str);
+    if (RES != m_string_ids.end()) return RES->second;
+
+    size_t const ID = m_strings.size();
+    m_strings.push_back(_str);
+    m_string_ids.emplace(_str, ID);
+    return ID;
+}
+
+void TypeAnalyzer::set_type(ASTNode const& _node, string const& _type)
+{
+    if (m_type_lookup.find(&_node) != m_type_lookup.end()) return;
+    m_type_lookup.emplace(&_node, intern(_type));
+}
+
+void TypeAnalyzer::set_name(ASTNode const& _node, string const& _name)
+{
+    if (m_name_lookup.find(&_node) != m_name_lookup.end()) return;
+    m_name_lookup.emplace(&_node, intern(_name));
+}
+
+CExprPtr* TypeAnalyzer::init_val_slot(ASTNode const& _node) const
+{
+    auto const& RES = m_type_lookup.find(&_node);
+    if (RES == m_type_lookup.end()) return nullptr;
+
+    if (m_init_vals.size() < m_strings.size())
+    {
+        m_init_vals.resize(m_strings.size());
+    }
+    return &m_init_vals[RES->second];
+}
+
+// -------------------------------------------------------------------------- //
+
 }
 }
 }
@@ -13,9 +13,12 @@
 #include <libsolidity/modelcheck/analysis/Mapping.h>
 #include <libsolidity/modelcheck/codegen/Core.h>
 
+#include <deque>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace dev
 {
@@ -41,11 +44,11 @@ public:
 
     // Returns the CType used to model _node, given that has_record has returned
     // true for _node.
-    std::string get_type(ASTNode const& _node) const;
+    std::string const& get_type(ASTNode const& _node) const;
 
     // Returns the representative name for _node, given that has_record has
     // returned true for _node, whereas is_simple_type has filed.
-    std::string get_name(ASTNode const& _node) const;
+    std::string const& get_name(ASTNode const& _node) const;
 
     // Returns true is _id is a pointer. If this cannot be resolved, false is
     // returned.
@@ -57,14 +60,16 @@ public:
     // Produces the initial value of a simple type.
     static CExprPtr init_val_by_simple_type(Type const& _type);
 
-    // Generates the initial value for _typename.
+    // Generates the initial value for _typename. The expression is shared by
+    // all nodes of the same CType.
 	CExprPtr get_init_val(TypeName const& _typename) const;
 
-    // Generates the initial value for _decl.
+    // Generates the initial value for _decl. The expression is shared by all
+    // nodes of the same CType.
 	CExprPtr get_init_val(Declaration const& _decl) const;
 
     // Provides a view of the map database.
-    MapDeflate map_db() const;
+    MapDeflate const& map_db() const;
 
 protected:
     bool visit(VariableDeclaration const& _node) override;
@@ -72,7 +77,7 @@ protected:
 	bool visit(UserDefinedTypeName const& _node) override;
 	bool visit(FunctionTypeName const&) override;
     bool visit(Mapping const& _node) override;
-	bool visit(ArrayTypeName const&) override;
+	bool visit(ArrayTypeName const& _node) override;
     bool visit(IndexAccess const& _node) override;
     bool visit(EventDefinition const&) override;
 
@@ -88,11 +93,36 @@ private:
 
     MapDeflate m_map_db;
 
-    std::map<ASTNode const*, std::string> m_name_lookup;
-    std::map<ASTNode const*, std::string> m_type_lookup;
-    std::map<Identifier const*, bool> m_in_storage;
+    // Each CType and name is stored once, and is referenced by its index. A
+    // deque is used so that references remain valid as the table grows.
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string, size_t> m_string_ids;
+
+    std::unordered_map<ASTNode const*, size_t> m_name_lookup;
+    std::unordered_map<ASTNode const*, size_t> m_type_lookup;
+    std::unordered_map<Identifier const*, bool> m_in_storage;
+
+    // Initial values, indexed by the identifier of their CType.
+    mutable std::vector<CExprPtr> m_init_vals;
 
     bool m_is_retval = false;
+
+    // Fixed-length arrays are only supported as state variables. Each array is
+    // named by its element type and length, and is limited to MAX_ARRAY_LENGTH
+    // entries.
+    static size_t const MAX_ARRAY_LENGTH;
+    bool m_is_state = false;
+
+    // Returns the identifier of _str, after adding it to the string table.
+    size_t intern(std::string const& _str);
+
+    // Records the CType or name of _node, unless it has already been recorded.
+    void set_type(ASTNode const& _node, std::string const& _type);
+    void set_name(ASTNode const& _node, std::string const& _name);
+
+    // Returns the slot which caches the initial value of all nodes with the
+    // same CType as _node. If _node has no CType, then nullptr is returned.
+    CExprPtr* init_val_slot(ASTNode const& _node) const;
 };
 
 // -------------------------------------------------------------------------- //
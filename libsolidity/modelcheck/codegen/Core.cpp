@@ -24,6 +24,11 @@ bool CExpr::is_pointer() const
     return false;
 }
 
+shared_ptr<CExpr> CExpr::simplified() const
+{
+    return nullptr;
+}
+
 // -------------------------------------------------------------------------- //
 
 void CStmt::nest()
@@ -37,6 +42,27 @@ void CStmt::print(ostream & _out) const
     if (!m_is_nested) _out << ";";
 }
 
+shared_ptr<CStmt> CStmt::simplified() const
+{
+    return nullptr;
+}
+
+// -------------------------------------------------------------------------- //
+
+CExprPtr simplify(CExprPtr _expr)
+{
+    if (!_expr) return _expr;
+    auto result = _expr->simplified();
+    return (result ? result : _expr);
+}
+
+CStmtPtr simplify(CStmtPtr _stmt)
+{
+    if (!_stmt) return _stmt;
+    auto result = _stmt->simplified();
+    return (result ? result : _stmt);
+}
+
 // -------------------------------------------------------------------------- //
 
 }
@@ -45,6 +45,11 @@ public:
 
     // Overriden to determine if an element is a pointer. Defaults to false.
     virtual bool is_pointer() const;
+
+    // Overriden to produce an equivalent expression, after folding constants
+    // and removing identities. If there is nothing to simplify, then nullptr
+    // is returned. Defaults to nullptr.
+    virtual std::shared_ptr<CExpr> simplified() const;
 };
 
 // -------------------------------------------------------------------------- //
@@ -62,6 +67,11 @@ public:
     // Once called, the stmt will print itself as if it were a nested sub-stmt.
     void nest();
 
+    // Overriden to produce an equivalent statement, after simplifying each
+    // sub-expression and removing dead code. If there is nothing to simplify,
+    // then nullptr is returned. Defaults to nullptr.
+    virtual std::shared_ptr<CStmt> simplified() const;
+
 private:
     bool m_is_nested = false;
 
@@ -78,6 +88,12 @@ using CArgList = std::vector<CExprPtr>;
 using CBlockList = std::vector<CStmtPtr>;
 using CParams = std::vector<std::shared_ptr<CVarDecl>>;
 
+// Returns the simplification of _expr (or _stmt) if one exists. Otherwise, the
+// input is returned. Nested statements (i.e., for loop headers) must not be
+// passed to simplify, as nesting is not preserved.
+CExprPtr simplify(CExprPtr _expr);
+CStmtPtr simplify(CStmtPtr _stmt);
+
 // -------------------------------------------------------------------------- //
 
 }
@@ -2,8 +2,14 @@
 
 #include <libsolidity/modelcheck/model/Expression.h>
 #include <libsolidity/modelcheck/utils/Function.h>
+#include <libsolidity/modelcheck/utils/Primitives.h>
 #include <libsolidity/modelcheck/utils/Types.h>
 
+#include <libdevcore/Common.h>
+
+#include <climits>
+#include <set>
+
 using namespace std;
 
 namespace dev
@@ -15,6 +21,97 @@ namespace modelcheck
 
 // -------------------------------------------------------------------------- //
 
+namespace
+{
+// Returns true if _expr is an integer literal, and then sets _val to its value.
+bool as_literal(CExprPtr const& _expr, long long int & _val)
+{
+    auto lit = dynamic_cast<CIntLiteral const*>(_expr.get());
+    if (lit) _val = lit->value();
+    return (lit != nullptr);
+}
+
+// Returns true if _expr always evaluates to either 0 or 1.
+bool is_boolean(CExprPtr const& _expr)
+{
+    static set<string> const BOOL_OPS{
+        "==", "!=", "<", "<=", ">", ">=", "&&", "||"
+    };
+
+    long long int val;
+    if (as_literal(_expr, val))
+    {
+        return (val == 0 || val == 1);
+    }
+    else if (auto unop = dynamic_cast<CUnaryOp const*>(_expr.get()))
+    {
+        return (unop->op() == "!" && unop->is_prefix());
+    }
+    else if (auto binop = dynamic_cast<CBinaryOp const*>(_expr.get()))
+    {
+        return (BOOL_OPS.find(binop->op()) != BOOL_OPS.end());
+    }
+    return false;
+}
+
+// A decimal literal is an int if it fits, and is otherwise a long.
+bool fits_int(bigint const& _val)
+{
+    return (INT_MIN <= _val && _val <= INT_MAX);
+}
+
+// Evaluates (_lhs)_op(_rhs), as C would for decimal literals. If the operation
+// is unsupported, or is undefined for these operands, then false is returned.
+bool fold(
+    long long int _lhs, string const& _op, long long int _rhs, bigint & _res
+)
+{
+    bool const IS_INT = (fits_int(_lhs) && fits_int(_rhs));
+
+    if (_op == "+") _res = bigint(_lhs) + _rhs;
+    else if (_op == "-") _res = bigint(_lhs) - _rhs;
+    else if (_op == "*") _res = bigint(_lhs) * _rhs;
+    else if (_op == "/" || _op == "%")
+    {
+        if (_rhs == 0) return false;
+        _res = (_op == "/") ? bigint(_lhs) / _rhs : bigint(_lhs) % _rhs;
+    }
+    else if (_op == "<<" || _op == ">>")
+    {
+        // The type of a shift is the type of its left operand.
+        int const WIDTH = fits_int(_lhs) ? 32 : 64;
+        if (_lhs < 0 || _rhs < 0 || _rhs >= WIDTH) return false;
+        _res = (_op == "<<") ? (bigint(_lhs) << _rhs) : (bigint(_lhs) >> _rhs);
+        return (WIDTH == 32) ? fits_int(_res) : (_res <= LLONG_MAX);
+    }
+    else if (_op == "&") _res = (_lhs & _rhs);
+    else if (_op == "|") _res = (_lhs | _rhs);
+    else if (_op == "^") _res = (_lhs ^ _rhs);
+    else if (_op == "==") _res = (_lhs == _rhs);
+    else if (_op == "!=") _res = (_lhs != _rhs);
+    else if (_op == "<") _res = (_lhs < _rhs);
+    else if (_op == "<=") _res = (_lhs <= _rhs);
+    else if (_op == ">") _res = (_lhs > _rhs);
+    else if (_op == ">=") _res = (_lhs >= _rhs);
+    else if (_op == "&&") _res = (_lhs && _rhs);
+    else if (_op == "||") _res = (_lhs || _rhs);
+    else return false;
+
+    if (IS_INT) return fits_int(_res);
+    return (LLONG_MIN <= _res && _res <= LLONG_MAX);
+}
+
+// Returns true if _stmt transfers control, so that later statements are dead.
+bool is_jump(CStmtPtr const& _stmt)
+{
+    return dynamic_cast<CReturn const*>(_stmt.get())
+        || dynamic_cast<CBreak const*>(_stmt.get())
+        || dynamic_cast<CContinue const*>(_stmt.get());
+}
+}
+
+// -------------------------------------------------------------------------- //
+
 shared_ptr<CAssign> CData::assign(CExprPtr _rhs) const
 {
     return make_shared<CAssign>(expr(), move(_rhs));
@@ -39,16 +136,22 @@ void CComment::print_impl(ostream & _out) const
 
 // -------------------------------------------------------------------------- //
 
-CIdentifier::CIdentifier(string _name, bool _ptr)
-: M_NAME(move(_name)), M_IS_PTR(_ptr) {}
+string const CIdentifier::CONTEXT_PTR = "g_model_ctx";
 
-void CIdentifier::print(ostream & _out) const { _out << M_NAME; }
+CIdentifier::CIdentifier(string _name, bool _ptr, bool _lifted)
+: M_NAME(move(_name)), M_IS_PTR(_ptr), M_IS_LIFTED(_lifted) {}
+
+void CIdentifier::print(ostream & _out) const
+{
+    if (M_IS_LIFTED) _out << CONTEXT_PTR << "->";
+    _out << M_NAME;
+}
 
 bool CIdentifier::is_pointer() const { return M_IS_PTR; }
 
 CExprPtr CIdentifier::expr() const
 {
-    return make_shared<CIdentifier>(M_NAME, M_IS_PTR);
+    return make_shared<CIdentifier>(M_NAME, M_IS_PTR, M_IS_LIFTED);
 }
 
 // -------------------------------------------------------------------------- //
@@ -57,6 +160,8 @@ CIntLiteral::CIntLiteral(long long int _val): M_VAL(_val) {}
 
 void CIntLiteral::print(ostream & _out) const { _out << M_VAL; }
 
+long long int CIntLiteral::value() const { return M_VAL; }
+
 // -------------------------------------------------------------------------- //
 
 string CStringLiteral::escape_cstring(string _val)
@@ -91,6 +196,48 @@ void CUnaryOp::print(ostream & _out) const
     if (!M_PRE) _out << M_OP;
 }
 
+CExprPtr CUnaryOp::simplified() const
+{
+    auto expr = simplify(M_EXPR);
+
+    long long int val;
+    if (M_PRE && as_literal(expr, val))
+    {
+        if (M_OP == "!") return make_shared<CIntLiteral>(!val);
+        if (M_OP == "~") return make_shared<CIntLiteral>(~val);
+        if (M_OP == "-" && val != LLONG_MIN)
+        {
+            return make_shared<CIntLiteral>(-val);
+        }
+    }
+
+    // Cancels *(&(x)) and !(!(x)), where x is boolean.
+    auto inner = dynamic_cast<CUnaryOp const*>(expr.get());
+    if (M_PRE && inner && inner->M_PRE)
+    {
+        if (M_OP == "*" && inner->M_OP == "&") return inner->M_EXPR;
+        if (M_OP == "!" && inner->M_OP == "!" && is_boolean(inner->M_EXPR))
+        {
+            return inner->M_EXPR;
+        }
+    }
+
+    if (expr == M_EXPR) return nullptr;
+    if (dynamic_cast<CReference const*>(this))
+    {
+        return make_shared<CReference>(move(expr));
+    }
+    else if (dynamic_cast<CDereference const*>(this))
+    {
+        return make_shared<CDereference>(move(expr));
+    }
+    return make_shared<CUnaryOp>(M_OP, move(expr), M_PRE);
+}
+
+string const& CUnaryOp::op() const { return M_OP; }
+
+bool CUnaryOp::is_prefix() const { return M_PRE; }
+
 CStmtPtr CUnaryOp::stmt()
 {
     return make_shared<CExprStmt>(make_shared<CUnaryOp>(M_OP, M_EXPR, M_PRE));
@@ -117,6 +264,57 @@ void CBinaryOp::print(ostream & _out) const
     _out << "(" << *M_LHS << ")" << M_OP << "(" << *M_RHS << ")";
 }
 
+CExprPtr CBinaryOp::simplified() const
+{
+    auto lhs = simplify(M_LHS);
+    auto rhs = simplify(M_RHS);
+
+    long long int l, r;
+    bool const IS_LIT_L = as_literal(lhs, l);
+    bool const IS_LIT_R = as_literal(rhs, r);
+
+    bigint res;
+    if (IS_LIT_L && IS_LIT_R && fold(l, M_OP, r, res))
+    {
+        return make_shared<CIntLiteral>((long long int)(res));
+    }
+    else if (IS_LIT_R)
+    {
+        bool const IS_ID_0 = (M_OP == "+" || M_OP == "-" || M_OP == "|"
+                           || M_OP == "^" || M_OP == "<<" || M_OP == ">>");
+        bool const IS_ID_1 = (M_OP == "*" || M_OP == "/");
+        if ((IS_ID_0 && r == 0) || (IS_ID_1 && r == 1)) return lhs;
+        if (is_boolean(lhs))
+        {
+            if ((M_OP == "&&" && r != 0) || (M_OP == "||" && r == 0))
+            {
+                return lhs;
+            }
+        }
+    }
+    else if (IS_LIT_L)
+    {
+        bool const IS_ID_0 = (M_OP == "+" || M_OP == "|" || M_OP == "^");
+        if ((IS_ID_0 && l == 0) || (M_OP == "*" && l == 1)) return rhs;
+
+        // The right-hand side of a short-circuit is never evaluated.
+        if (M_OP == "&&" && l == 0) return make_shared<CIntLiteral>(0);
+        if (M_OP == "||" && l != 0) return make_shared<CIntLiteral>(1);
+        if (is_boolean(rhs))
+        {
+            if ((M_OP == "&&" && l != 0) || (M_OP == "||" && l == 0))
+            {
+                return rhs;
+            }
+        }
+    }
+
+    if (lhs == M_LHS && rhs == M_RHS) return nullptr;
+    return make_shared<CBinaryOp>(move(lhs), M_OP, move(rhs));
+}
+
+string const& CBinaryOp::op() const { return M_OP; }
+
 CAssign::CAssign(CExprPtr _lhs, CExprPtr _rhs): CBinaryOp(_lhs, "=", _rhs) {}
 
 // -------------------------------------------------------------------------- //
@@ -138,6 +336,26 @@ void CCond::print(ostream & _out) const
 
 bool CCond::is_pointer() const { return M_TRUE_CASE->is_pointer(); }
 
+CExprPtr CCond::simplified() const
+{
+    auto cond = simplify(M_COND);
+
+    long long int val;
+    if (as_literal(cond, val))
+    {
+        return simplify(val ? M_TRUE_CASE : M_FALSE_CASE);
+    }
+
+    auto true_case = simplify(M_TRUE_CASE);
+    auto false_case = simplify(M_FALSE_CASE);
+    bool const SAME_CASES = (true_case == M_TRUE_CASE);
+    if (cond == M_COND && SAME_CASES && false_case == M_FALSE_CASE)
+    {
+        return nullptr;
+    }
+    return make_shared<CCond>(move(cond), move(true_case), move(false_case));
+}
+
 CStmtPtr CCond::stmt()
 {
     auto cond = make_shared<CCond>(M_COND, M_TRUE_CASE, M_FALSE_CASE);
@@ -147,17 +365,67 @@ CStmtPtr CCond::stmt()
 // -------------------------------------------------------------------------- //
 
 CMemberAccess::CMemberAccess(CExprPtr _expr, string _member)
- : M_EXPR(move(_expr)), M_MEMBER(move(_member)) {}
+ : CMemberAccess(move(_expr), move(_member), "") {}
+
+CMemberAccess::CMemberAccess(CExprPtr _expr, string _member, string _inverse)
+ : M_EXPR(move(_expr)), M_MEMBER(move(_member)), M_INVERSE(move(_inverse)) {}
 
 void CMemberAccess::print(ostream & _out) const
 {
     bool is_ptr = M_EXPR->is_pointer();
+
+    // User-defined members are never named v, so this is a primitive value.
+    if (M_MEMBER == "v" && PrimitiveToRaw::is_unwrapped(_out))
+    {
+        if (is_ptr) _out << "(*(" << *M_EXPR << "))";
+        else _out << "(" << *M_EXPR << ")";
+        return;
+    }
+
     _out << "(" << *M_EXPR << ")" << (is_ptr ? "->" : ".") << M_MEMBER;
 }
 
+CExprPtr CMemberAccess::simplified() const
+{
+    auto expr = simplify(M_EXPR);
+    if (expr == M_EXPR) return nullptr;
+    return make_shared<CMemberAccess>(move(expr), M_MEMBER, M_INVERSE);
+}
+
+CExprPtr CMemberAccess::inverted_by(string const& _func) const
+{
+    // Pointers are dereferenced by the access, and are not recovered.
+    if (M_INVERSE.empty() || M_INVERSE != _func) return nullptr;
+    if (M_EXPR->is_pointer()) return nullptr;
+    return M_EXPR;
+}
+
 CExprPtr CMemberAccess::expr() const
 {
-    return make_shared<CMemberAccess>(M_EXPR, M_MEMBER);
+    return make_shared<CMemberAccess>(M_EXPR, M_MEMBER, M_INVERSE);
+}
+
+// -------------------------------------------------------------------------- //
+
+CIndexAccess::CIndexAccess(CExprPtr _expr, CExprPtr _idx)
+ : M_EXPR(move(_expr)), M_IDX(move(_idx)) {}
+
+void CIndexAccess::print(ostream & _out) const
+{
+    _out << "(" << *M_EXPR << ")[" << *M_IDX << "]";
+}
+
+CExprPtr CIndexAccess::simplified() const
+{
+    auto expr = simplify(M_EXPR);
+    auto idx = simplify(M_IDX);
+    if (expr == M_EXPR && idx == M_IDX) return nullptr;
+    return make_shared<CIndexAccess>(move(expr), move(idx));
+}
+
+CExprPtr CIndexAccess::expr() const
+{
+    return make_shared<CIndexAccess>(M_EXPR, M_IDX);
 }
 
 // -------------------------------------------------------------------------- //
@@ -172,6 +440,24 @@ void CCast::print(ostream & _out) const
 
 bool CCast::is_pointer() const { return M_EXPR->is_pointer(); }
 
+CExprPtr CCast::simplified() const
+{
+    auto expr = simplify(M_EXPR);
+
+    // Decimal literals which fit are already of type int.
+    long long int val;
+    if (M_TYPE == "int" && as_literal(expr, val) && fits_int(val))
+    {
+        return expr;
+    }
+
+    auto inner = dynamic_cast<CCast const*>(expr.get());
+    if (inner && inner->M_TYPE == M_TYPE) return expr;
+
+    if (expr == M_EXPR) return nullptr;
+    return make_shared<CCast>(move(expr), M_TYPE);
+}
+
 // -------------------------------------------------------------------------- //
 
 CFuncCall::CFuncCall(string _name, CArgList _args, bool _rv_is_ref)
@@ -197,6 +483,31 @@ bool CFuncCall::is_pointer() const
     return M_RV_IS_REF;
 }
 
+CExprPtr CFuncCall::simplified() const
+{
+    bool changed = false;
+    CArgList args;
+    for (auto const& arg : M_ARGS)
+    {
+        args.push_back(simplify(arg));
+        changed = changed || (args.back() != arg);
+    }
+
+    // Removes calls which undo a member access, such as Init_T((x).v).
+    if (args.size() == 1)
+    {
+        auto access = dynamic_cast<CMemberAccess const*>(args.front().get());
+        if (access)
+        {
+            auto inverted = access->inverted_by(M_NAME);
+            if (inverted) return inverted;
+        }
+    }
+
+    if (!changed) return nullptr;
+    return make_shared<CFuncCall>(M_NAME, move(args), M_RV_IS_REF);
+}
+
 CStmtPtr CFuncCall::stmt()
 {
     return make_shared<CExprStmt>(make_shared<CFuncCall>(M_NAME, M_ARGS));
@@ -252,19 +563,69 @@ void CBlock::print_impl(ostream & _out) const
     _out << "}";
 }
 
+CStmtPtr CBlock::simplified() const
+{
+    auto stmts = simplified_stmts();
+    if (stmts == M_STMTS) return nullptr;
+    return make_shared<CBlock>(move(stmts));
+}
+
+CBlockList CBlock::simplified_stmts() const
+{
+    CBlockList stmts;
+    for (auto const& stmt : M_STMTS)
+    {
+        auto result = simplify(stmt);
+
+        // A nested block is only a scope if it declares variables.
+        auto block = dynamic_cast<CBlock const*>(result.get());
+        if (block)
+        {
+            bool has_decl = false;
+            for (auto const& inner : block->M_STMTS)
+            {
+                auto decl = dynamic_cast<CVarDecl const*>(inner.get());
+                has_decl = has_decl || (decl != nullptr);
+            }
+
+            if (!has_decl)
+            {
+                for (auto const& inner : block->M_STMTS)
+                {
+                    stmts.push_back(inner);
+                }
+                result = nullptr;
+            }
+        }
+
+        if (result) stmts.push_back(move(result));
+        if (!stmts.empty() && is_jump(stmts.back())) break;
+    }
+    return stmts;
+}
+
 // -------------------------------------------------------------------------- //
 
 CExprStmt::CExprStmt(CExprPtr _expr): M_EXPR(move(_expr)) {}
 
 void CExprStmt::print_impl(ostream & _out) const { _out << *M_EXPR; }
 
+CStmtPtr CExprStmt::simplified() const
+{
+    auto expr = simplify(M_EXPR);
+    if (expr == M_EXPR) return nullptr;
+    return make_shared<CExprStmt>(move(expr));
+}
+
 // -------------------------------------------------------------------------- //
 
-CVarDecl::CVarDecl(string _type, string _name, bool _ptr, CExprPtr _init)
- : M_TYPE(move(_type))
+CVarDecl::CVarDecl(
+    string _type, string _name, bool _ptr, CExprPtr _init, bool _lifted
+): M_TYPE(move(_type))
  , M_NAME(move(_name))
  , M_IS_PTR(_ptr)
- , M_INIT_VAL(move(_init)) {}
+ , M_INIT_VAL(move(_init))
+ , M_IS_LIFTED(_lifted) {}
 
 CVarDecl::CVarDecl(string _type, string _name, bool _ptr)
 : CVarDecl(move(_type), move(_name), _ptr, nullptr) {}
@@ -272,9 +633,20 @@ CVarDecl::CVarDecl(string _type, string _name, bool _ptr)
 CVarDecl::CVarDecl(string _type, string _name)
 : CVarDecl(move(_type), move(_name), false) {}
 
+CVarDecl::CVarDecl(string _type, string _name, vector<size_t> _dims)
+ : M_TYPE(move(_type))
+ , M_NAME(move(_name))
+ , M_IS_PTR(false)
+ , M_DIMS(move(_dims)) {}
+
 shared_ptr<CIdentifier> CVarDecl::id() const
 {
-    return make_shared<CIdentifier>(M_NAME, M_IS_PTR);
+    return make_shared<CIdentifier>(M_NAME, M_IS_PTR, M_IS_LIFTED);
+}
+
+string const& CVarDecl::name() const
+{
+    return M_NAME;
 }
 
 CExprPtr CVarDecl::expr() const
@@ -282,9 +654,21 @@ CExprPtr CVarDecl::expr() const
     return id();
 }
 
+CStmtPtr CVarDecl::simplified() const
+{
+    if (!M_INIT_VAL) return nullptr;
+
+    auto init = simplify(M_INIT_VAL);
+    if (init == M_INIT_VAL) return nullptr;
+    return make_shared<CVarDecl>(
+        M_TYPE, M_NAME, M_IS_PTR, move(init), M_IS_LIFTED
+    );
+}
+
 void CVarDecl::print_impl(ostream & _out) const
 {
     _out << M_TYPE << (M_IS_PTR ? "*" : " ") << M_NAME;
+    for (auto dim : M_DIMS) _out << "[" << dim << "]";
     if (M_INIT_VAL) _out << "=" << *M_INIT_VAL;
 }
 
@@ -304,6 +688,28 @@ void CIf::print_impl(ostream & _out) const
     if (M_FALSE_STMT) _out << "else " << *M_FALSE_STMT;
 }
 
+CStmtPtr CIf::simplified() const
+{
+    auto cond = simplify(M_COND);
+
+    long long int val;
+    if (as_literal(cond, val))
+    {
+        auto branch = (val ? M_TRUE_STMT : M_FALSE_STMT);
+        if (!branch) return make_shared<CBlock>(CBlockList{});
+        return simplify(branch);
+    }
+
+    auto true_stmt = simplify(M_TRUE_STMT);
+    auto false_stmt = simplify(M_FALSE_STMT);
+    bool const SAME_TRUE = (true_stmt == M_TRUE_STMT);
+    if (cond == M_COND && SAME_TRUE && false_stmt == M_FALSE_STMT)
+    {
+        return nullptr;
+    }
+    return make_shared<CIf>(move(cond), move(true_stmt), move(false_stmt));
+}
+
 // -------------------------------------------------------------------------- //
 
 CWhileLoop::CWhileLoop(CStmtPtr _body, CExprPtr _cond, bool _atleast_once)
@@ -312,6 +718,21 @@ CWhileLoop::CWhileLoop(CStmtPtr _body, CExprPtr _cond, bool _atleast_once)
     if (!_atleast_once) nest();
 }
 
+CStmtPtr CWhileLoop::simplified() const
+{
+    auto cond = simplify(M_COND);
+
+    long long int val;
+    if (!M_IS_DO_WHILE && as_literal(cond, val) && val == 0)
+    {
+        return make_shared<CBlock>(CBlockList{});
+    }
+
+    auto body = simplify(M_BODY);
+    if (cond == M_COND && body == M_BODY) return nullptr;
+    return make_shared<CWhileLoop>(move(body), move(cond), M_IS_DO_WHILE);
+}
+
 void CWhileLoop::print_impl(ostream & _out) const
 {
     if (M_IS_DO_WHILE)
@@ -338,6 +759,14 @@ CForLoop::CForLoop(
     if (M_LOOP) M_LOOP->nest();
 }
 
+CStmtPtr CForLoop::simplified() const
+{
+    auto cond = simplify(M_COND);
+    auto body = simplify(M_BODY);
+    if (cond == M_COND && body == M_BODY) return nullptr;
+    return make_shared<CForLoop>(M_INIT, move(cond), M_LOOP, move(body));
+}
+
 void CForLoop::print_impl(ostream & _out) const
 {
     _out << "for(";
@@ -354,9 +783,8 @@ void CForLoop::print_impl(ostream & _out) const
 CSwitch::CSwitch(CExprPtr _cond): CSwitch(_cond, {make_shared<CBreak>()}) {}
 
 CSwitch::CSwitch(CExprPtr _cond, CBlockList _default)
-: m_cond(_cond), m_default(move(_default))
+: M_COND(move(_cond)), m_default(move(_default))
 {
-    m_cond.nest();
     nest();
 }
 
@@ -367,9 +795,22 @@ void CSwitch::add_case(int64_t _val, CBlockList _body)
 
 size_t CSwitch::size() const { return m_cases.size(); }
 
+CStmtPtr CSwitch::simplified() const
+{
+    auto result = make_shared<CSwitch>(
+        simplify(M_COND), m_default.simplified_stmts()
+    );
+    for (auto const& switch_case : m_cases)
+    {
+        auto stmts = switch_case.second.simplified_stmts();
+        result->add_case(switch_case.first, move(stmts));
+    }
+    return result;
+}
+
 void CSwitch::print_impl(ostream & _out) const
 {
-    _out << "switch(" << m_cond << "){";
+    _out << "switch(" << *M_COND << "){";
     for (auto const switch_case : m_cases)
     {
         _out << "case " << switch_case.first << ":" << switch_case.second;
@@ -387,6 +828,15 @@ void CContinue::print_impl(ostream & _out) const { _out << "continue"; }
 
 CReturn::CReturn(CExprPtr _retval): m_retval(move(_retval)) {}
 
+CStmtPtr CReturn::simplified() const
+{
+    if (!m_retval) return nullptr;
+
+    auto retval = simplify(m_retval);
+    if (retval == m_retval) return nullptr;
+    return make_shared<CReturn>(move(retval));
+}
+
 void CReturn::print_impl(ostream & _out) const
 {
     _out << "return";
@@ -400,12 +850,36 @@ CFuncDef::CFuncDef(
     CParams _args,
     shared_ptr<CBlock> _body,
     CFuncDef::Modifier _mod
-): M_ID(move(_id)), M_ARGS(move(_args)), M_BODY(move(_body)), M_MOD(_mod)
+): M_ID(move(_id))
+ , M_ARGS(move(_args))
+ , M_BODY(move(_body))
+ , M_MOD(_mod)
 {
     M_ID->nest();
     for (auto arg : M_ARGS) arg->nest();
 }
 
+void CFuncDef::simplify_bodies(ostream & _os, bool _enable)
+{
+    _os.iword(simplify_index()) = (_enable ? 1 : 0);
+}
+
+bool CFuncDef::is_simplified(ostream & _os)
+{
+    return (_os.iword(simplify_index()) != 0);
+}
+
+int CFuncDef::simplify_index()
+{
+    static int const INDEX = ios_base::xalloc();
+    return INDEX;
+}
+
+shared_ptr<CBlock> CFuncDef::simplify_body(shared_ptr<CBlock> _body)
+{
+    return make_shared<CBlock>(_body->simplified_stmts());
+}
+
 void CFuncDef::print(ostream & _out) const
 {
     if (M_MOD == Modifier::INLINE)
@@ -432,7 +906,11 @@ void CFuncDef::print(ostream & _out) const
     }
     _out << ")";
 
-    if (M_BODY)
+    if (M_BODY && is_simplified(_out))
+    {
+        _out << *simplify_body(M_BODY);
+    }
+    else if (M_BODY)
     {
         _out << *M_BODY;
     }
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace dev
 {
@@ -82,6 +83,10 @@ public:
     ~CBinaryOp() = default;
 
     void print(std::ostream & _out) const override;
+    CExprPtr simplified() const override;
+
+    // Returns the operator.
+    std::string const& op() const;
 
     // Converts this standalone call into a statement.
     CStmtPtr stmt();
@@ -116,9 +121,18 @@ public:
     // Encodes one of (_expr)._member or (_expr)->_member, based on context.
     CMemberAccess(CExprPtr _expr, std::string _member);
 
+    // Similar to the above, except that _inverse names a single-argument
+    // function such that _inverse((_expr)._member) is equivalent to _expr.
+    CMemberAccess(CExprPtr _expr, std::string _member, std::string _inverse);
+
     ~CMemberAccess() = default;
 
     void print(std::ostream & _out) const override;
+    CExprPtr simplified() const override;
+
+    // If _func is the inverse of this access, then the accessed expression is
+    // returned. Otherwise, nullptr is returned.
+    CExprPtr inverted_by(std::string const& _func) const;
 
 protected:
     CExprPtr expr() const override;
@@ -126,6 +140,31 @@ protected:
 private:
     CExprPtr const M_EXPR;
     std::string const M_MEMBER;
+    std::string const M_INVERSE;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Represents an index into a C array.
+ */
+class CIndexAccess : public CExpr, public CData
+{
+public:
+    // Encodes (_expr)[_idx].
+    CIndexAccess(CExprPtr _expr, CExprPtr _idx);
+
+    ~CIndexAccess() = default;
+
+    void print(std::ostream & _out) const override;
+    CExprPtr simplified() const override;
+
+protected:
+    CExprPtr expr() const override;
+
+private:
+    CExprPtr const M_EXPR;
+    CExprPtr const M_IDX;
 };
 
 // -------------------------------------------------------------------------- //
@@ -138,20 +177,26 @@ class CIdentifier : public CExpr, public CData
 public:
     // Creates a CElement which generates an identifier equivalent to _name. As
     // AST scope analysis is not performed, _ptr declares if the referenced
-    // declaration corresponds to a pointer.
-    CIdentifier(std::string _name, bool _ptr);
+    // declaration corresponds to a pointer. If _lifted is set, then _name is a
+    // global which has been lifted into the model context, and the identifier
+    // resolves to its field, as `CONTEXT_PTR->_name`.
+    CIdentifier(std::string _name, bool _ptr, bool _lifted = false);
 
     ~CIdentifier() = default;
 
     void print(std::ostream & _out) const override;
     bool is_pointer() const override;
 
+    // The (thread-local) pointer to the context of the running model.
+    static std::string const CONTEXT_PTR;
+
 protected:
     CExprPtr expr() const override;
 
 private:
     std::string const M_NAME;
     bool const M_IS_PTR;
+    bool const M_IS_LIFTED;
 };
 
 // -------------------------------------------------------------------------- //
@@ -169,6 +214,9 @@ public:
 
     void print(std::ostream & _out) const override;
 
+    // Returns the value of this literal.
+    long long int value() const;
+
 private:
     long long int const M_VAL;
 };
@@ -209,6 +257,11 @@ public:
     virtual ~CUnaryOp() = default;
 
     void print(std::ostream & _out) const override;
+    CExprPtr simplified() const override;
+
+    // Returns the operator, and true if it is a prefix operator.
+    std::string const& op() const;
+    bool is_prefix() const;
 
     // Converts this standalone call into a statement.
     CStmtPtr stmt();
@@ -256,6 +309,7 @@ public:
 
     void print(std::ostream & _out) const override;
     bool is_pointer() const override;
+    CExprPtr simplified() const override;
 
     // Converts this standalone call into a statement.
     CStmtPtr stmt();
@@ -281,6 +335,7 @@ public:
 
     void print(std::ostream & _out) const override;
     bool is_pointer() const override;
+    CExprPtr simplified() const override;
 
 private:
     CExprPtr const M_EXPR;
@@ -302,6 +357,7 @@ public:
 
     void print(std::ostream & _out) const override;
     bool is_pointer() const override;
+    CExprPtr simplified() const override;
 
     // Converts this standalone call into a statement.
     CStmtPtr stmt();
@@ -362,6 +418,12 @@ public:
 
     ~CBlock() = default;
 
+    CStmtPtr simplified() const override;
+
+    // Returns the simplified statements of this block. Nested blocks without
+    // declarations are flattened, and statements after a jump are dropped.
+    CBlockList simplified_stmts() const;
+
 private:
     CBlockList const M_STMTS;
 
@@ -381,6 +443,8 @@ public:
 
     ~CExprStmt() = default;
 
+    CStmtPtr simplified() const override;
+
 private:
     CExprPtr const M_EXPR;
 
@@ -396,16 +460,33 @@ class CVarDecl : public CStmt, public CData
 {
 public:
     // Declares a variable of given base type and name. It may be set as a
-    // pointer, adding * to the declaration, and may take an initial value.
-    CVarDecl(std::string _type, std::string _name, bool _ptr, CExprPtr _init);
+    // pointer, adding * to the declaration, and may take an initial value. If
+    // _lifted is set, then each identifier of the variable is lifted (see
+    // CIdentifier).
+    CVarDecl(
+        std::string _type,
+        std::string _name,
+        bool _ptr,
+        CExprPtr _init,
+        bool _lifted = false
+    );
     CVarDecl(std::string _type, std::string _name, bool _ptr);
     CVarDecl(std::string _type, std::string _name);
 
+    // Declares a (multi-dimensional) array of given base type and name. Each
+    // dimension is listed in order of _dims.
+    CVarDecl(std::string _type, std::string _name, std::vector<size_t> _dims);
+
     ~CVarDecl() = default;
 
+    CStmtPtr simplified() const override;
+
     // Generates an identifier for this declaration.
     std::shared_ptr<CIdentifier> id() const;
 
+    // Returns the name of this declaration.
+    std::string const& name() const;
+
 protected:
     CExprPtr expr() const override;
 
@@ -414,6 +495,8 @@ private:
     std::string const M_NAME;
     bool const M_IS_PTR;
     CExprPtr const M_INIT_VAL;
+    std::vector<size_t> const M_DIMS;
+    bool const M_IS_LIFTED = false;
 
     void print_impl(std::ostream & _out) const override;
 };
@@ -432,6 +515,8 @@ public:
 
     ~CIf() = default;
 
+    CStmtPtr simplified() const override;
+
 private:
     CExprPtr const M_COND;
     CStmtPtr const M_TRUE_STMT;
@@ -454,6 +539,8 @@ public:
 
     ~CWhileLoop() = default;
 
+    CStmtPtr simplified() const override;
+
 private:
     CStmtPtr const M_BODY;
     CExprPtr const M_COND;
@@ -476,6 +563,9 @@ public:
 
     ~CForLoop() = default;
 
+    // The header statements are nested, and are not simplified.
+    CStmtPtr simplified() const override;
+
 private:
     CStmtPtr const M_INIT;
     CExprPtr const M_COND;
@@ -507,8 +597,10 @@ public:
 
     ~CSwitch() = default;
 
+    CStmtPtr simplified() const override;
+
 private:
-    CExprStmt m_cond;
+    CExprPtr const M_COND;
     CBlock m_default;
 
     std::map<int64_t, CBlock> m_cases;
@@ -555,6 +647,8 @@ public:
 
     ~CReturn() = default;
 
+    CStmtPtr simplified() const override;
+
 private:
     CExprPtr const m_retval;
 
@@ -582,7 +676,20 @@ public:
 
     void print(std::ostream & _out) const override;
 
+    // If _enable is set, then each function body printed to _os is first
+    // simplified (see CStmt::simplified).
+    static void simplify_bodies(std::ostream & _os, bool _enable);
+
+    // Returns true if function bodies printed to _os are simplified.
+    static bool is_simplified(std::ostream & _os);
+
 private:
+    // Returns the index of the simplification flag for each stream.
+    static int simplify_index();
+
+    // Returns the simplification of _body, as a block.
+    static std::shared_ptr<CBlock> simplify_body(std::shared_ptr<CBlock> _body);
+
     std::shared_ptr<CVarDecl> const M_ID;
     CParams const M_ARGS;
     std::shared_ptr<CBlock> const M_BODY;
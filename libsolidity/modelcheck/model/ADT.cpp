@@ -7,6 +7,7 @@
 #include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
 #include <libsolidity/modelcheck/analysis/VariableScope.h>
 #include <libsolidity/modelcheck/codegen/Details.h>
+#include <libsolidity/modelcheck/model/Array.h>
 #include <libsolidity/modelcheck/model/Mapping.h>
 #include <libsolidity/modelcheck/utils/Contract.h>
 #include <libsolidity/modelcheck/utils/General.h>
@@ -29,10 +30,12 @@ ADTConverter::ADTConverter(
     shared_ptr<AnalysisStack const> _stack,
     bool _add_sums,
     size_t _map_k,
-    bool _forward_declare
+    bool _forward_declare,
+    bool _array_maps
 ): M_ADD_SUMS(_add_sums)
  , M_MAP_K(_map_k)
  , M_FORWARD_DECLARE(_forward_declare)
+ , M_ARRAY_MAPS(_array_maps)
  , m_stack(_stack)
 {
 }
@@ -81,6 +84,12 @@ void ADTConverter::generate_contract(FlatContract const& _contract)
         generate_mapping(*mapping);
     }
 
+    // Arrays are encoded alongside mappings.
+    for (auto array : _contract.arrays())
+    {
+        generate_array(*array);
+    }
+
     // Finally, the contract is encoded.
     shared_ptr<CParams> fields;
     if (!M_FORWARD_DECLARE)
@@ -171,12 +180,24 @@ void ADTConverter::generate_structure(Structure const& _structure)
 void ADTConverter::generate_mapping(Mapping const& _mapping)
 {
     if (!m_built.insert(&_mapping).second) return;
-    MapGenerator mapgen(_mapping, M_ADD_SUMS, M_MAP_K, *m_stack->types());
+    MapGenerator mapgen(
+        _mapping, M_ADD_SUMS, M_MAP_K, *m_stack->types(), M_ARRAY_MAPS
+    );
     (*m_ostream) << mapgen.declare(M_FORWARD_DECLARE);
 }
 
 // -------------------------------------------------------------------------- //
 
+void ADTConverter::generate_array(ArrayTypeName const& _array)
+{
+    auto const NAME = m_stack->types()->get_name(_array);
+    if (!m_built_arrays.insert(NAME).second) return;
+    ArrayGenerator arrgen(_array, m_stack);
+    (*m_ostream) << arrgen.declare(M_FORWARD_DECLARE);
+}
+
+// -------------------------------------------------------------------------- //
+
 }
 }
 }
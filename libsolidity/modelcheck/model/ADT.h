@@ -1,6 +1,6 @@
 /**
- * Converter from Solidity contracts, structures and mappings into SmartACE C
- * structs.
+ * Converter from Solidity contracts, structures, mappings and arrays into
+ * SmartACE C structs.
  * 
  * @date 2019
  */
@@ -12,6 +12,7 @@
 #include <memory>
 #include <ostream>
 #include <set>
+#include <string>
 
 namespace dev
 {
@@ -35,12 +36,14 @@ class ADTConverter
 public:
     // Constructs a printer for all ADT's required by the ast's c model. The
 	// converter should provide translations for all typed ASTNodes. If forward
-	// declare is set, then the structure bodies are not generated.
+	// declare is set, then the structure bodies are not generated. If
+	// _array_maps is set, then mappings are backed by arrays.
     ADTConverter(
 		std::shared_ptr<AnalysisStack const> _stack,
 		bool _add_sums,
 		size_t _map_k,
-		bool _forward_declare
+		bool _forward_declare,
+		bool _array_maps = false
     );
 
     // Prints each ADT declaration once, in some order.
@@ -50,12 +53,16 @@ private:
 	bool const M_ADD_SUMS;
 	size_t const M_MAP_K;
 	bool const M_FORWARD_DECLARE;
+	bool const M_ARRAY_MAPS;
 
 	std::shared_ptr<AnalysisStack const> m_stack;
 
 	std::ostream* m_ostream = nullptr;
 
 	std::set<void const*> m_built;
+
+	// Arrays of the same name share a single declaration.
+	std::set<std::string> m_built_arrays;
 	
 	// Prints all dependencies of _contract, and then the contract itself.
 	void generate_contract(FlatContract const& _contract);
@@ -63,6 +70,9 @@ private:
 	// Prints _mapping.
 	void generate_mapping(Mapping const& _mapping);
 
+	// Prints _array.
+	void generate_array(ArrayTypeName const& _array);
+
 	// Prints all mapping dependencies of _structure, and then the structure
 	// itself.
 	void generate_structure(Structure const& _structure);
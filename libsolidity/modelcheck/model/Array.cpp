@@ -0,0 +1,122 @@
+#include <libsolidity/modelcheck/model/Array.h>
+
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
+#include <libsolidity/modelcheck/codegen/Literals.h>
+#include <libsolidity/modelcheck/utils/Function.h>
+#include <libsolidity/modelcheck/utils/LibVerify.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+IntegerType const ArrayGenerator::INDEX_TYPE(256);
+
+ArrayGenerator::ArrayGenerator(
+    ArrayTypeName const& _src, shared_ptr<AnalysisStack const> _stack
+): M_LEN(static_cast<size_t>(
+        dynamic_cast<ArrayType const&>(*_src.annotation().type).length()
+   ))
+ , M_NAME(_stack->types()->get_name(_src))
+ , M_TYPE(_stack->types()->get_type(_src))
+ , m_stack(_stack)
+ , M_CONVERTER(*_stack->types())
+ , M_SRC(_src)
+ , M_VAL_T(_stack->types()->get_type(_src.baseType()))
+ , M_TMP(make_shared<CVarDecl>(M_TYPE, "tmp", false))
+ , M_IDX(make_shared<CVarDecl>(
+        TypeAnalyzer::get_simple_ctype(INDEX_TYPE), "idx", false
+   ))
+{
+    if (M_LEN == 0)
+    {
+        throw runtime_error("Array requires at least one entry.");
+    }
+}
+
+string ArrayGenerator::index_name(string const& _name)
+{
+    return "Index_" + _name;
+}
+
+// -------------------------------------------------------------------------- //
+
+CStructDef ArrayGenerator::declare(bool _forward_declare) const
+{
+    shared_ptr<CParams> t;
+    if (!_forward_declare)
+    {
+        t = make_shared<CParams>();
+        t->push_back(make_shared<CVarDecl>(
+            M_VAL_T, "data", vector<size_t>{M_LEN}
+        ));
+    }
+    return CStructDef(M_NAME, move(t));
+}
+
+// -------------------------------------------------------------------------- //
+
+CFuncDef ArrayGenerator::declare_zero_initializer(bool _forward_declare) const
+{
+    shared_ptr<CBlock> body;
+    if (!_forward_declare)
+    {
+        auto init_val = M_CONVERTER.get_init_val(M_SRC.baseType());
+
+        auto id = make_shared<CIdentifier>("i", false);
+        auto data = make_shared<CIndexAccess>(M_TMP->access("data"), id);
+        auto len = make_shared<CIntLiteral>(M_LEN);
+        auto loop = make_shared<CForLoop>(
+            make_shared<CVarDecl>("uint64_t", "i", false, Literals::ZERO),
+            make_shared<CBinaryOp>(id, "<", move(len)),
+            make_shared<CUnaryOp>("++", id, true)->stmt(),
+            make_shared<CAssign>(move(data), move(init_val))->stmt()
+        );
+
+        body = make_shared<CBlock>(CBlockList{
+            M_TMP, move(loop), make_shared<CReturn>(M_TMP->id())
+        });
+    }
+
+    auto id = InitFunction(M_CONVERTER, M_SRC).default_id();
+    return CFuncDef(move(id), {}, move(body));
+}
+
+// -------------------------------------------------------------------------- //
+
+CFuncDef ArrayGenerator::declare_index(bool _forward_declare) const
+{
+    auto fid = make_shared<CVarDecl>("uint64_t", index_name(M_NAME));
+
+    shared_ptr<CBlock> body;
+    if (!_forward_declare)
+    {
+        auto const REQ_IDX = M_IDX->access("v");
+        auto len = make_shared<CIntLiteral>(M_LEN);
+        auto cond = make_shared<CBinaryOp>(REQ_IDX, "<", move(len));
+
+        CBlockList block;
+        LibVerify::add_require(
+            *m_stack, block, cond, "Array index out of bounds."
+        );
+        block.push_back(make_shared<CReturn>(
+            make_shared<CCast>(REQ_IDX, "uint64_t")
+        ));
+        body = make_shared<CBlock>(move(block));
+    }
+
+    return CFuncDef(move(fid), CParams{M_IDX}, move(body));
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
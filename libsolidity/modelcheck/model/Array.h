@@ -0,0 +1,77 @@
+/**
+ * Data and helper functions for generating fixed-length storage arrays. Each
+ * array is lowered to a C struct which wraps a contiguous C array, so that the
+ * array may be embedded within its contract, and may be copied by value.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/modelcheck/codegen/Details.h>
+
+#include <memory>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+class AnalysisStack;
+class TypeAnalyzer;
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Converts Solidity fixed-length arrays into SmartACE C structs and C
+ * functions.
+ */
+class ArrayGenerator
+{
+public:
+    // The type to which all indices are converted.
+    static IntegerType const INDEX_TYPE;
+
+    // Constructs a new array. The array models AST node _src. Its element type
+    // is converted using the types of _stack, along with the array itself.
+    ArrayGenerator(
+        ArrayTypeName const& _src, std::shared_ptr<AnalysisStack const> _stack
+    );
+
+    // Returns the name of the function which checks an index into array _name,
+    // and then returns the index as a C integer.
+    static std::string index_name(std::string const& _name);
+
+    // Declares all structures and functions used by an array.
+    CStructDef declare(bool _forward_declare) const;
+    CFuncDef declare_zero_initializer(bool _forward_declare) const;
+    CFuncDef declare_index(bool _forward_declare) const;
+
+private:
+    // The number of elements in the array.
+    size_t const M_LEN;
+    std::string const M_NAME;
+    std::string const M_TYPE;
+
+    // Allows types to be resolved, and requires to be labeled.
+    std::shared_ptr<AnalysisStack const> m_stack;
+    TypeAnalyzer const& M_CONVERTER;
+    ArrayTypeName const& M_SRC;
+
+    // Const type names to simplify generation.
+    std::string const M_VAL_T;
+
+    // Const members to simplify generation and facilitate reuse.
+    std::shared_ptr<CVarDecl> const M_TMP;
+    std::shared_ptr<CVarDecl> const M_IDX;
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
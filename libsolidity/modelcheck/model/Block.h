@@ -24,6 +24,8 @@ namespace modelcheck
 {
 
 class AnalysisStack;
+class LoopBounds;
+class MapAccessCache;
 
 // -------------------------------------------------------------------------- //
 
@@ -120,6 +122,25 @@ private:
 	// Generates the payment call.
 	static void add_value_handler(CBlockList & _block);
 
+	// Declares the temporaries of each slot opened before _stmt.
+	void open_slots(Statement const& _stmt, CBlockList & _stmts);
+
+	// Returns true if _loop is to be unrolled, and then sets _n to the number
+	// of iterations.
+	bool unroll(BreakableStatement const& _loop, size_t & _n) const;
+
+	// If _loop has an upper bound which is not exact, then a counter is
+	// returned, and _body is prefixed by an assumption that the counter does
+	// not exceed the bound. The counter must be declared before the loop.
+	// Otherwise, nullptr is returned.
+	std::shared_ptr<CVarDecl> bound_loop(
+		BreakableStatement const& _loop, CStmtPtr & _body
+	);
+
+	// Sets the substatement to _c_loop. If _counter is set, then it is declared
+	// before _c_loop.
+	void set_loop(CStmtPtr _c_loop, std::shared_ptr<CVarDecl> _counter);
+
 	// Expands an expression, _expr, into a statement. Assumes that _expr is
 	// already clean.
 	void expand_expr_into_stmt(Expression const& _expr);
@@ -140,6 +161,9 @@ private:
 
 	CStmtPtr m_substmt;
 	std::shared_ptr<CBlock> m_top_block;
+	std::shared_ptr<MapAccessCache const> m_map_cache;
+	std::shared_ptr<LoopBounds const> m_loop_bounds;
+	size_t m_loop_count = 0;
 
 	bool m_is_top_level = true;
 };
@@ -215,6 +239,21 @@ public:
 			size_t _i, std::shared_ptr<AnalysisStack const> _stack
 		) const;
 
+		// Generates the _i-th modifier for _func, as a layer of a fused chain.
+		// The placeholder of the modifier is replaced by _next, rather than a
+		// call to the next layer.
+		ModifierBlockConverter generate(
+			size_t _i,
+			std::shared_ptr<AnalysisStack const> _stack,
+			std::shared_ptr<CBlock> _next
+		) const;
+
+		// Returns true if the modifiers and body of _func may be fused into a
+		// single block. This requires that each modifier has one placeholder,
+		// as its final statement. Then each return (of a modifier or of the
+		// body) also returns from the chain, and no code is duplicated.
+		bool fusable() const;
+
 		// Returns the number of modifiers which were not filtered away.
 		size_t len() const;
 
@@ -246,18 +285,25 @@ private:
 	std::vector<ASTPointer<VariableDeclaration>> const& M_USER_PARAMS;
 	std::vector<ASTPointer<Expression>> const* M_USER_ARGS;
 	std::string const M_NEXT_CALL;
+	std::shared_ptr<CBlock> const M_NEXT_BLOCK;
+
+	// If false, this is an inner layer of a fused chain, and the return value
+	// is owned by the outermost layer.
+	bool const M_OWNS_RV;
 
 	VariableScopeResolver m_shadow_decls;
 	std::shared_ptr<CVarDecl> m_rv = nullptr;
 
 	// Internal constructor implementation. Expects _i be expanded to modifier.
+	// If _next_block is set, then the placeholder expands to _next_block.
 	ModifierBlockConverter(
 		FunctionDefinition const& _func,
 		ModifierDefinition const* _def,
 		ModifierInvocation const* _curr,
 		std::shared_ptr<AnalysisStack const> _stack,
 		std::string _next,
-		bool _entry
+		bool _entry,
+		std::shared_ptr<CBlock> _next_block = nullptr
 	);
 };
 
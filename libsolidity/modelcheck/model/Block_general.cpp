@@ -4,6 +4,8 @@
 #include <libsolidity/modelcheck/analysis/AllocationSites.h>
 #include <libsolidity/modelcheck/analysis/CallState.h>
 #include <libsolidity/modelcheck/analysis/FunctionCall.h>
+#include <libsolidity/modelcheck/analysis/LoopBounds.h>
+#include <libsolidity/modelcheck/analysis/MapAccessCache.h>
 #include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
 #include <libsolidity/modelcheck/model/Expression.h>
@@ -11,6 +13,7 @@
 #include <libsolidity/modelcheck/utils/Contract.h>
 #include <libsolidity/modelcheck/utils/Function.h>
 #include <libsolidity/modelcheck/utils/General.h>
+#include <libsolidity/modelcheck/utils/LibVerify.h>
 #include <libsolidity/modelcheck/utils/Types.h>
 
 #include <algorithm>
@@ -54,6 +57,17 @@ GeneralBlockConverter::~GeneralBlockConverter() = default;
 shared_ptr<CBlock> GeneralBlockConverter::convert()
 {
 	m_top_block = nullptr;
+	m_map_cache = nullptr;
+	if (m_stack->settings().cache_map_reads)
+	{
+		m_map_cache = make_shared<MapAccessCache>(M_BODY);
+	}
+	m_loop_bounds = nullptr;
+	m_loop_count = 0;
+	if (m_stack->settings().bound_loops)
+	{
+		m_loop_bounds = make_shared<LoopBounds>(M_BODY);
+	}
 	M_BODY.accept(*this);
 	return m_top_block;
 }
@@ -70,7 +84,9 @@ void GeneralBlockConverter::set_for(FunctionSpecialization const& _for)
 CExprPtr GeneralBlockConverter::expand(Expression const& _expr, bool _ref)
 {
 	bool const INITS = block_type() == BlockType::Initializer;
-	return ExpressionConverter(_expr, m_stack, m_decls, _ref, INITS).convert();
+	ExpressionConverter converter(_expr, m_stack, m_decls, _ref, INITS);
+	converter.set_map_cache(m_map_cache.get());
+	return converter.convert();
 }
 
 // -------------------------------------------------------------------------- //
@@ -114,6 +130,7 @@ bool GeneralBlockConverter::visit(Block const& _node)
 	// Converts each block statement.
 	for (auto const& stmt : _node.statements())
 	{
+		open_slots(*stmt, stmts);
 		stmt->accept(*this);
 		stmts.push_back(last_substmt());
 	}
@@ -155,10 +172,20 @@ bool GeneralBlockConverter::visit(IfStatement const& _node)
 bool GeneralBlockConverter::visit(WhileStatement const& _node)
 {
 	_node.body().accept(*this);
-	new_substmt<CWhileLoop>(
-		last_substmt(), expand(_node.condition()), _node.isDoWhile()
-	);
+	auto body = last_substmt();
 
+	// The step is part of the body, so an unrolled loop repeats the body.
+	size_t iterations;
+	if (unroll(_node, iterations))
+	{
+		new_substmt<CBlock>(CBlockList(iterations, body));
+		return false;
+	}
+
+	auto counter = bound_loop(_node, body);
+	set_loop(make_shared<CWhileLoop>(
+		body, expand(_node.condition()), _node.isDoWhile()
+	), move(counter));
 	return false;
 }
 
@@ -186,9 +213,27 @@ bool GeneralBlockConverter::visit(ForStatement const& _node)
 		loop = last_substmt();
 	}
 
-	// Assembles the for statement.
+	// Assembles the for statement. If the loop is unrolled, then the scope of
+	// the loop condition is retained by a block.
 	_node.body().accept(*this);
-	new_substmt<CForLoop>(init, cond, loop, last_substmt());
+	size_t iterations;
+	if (unroll(_node, iterations))
+	{
+		CBlockList stmts;
+		if (init) stmts.push_back(init);
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			stmts.push_back(last_substmt());
+			if (loop) stmts.push_back(loop);
+		}
+		new_substmt<CBlock>(move(stmts));
+	}
+	else
+	{
+		auto body = last_substmt();
+		auto counter = bound_loop(_node, body);
+		set_loop(make_shared<CForLoop>(init, cond, loop, body), move(counter));
+	}
 
 	// Exits the scope and backtracks.
 	m_decls.exit();
@@ -331,6 +376,85 @@ void GeneralBlockConverter::add_value_handler(CBlockList & _block)
 
 // -------------------------------------------------------------------------- //
 
+bool GeneralBlockConverter::unroll(
+	BreakableStatement const& _loop, size_t & _n
+) const
+{
+	LoopBounds::Bound bound;
+	if (!m_loop_bounds || !m_loop_bounds->find(_loop, bound)) return false;
+	if (!bound.exact) return false;
+	if (bound.iterations > m_stack->settings().unroll_limit) return false;
+	_n = bound.iterations;
+	return true;
+}
+
+shared_ptr<CVarDecl> GeneralBlockConverter::bound_loop(
+	BreakableStatement const& _loop, CStmtPtr & _body
+)
+{
+	// An exact loop is already bounded by its condition. The counter is updated
+	// on entry to the body, so that it is never skipped by a continue.
+	LoopBounds::Bound bound;
+	if (!m_loop_bounds || !m_loop_bounds->find(_loop, bound)) return nullptr;
+	if (bound.exact || bound.iterations == 0) return nullptr;
+
+	auto const NAME = "loop_" + to_string(m_loop_count++);
+	auto counter = make_shared<CVarDecl>(
+		"uint64_t", NAME, false, Literals::ZERO
+	);
+	auto const ID = counter->id();
+
+	auto const BOUND = make_shared<CIntLiteral>(
+		static_cast<long long int>(bound.iterations)
+	);
+	auto const IN_BOUND = make_shared<CBinaryOp>(ID, "<=", BOUND);
+
+	CBlockList stmts{ make_shared<CUnaryOp>("++", ID, true)->stmt() };
+	LibVerify::add_assume(*m_stack, stmts, IN_BOUND);
+	stmts.push_back(move(_body));
+
+	_body = make_shared<CBlock>(move(stmts));
+	return counter;
+}
+
+void GeneralBlockConverter::set_loop(
+	CStmtPtr _c_loop, shared_ptr<CVarDecl> _counter
+)
+{
+	if (_counter)
+	{
+		new_substmt<CBlock>(CBlockList{move(_counter), move(_c_loop)});
+	}
+	else
+	{
+		m_substmt = move(_c_loop);
+	}
+}
+
+void GeneralBlockConverter::open_slots(
+	Statement const& _stmt, CBlockList & _stmts
+)
+{
+	if (!m_map_cache) return;
+
+	for (auto const& slot : m_map_cache->opens(_stmt))
+	{
+		CExprPtr init = nullptr;
+		if (slot.load)
+		{
+			init = ExpressionConverter(
+				*slot.access, m_stack, m_decls
+			).convert_map_read();
+		}
+
+		auto const TYPE = m_stack->types()->get_type(*slot.access);
+		auto const NAME = MapAccessCache::name(slot.id);
+		_stmts.push_back(make_shared<CVarDecl>(TYPE, NAME, false, init));
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
 void GeneralBlockConverter::expand_expr_into_stmt(Expression const& _expr)
 {
 	// This could be an assignment, which is special-cased on tuples.
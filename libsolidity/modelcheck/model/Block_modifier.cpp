@@ -21,6 +21,29 @@ namespace modelcheck
 
 // -------------------------------------------------------------------------- //
 
+namespace
+{
+// Counts the placeholder statements of a modifier.
+class PlaceholderCounter : public ASTConstVisitor
+{
+public:
+    size_t count(ModifierDefinition const& _def)
+    {
+        m_count = 0;
+        _def.body().accept(*this);
+        return m_count;
+    }
+
+protected:
+    void endVisit(PlaceholderStatement const&) override { ++m_count; }
+
+private:
+    size_t m_count;
+};
+}
+
+// -------------------------------------------------------------------------- //
+
 ModifierBlockConverter::ModifierBlockConverter::Factory::Factory(
     shared_ptr<AnalysisStack const> _stack,
     FunctionSpecialization const& _spec
@@ -68,6 +91,51 @@ ModifierBlockConverter ModifierBlockConverter::Factory::generate(
     );
 }
 
+ModifierBlockConverter ModifierBlockConverter::Factory::generate(
+    size_t _i, shared_ptr<AnalysisStack const> _stack, shared_ptr<CBlock> _next
+) const
+{
+    if (len() < _i)
+    {
+        throw runtime_error("FunctionDefinition of unknown i.");
+    }
+    else if (!_next)
+    {
+        throw runtime_error("Fused modifier requires an inner block.");
+    }
+
+    auto const& def_invoke_pair = m_filtered_mods[_i];
+    return ModifierBlockConverter(
+        M_SPEC.func(),
+        def_invoke_pair.first,
+        def_invoke_pair.second,
+        _stack,
+        M_SPEC.name(_i + 1),
+        _i == 0,
+        move(_next)
+    );
+}
+
+// -------------------------------------------------------------------------- //
+
+bool ModifierBlockConverter::Factory::fusable() const
+{
+    PlaceholderCounter counter;
+    for (auto const& def_invoke_pair : m_filtered_mods)
+    {
+        auto const& DEF = *def_invoke_pair.first;
+        auto const& STMTS = DEF.body().statements();
+
+        if (STMTS.empty()) return false;
+        if (!dynamic_cast<PlaceholderStatement const*>(STMTS.back().get()))
+        {
+            return false;
+        }
+        if (counter.count(DEF) != 1) return false;
+    }
+    return true;
+}
+
 // --------------------------------------------------------------------------
 
 size_t ModifierBlockConverter::Factory::len() const
@@ -90,7 +158,8 @@ ModifierBlockConverter::ModifierBlockConverter(
     ModifierInvocation const* _curr,
     shared_ptr<AnalysisStack const> _stack,
     string _next,
-    bool _entry
+    bool _entry,
+    shared_ptr<CBlock> _next_block
 ): GeneralBlockConverter(
     _def->parameters(),
     _func.returnParameters(),
@@ -103,6 +172,8 @@ ModifierBlockConverter::ModifierBlockConverter(
  , M_USER_PARAMS(_def->parameters())
  , M_USER_ARGS(_curr->arguments())
  , M_NEXT_CALL(move(_next))
+ , M_NEXT_BLOCK(move(_next_block))
+ , M_OWNS_RV(_entry || !M_NEXT_BLOCK)
  , m_shadow_decls(CodeType::SHADOWBLOCK)
 {
 	if (has_retval())
@@ -132,7 +203,7 @@ void ModifierBlockConverter::enter(
     CBlockList & _stmts, VariableScopeResolver &_decls
 )
 {
-    if (m_rv)
+    if (m_rv && M_OWNS_RV)
     {
 		_stmts.push_back(m_rv);
     }
@@ -162,7 +233,7 @@ void ModifierBlockConverter::enter(
 
 void ModifierBlockConverter::exit(CBlockList & _stmts, VariableScopeResolver &)
 {
-    if (m_rv)
+    if (m_rv && M_OWNS_RV)
     {
         _stmts.push_back(make_shared<CReturn>(m_rv->id()));
     }
@@ -185,6 +256,12 @@ bool ModifierBlockConverter::visit(Return const&)
 
 void ModifierBlockConverter::endVisit(PlaceholderStatement const&)
 {
+    if (M_NEXT_BLOCK)
+    {
+        new_substmt<CBlock>(*M_NEXT_BLOCK);
+        return;
+    }
+
 	CFuncCallBuilder builder(M_NEXT_CALL);
 	builder.push(make_shared<CIdentifier>("self", true));
 	m_stack->environment()->compute_next_state_for(
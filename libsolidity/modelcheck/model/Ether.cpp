@@ -82,7 +82,7 @@ void EtherMethodGenerator::generate_pay(
         string error_msg("Insufficient funds to call.");
 
         CBlockList statements;
-        LibVerify::add_require(statements, cond, error_msg);
+        LibVerify::add_require(*m_stack, statements, cond, error_msg);
         statements.push_back(update->stmt());
         statements.push_back(make_shared<CReturn>(AMT_VAR->id()));
         body = make_shared<CBlock>(move(statements));
@@ -173,7 +173,9 @@ void EtherMethodGenerator::generate_transfer(
         send_call.push(AMT_VAR->id());
 
         CBlockList statements;
-        LibVerify::add_require(statements, send_call.merge_and_pop(), err_msg);
+        LibVerify::add_require(
+            *m_stack, statements, send_call.merge_and_pop(), err_msg
+        );
         body = make_shared<CBlock>(move(statements));
     }
 
@@ -214,8 +216,10 @@ void EtherMethodGenerator::generate_fallbacks(
         {
             if (contract->can_fallback_through_send())
             {
+                // At the root, the contract is a global of the model.
                 string name = "contract_" + to_string(contract->address());
-                CExprPtr id = make_shared<CIdentifier>(name, !_root);
+                bool const LIFTED = _root && m_stack->settings().reentrant;
+                CExprPtr id = make_shared<CIdentifier>(name, !_root, LIFTED);
                 if (_root)
                 {
                     id = make_shared<CReference>(id);
@@ -5,10 +5,13 @@
 #include <libsolidity/modelcheck/analysis/ContractRvAnalysis.h>
 #include <libsolidity/modelcheck/analysis/FunctionCall.h>
 #include <libsolidity/modelcheck/analysis/Inheritance.h>
+#include <libsolidity/modelcheck/analysis/Library.h>
+#include <libsolidity/modelcheck/analysis/MapAccessCache.h>
 #include <libsolidity/modelcheck/analysis/StringLookup.h>
 #include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
 #include <libsolidity/modelcheck/analysis/VariableScope.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
+#include <libsolidity/modelcheck/model/Array.h>
 #include <libsolidity/modelcheck/utils/AST.h>
 #include <libsolidity/modelcheck/utils/AbstractAddressDomain.h>
 #include <libsolidity/modelcheck/utils/CallState.h>
@@ -19,6 +22,7 @@
 #include <libsolidity/modelcheck/utils/LibVerify.h>
 #include <libsolidity/modelcheck/utils/Types.h>
 
+#include <limits>
 #include <stdexcept>
 
 using namespace std;
@@ -32,6 +36,8 @@ namespace modelcheck
 
 // -------------------------------------------------------------------------- //
 
+// -------------------------------------------------------------------------- //
+
 ExpressionConverter::ExpressionConverter(
 	Expression const& _expr,
 	std::shared_ptr<AnalysisStack const> _stack,
@@ -65,6 +71,29 @@ void ExpressionConverter::set_aux_rvs(std::vector<CExprPtr> _rvs)
 
 // -------------------------------------------------------------------------- //
 
+void ExpressionConverter::set_map_cache(MapAccessCache const* _cache)
+{
+	m_map_cache = _cache;
+}
+
+// -------------------------------------------------------------------------- //
+
+CExprPtr ExpressionConverter::convert_map_read()
+{
+	auto const* ACCESS = dynamic_cast<IndexAccess const*>(M_EXPR);
+	if (!ACCESS)
+	{
+		throw runtime_error("Map read expected an index access.");
+	}
+
+	FlatIndex idx(*ACCESS);
+	auto record = m_stack->types()->map_db().resolve(idx.decl());
+	generate_mapping_call("Read", *record, idx, nullptr);
+	return m_subexpr;
+}
+
+// -------------------------------------------------------------------------- //
+
 bool ExpressionConverter::visit(Conditional const& _node)
 {
 	_node.condition().accept(*this);
@@ -102,7 +131,8 @@ bool ExpressionConverter::visit(Assignment const& _node)
 			generate_binary_op(
 				_node.leftHandSide(),
 				TokenTraits::AssignmentToBinaryOp(_node.assignmentOperator()),
-				_node.rightHandSide()
+				_node.rightHandSide(),
+				_node.leftHandSide().annotation().type
 			);
 		}
 		else
@@ -115,12 +145,24 @@ bool ExpressionConverter::visit(Assignment const& _node)
 	// Equals LHS to RHS.
 	{
 		ScopedSwap<bool> swap(m_lval, true);
-		if (auto map = LValueSniffer<IndexAccess>(_node.leftHandSide()).find())
+		// Array entries are written directly, as lvalues.
+		auto map = LValueSniffer<IndexAccess>(_node.leftHandSide()).find();
+		if (map && map->baseExpression().annotation().type->category()
+		           == Type::Category::Mapping)
 		{
 			// TODO: "Write" should not be hard-coded.
 			FlatIndex idx(*map);
 			auto record = m_stack->types()->map_db().resolve(idx.decl());
-			generate_mapping_call("Write", *record, move(idx), move(rhs));
+
+			size_t slot_id;
+			CExprPtr slot = nullptr;
+			if (m_map_cache && m_map_cache->writes_slot(*map, slot_id))
+			{
+				auto const NAME = MapAccessCache::name(slot_id);
+				slot = make_shared<CIdentifier>(NAME, false);
+			}
+
+			generate_mapping_call("Write", *record, move(idx), move(rhs), slot);
 		}
 		else
 		{
@@ -173,7 +215,21 @@ bool ExpressionConverter::visit(BinaryOperation const& _node)
 {
 	auto const& LHS = _node.leftExpression();
 	auto const& RHS = _node.rightExpression();
-	generate_binary_op(LHS, _node.getOperator(), RHS);
+	auto const OP = _node.getOperator();
+
+	// Literal operations are folded if they would otherwise require intrinsics,
+	// or if their operands exceed 256 bits (as in `10**100 / 10**90`).
+	bigint val, tmp;
+	bool fold = (OP == Token::Exp || OP == Token::SAR || OP == Token::SHR);
+	fold = fold || !constant_value(LHS, tmp) || !constant_value(RHS, tmp);
+	if (fold && constant_value(_node, val) && fits_literal(val))
+	{
+		m_subexpr = make_shared<CIntLiteral>(static_cast<long long int>(val));
+		return false;
+	}
+
+	auto const* TYPE = _node.annotation().commonType;
+	generate_binary_op(LHS, OP, RHS, TYPE);
 	return false;
 }
 
@@ -214,6 +270,7 @@ bool ExpressionConverter::visit(MemberAccess const& _node)
 	case Type::Category::Array:
 	case Type::Category::FixedBytes:
 		print_array_member(_node.expression(), _node.memberName());
+		auto_unwrapped = true;
 		break;
 	case Type::Category::Contract:
 	case Type::Category::Struct:
@@ -234,9 +291,10 @@ bool ExpressionConverter::visit(MemberAccess const& _node)
 	{
 		m_subexpr = make_shared<CReference>(move(m_subexpr));
 	}
-	else if (is_wrapped_type(*_node.annotation().type) && !auto_unwrapped)
+	else if (!auto_unwrapped)
 	{
-		m_subexpr = make_shared<CMemberAccess>(move(m_subexpr), "v");
+		auto const& TYPE = *_node.annotation().type;
+		m_subexpr = InitFunction::unwrap(TYPE, move(m_subexpr));
 	}
 
 	return false;
@@ -260,12 +318,52 @@ bool ExpressionConverter::visit(IndexAccess const& _node)
 				throw runtime_error("Map references unsupported.");
 			}
 
-			// TODO: "Read" should not be hard-coded.
-			generate_mapping_call("Read", *record, idx, nullptr);
+			size_t slot_id;
+			if (m_map_cache && m_map_cache->reads_slot(_node, slot_id))
+			{
+				auto const NAME = MapAccessCache::name(slot_id);
+				m_subexpr = make_shared<CIdentifier>(NAME, false);
+			}
+			else
+			{
+				// TODO: "Read" should not be hard-coded.
+				generate_mapping_call("Read", *record, idx, nullptr);
+			}
+
+			auto const& TYPE = *_node.annotation().type;
+			m_subexpr = InitFunction::unwrap(TYPE, move(m_subexpr));
+		}
+		break;
+	case Type::Category::Array:
+		{
+			// Each index is checked, and then used to access the data directly.
+			ScopedSwap<bool> find_ref(m_find_ref, false);
+
+			auto const& BASE = _node.baseExpression();
+			auto const& NAME = m_stack->types()->get_name(BASE);
+			CFuncCallBuilder index(ArrayGenerator::index_name(NAME));
+			index.push(
+				*_node.indexExpression(),
+				m_stack,
+				M_DECLS,
+				false,
+				&ArrayGenerator::INDEX_TYPE
+			);
+
+			BASE.accept(*this);
+			m_subexpr = make_shared<CIndexAccess>(
+				make_shared<CMemberAccess>(move(m_subexpr), "data"),
+				index.merge_and_pop()
+			);
 
-			if (is_wrapped_type(*_node.annotation().type))
+			if (find_ref.old())
+			{
+				m_subexpr = make_shared<CReference>(move(m_subexpr));
+			}
+			else
 			{
-				m_subexpr = make_shared<CMemberAccess>(move(m_subexpr), "v");
+				auto const& TYPE = *_node.annotation().type;
+				m_subexpr = InitFunction::unwrap(TYPE, move(m_subexpr));
 			}
 		}
 		break;
@@ -307,9 +405,10 @@ bool ExpressionConverter::visit(Identifier const& _node)
 		{
 			m_subexpr = make_shared<CReference>(move(m_subexpr));
 		}
-		else if (is_wrapped_type(*_node.annotation().type))
+		else
 		{
-			m_subexpr = make_shared<CMemberAccess>(move(m_subexpr), "v");
+			auto const& TYPE = *_node.annotation().type;
+			m_subexpr = InitFunction::unwrap(TYPE, move(m_subexpr));
 		}
 	}
 
@@ -331,7 +430,8 @@ bool ExpressionConverter::visit(Literal const& _node)
 		{
 			auto lit = _node.annotation().type->literalValue(&_node);
 			auto const& lit_name = AbstractAddressDomain::literal_name(lit);
-			m_subexpr = make_shared<CIdentifier>(lit_name, false);
+			bool const LIFTED = m_stack->settings().reentrant;
+			m_subexpr = make_shared<CIdentifier>(lit_name, false, LIFTED);
 		}
 		else
 		{
@@ -381,28 +481,169 @@ long long int ExpressionConverter::literal_to_number(Literal const& _node)
 
 // -------------------------------------------------------------------------- //
 
+bool ExpressionConverter::constant_value(Expression const& _expr, bigint & _val)
+{
+	if (auto rat = dynamic_cast<RationalNumberType const*>(
+		_expr.annotation().type
+	))
+	{
+		if (rat->isFractional() || !rat->integerType()) return false;
+		auto const LIT = rat->literalValue(nullptr);
+		_val = rat->isNegative() ? bigint(u2s(LIT)) : bigint(LIT);
+		return true;
+	}
+	else if (auto id = dynamic_cast<Identifier const*>(&_expr))
+	{
+		auto decl = dynamic_cast<VariableDeclaration const*>(
+			id->annotation().referencedDeclaration
+		);
+		if (id->annotation().isConstant && decl && decl->value())
+		{
+			return constant_value(*decl->value(), _val);
+		}
+	}
+	else if (auto call = dynamic_cast<FunctionCall const*>(&_expr))
+	{
+		// Integer conversions are only folded when the value is preserved.
+		auto const KIND = call->annotation().kind;
+		auto type = dynamic_cast<IntegerType const*>(call->annotation().type);
+		if (KIND == FunctionCallKind::TypeConversion && type
+		    && call->arguments().size() == 1
+		    && constant_value(*call->arguments()[0], _val))
+		{
+			return (_val >= type->minValue() && _val <= type->maxValue());
+		}
+	}
+	return false;
+}
+
+bool ExpressionConverter::fits_literal(bigint const& _val)
+{
+	return (_val >= numeric_limits<long long int>::min())
+	    && (_val <= numeric_limits<long long int>::max());
+}
+
 void ExpressionConverter::generate_binary_op(
-	Expression const& _lhs, Token _op, Expression const& _rhs
+	Expression const& _lhs,
+	Token _op,
+	Expression const& _rhs,
+	Type const* _type
 )
 {
+	string const OP = TokenTraits::friendlyName(_op);
+	if (_op == Token::SAR || _op == Token::SHR || _op == Token::Exp)
+	{
+		if (!_type)
+		{
+			throw runtime_error("Untyped binary operator:" + OP);
+		}
+		generate_intrinsic_op(_lhs, _op, _rhs, *_type);
+		return;
+	}
+
 	_lhs.accept(*this);
 	auto subexpr_1 = m_subexpr;
 	_rhs.accept(*this);
 
-	string const OP = TokenTraits::friendlyName(_op);
-	if (_op == Token::SAR || _op == Token::SHR || _op == Token::Exp)
+	m_subexpr = make_shared<CBinaryOp>(move(subexpr_1), OP, move(m_subexpr));
+}
+
+void ExpressionConverter::generate_intrinsic_op(
+	Expression const& _lhs,
+	Token _op,
+	Expression const& _rhs,
+	Type const& _type
+)
+{
+	// Literal operations are typed by their exact result.
+	if (auto rat = dynamic_cast<RationalNumberType const*>(&_type))
 	{
-		throw runtime_error("Unsupported binary operator:" + OP);
+		if (rat->isFractional() || !rat->integerType())
+		{
+			throw runtime_error("Constant is not a 256-bit integer.");
+		}
 	}
 
-	m_subexpr = make_shared<CBinaryOp>(move(subexpr_1), OP, move(m_subexpr));
+	bool const IS_SIGNED = simple_is_signed(_type);
+	if (_op == Token::Exp && IS_SIGNED)
+	{
+		throw runtime_error("Signed exponentiation not yet supported.");
+	}
+	else if (_op == Token::SHR && IS_SIGNED)
+	{
+		throw runtime_error("Logical shift of signed values not supported.");
+	}
+
+	// Folds the operation if the right operand is constant.
+	bigint lhs, rhs;
+	if (constant_value(_rhs, rhs) && rhs >= 0)
+	{
+		int const BITS = simple_bit_count(_type);
+		if (constant_value(_lhs, lhs))
+		{
+			bigint res;
+			if (_op == Token::Exp)
+			{
+				bigint const MOD = bigint(1) << BITS;
+				res = boost::multiprecision::powm(lhs % MOD, rhs, MOD);
+			}
+			else if (rhs >= BITS)
+			{
+				res = (lhs < 0) ? -1 : 0;
+			}
+			else
+			{
+				res = lhs >> static_cast<unsigned>(rhs);
+			}
+
+			if (fits_literal(res))
+			{
+				m_subexpr = make_shared<CIntLiteral>(
+					static_cast<long long int>(res)
+				);
+				return;
+			}
+		}
+		else if (_op == Token::Exp && rhs == 1)
+		{
+			_lhs.accept(*this);
+			return;
+		}
+		else if (_op != Token::Exp && rhs < min(BITS, 64))
+		{
+			// The shift is within the width of all integer models.
+			_lhs.accept(*this);
+			m_subexpr = make_shared<CBinaryOp>(
+				move(m_subexpr),
+				">>",
+				make_shared<CIntLiteral>(static_cast<long long int>(rhs))
+			);
+			return;
+		}
+	}
+
+	_lhs.accept(*this);
+	auto subexpr_1 = m_subexpr;
+	_rhs.accept(*this);
+
+	if (_op == Token::Exp)
+	{
+		m_subexpr = LibVerify::exp(_type, move(subexpr_1), move(m_subexpr));
+	}
+	else
+	{
+		m_subexpr = LibVerify::shift_right(
+			_type, move(subexpr_1), move(m_subexpr)
+		);
+	}
 }
 
 void ExpressionConverter::generate_mapping_call(
 	string const& _op,
 	MapDeflate::FlatMap const& _map,
 	FlatIndex const& _idx,
-	CExprPtr _v
+	CExprPtr _v,
+	CExprPtr _slot
 )
 {
 	// The type of baseExpression is an array, so it is not a wrapped type.
@@ -430,7 +671,16 @@ void ExpressionConverter::generate_mapping_call(
 	// Pushes write value if provided.
 	if (_v)
 	{
-		mapcall.push(move(_v), _map.value_type->annotation().type);
+		auto const* TYPE = _map.value_type->annotation().type;
+		if (_slot)
+		{
+			_v = InitFunction::wrap(*TYPE, move(_v));
+			mapcall.push(make_shared<CAssign>(move(_slot), move(_v)));
+		}
+		else
+		{
+			mapcall.push(move(_v), TYPE);
+		}
 	}
 	m_subexpr = mapcall.merge_and_pop();
 }
@@ -662,7 +912,7 @@ void ExpressionConverter::print_function(FunctionCall const& _call)
 	}
 	else if (group == FunctionCallAnalyzer::CallGroup::Crypto)
 	{
-		m_subexpr = make_shared<CFuncCall>("sol_crypto", CArgList{});
+		print_crypto(_call);
 	}
 	else if (group == FunctionCallAnalyzer::CallGroup::Destruct)
 	{
@@ -734,6 +984,20 @@ void ExpressionConverter::print_method(FunctionCallAnalyzer const& _calldata)
 		return;
 	}
 
+	// Special case for SafeMath operations. If requires may escalate, then the
+	// library method is called, so that its requires are escalated as well.
+	bool const ESCALATES = m_stack->environment()->escalate_requires();
+	if (_calldata.is_in_library() && !ESCALATES)
+	{
+		auto const& DECL = _calldata.method_decl();
+		auto const OP = m_stack->libraries()->checked_op(DECL);
+		if (!OP.empty())
+		{
+			print_checked_op(OP, _calldata);
+			return;
+		}
+	}
+
 	// Determines call name and locality of call.
 	FunctionSpecialization call(_calldata.method_decl());
 	bool is_ext_call = (!_calldata.is_super() && _calldata.context());
@@ -828,10 +1092,30 @@ void ExpressionConverter::print_method(FunctionCallAnalyzer const& _calldata)
 	// Unwraps the return value, if it is a wrapped type.
 	if (rv_is_wrapped)
 	{
-		m_subexpr = make_shared<CMemberAccess>(move(m_subexpr), "v");
+		auto const& RV = *_calldata.type().returnParameterTypes()[0];
+		m_subexpr = InitFunction::unwrap(RV, move(m_subexpr));
 	}
 }
 
+void ExpressionConverter::print_checked_op(
+	string const& _op, FunctionCallAnalyzer const& _calldata
+)
+{
+	// A bound method takes its first operand from the context.
+	vector<Expression const*> operands;
+	if (_calldata.context()) operands.push_back(_calldata.context());
+	for (auto arg : _calldata.args()) operands.push_back(arg.get());
+
+	ScopedSwap<bool> swap(m_find_ref, false);
+	operands[0]->accept(*this);
+	auto lhs = m_subexpr;
+	operands[1]->accept(*this);
+
+	auto const& DECL = *_calldata.method_decl().parameters()[0];
+	auto const& TYPE = *DECL.annotation().type;
+	m_subexpr = LibVerify::checked(_op, TYPE, move(lhs), move(m_subexpr));
+}
+
 void ExpressionConverter::print_contract_ctor(FunctionCall const& _call)
 {
 	// Extracts contract definition.
@@ -879,6 +1163,100 @@ void ExpressionConverter::print_payment(FunctionCall const& _call, bool _nothrow
 	m_subexpr = fn.merge_and_pop();
 }
 
+void ExpressionConverter::print_crypto(FunctionCall const& _call)
+{
+	// The maximum input size, as set by SOL_KECCAK_CAPACITY in libverify.
+	size_t const CAPACITY = 256;
+
+	m_subexpr = make_shared<CFuncCall>("sol_crypto", CArgList{});
+	if (!m_stack->settings().native_crypto) return;
+	if (_call.arguments().size() != 1) return;
+
+	// Only keccak256(abi.encode(...)) and keccak256(abi.encodePacked(...)) are
+	// supported.
+	auto const& HASH_T = dynamic_cast<FunctionType const&>(
+		*_call.expression().annotation().type
+	);
+	if (HASH_T.kind() != FunctionType::Kind::KECCAK256) return;
+
+	auto const& ARG = ExpressionCleaner(*_call.arguments()[0]).clean();
+	auto const* ENCODE = dynamic_cast<FunctionCall const*>(&ARG);
+	if (!ENCODE) return;
+
+	auto const* ENCODE_T = dynamic_cast<FunctionType const*>(
+		ENCODE->expression().annotation().type
+	);
+	if (!ENCODE_T) return;
+
+	bool is_packed;
+	if (ENCODE_T->kind() == FunctionType::Kind::ABIEncodePacked)
+	{
+		is_packed = true;
+	}
+	else if (ENCODE_T->kind() == FunctionType::Kind::ABIEncode)
+	{
+		is_packed = false;
+	}
+	else
+	{
+		return;
+	}
+
+	// Each operand must be of a simple type, and must fit in the input.
+	size_t len = 0;
+	for (auto const& op : ENCODE->arguments())
+	{
+		auto const& TYPE = unwrap(*op->annotation().type);
+		switch (TYPE.category())
+		{
+		case Type::Category::Address:
+		case Type::Category::Bool:
+		case Type::Category::FixedBytes:
+		case Type::Category::Integer:
+		case Type::Category::RationalNumber:
+			break;
+		default:
+			return;
+		}
+		len += is_packed ? (simple_bit_count(TYPE) / 8) : 32;
+	}
+	if (len > CAPACITY) return;
+
+	// Each operand is padded to 32 bytes, unless the encoding is packed. Note
+	// that fixed-size byte arrays are padded on the right.
+	CExprPtr state = make_shared<CFuncCall>("SOL_KECCAK_INIT", CArgList{});
+	for (auto const& op : ENCODE->arguments())
+	{
+		auto const& TYPE = unwrap(*op->annotation().type);
+		bool const IS_BYTES = (TYPE.category() == Type::Category::FixedBytes);
+		int const BYTES = simple_bit_count(TYPE) / 8;
+		int const WIDTH = (is_packed || IS_BYTES) ? BYTES : 32;
+
+		op->accept(*this);
+		auto val = make_shared<CCast>(move(m_subexpr), "sol_raw_uint256_t");
+		state = make_shared<CFuncCall>("SOL_KECCAK_UPDATE", CArgList{
+			move(state),
+			move(val),
+			make_shared<CIntLiteral>(WIDTH),
+			simple_is_signed(TYPE) ? Literals::ONE : Literals::ZERO
+		});
+
+		if (WIDTH < 32 && !is_packed)
+		{
+			state = make_shared<CFuncCall>("SOL_KECCAK_UPDATE", CArgList{
+				move(state),
+				Literals::ZERO,
+				make_shared<CIntLiteral>(32 - WIDTH),
+				Literals::ZERO
+			});
+		}
+	}
+
+	m_subexpr = make_shared<CFuncCall>("SOL_KECCAK_FINAL", CArgList{
+		move(state)
+	});
+}
+
 void ExpressionConverter::print_call(FunctionCallAnalyzer const& _call)
 {
 	const AddressType ADR_TYPE(StateMutability::Payable);
@@ -916,7 +1294,7 @@ void ExpressionConverter::print_call(FunctionCallAnalyzer const& _call)
 
 void ExpressionConverter::print_require(CExprPtr _expr, string const& _msg)
 {
-	m_subexpr = LibVerify::make_require(_expr, _msg);
+	m_subexpr = LibVerify::make_require(*m_stack, _expr, _msg);
 	if (m_stack->environment()->escalate_requires())
 	{
 		auto param
@@ -948,6 +1326,7 @@ void ExpressionConverter::print_property(bool _fail, SolArgList const& _args)
 
 	// Generates assertion.
 	ExpressionConverter cond(*_args[0], m_stack, M_DECLS, false);
+	cond.set_map_cache(m_map_cache);
 	if (_fail)
 	{
 		m_subexpr = LibVerify::make_assert(cond.convert(), err_msg);
@@ -1019,8 +1398,16 @@ void ExpressionConverter::print_array_member(
 	if (_member == "length")
 	{
 		// TODO(scottwe): Decide on which "array features" should be allowed.
-		(void) _node;
-		throw runtime_error("Array-like lengths not yet supported.");
+		auto const* TYPE = dynamic_cast<ArrayType const*>(
+			_node.annotation().type
+		);
+		if (!TYPE || TYPE->isDynamicallySized())
+		{
+			throw runtime_error("Array-like lengths not yet supported.");
+		}
+
+		auto const LEN = static_cast<long long int>(TYPE->length());
+		m_subexpr = make_shared<CIntLiteral>(LEN);
 	}
 	else
 	{
@@ -24,6 +24,7 @@ namespace modelcheck
 class AnalysisStack;
 class CFuncCallBuilder;
 class FunctionCallAnalyzer;
+class MapAccessCache;
 class VariableScopeResolver;
 
 // -------------------------------------------------------------------------- //
@@ -55,6 +56,13 @@ public:
 	// Sets the auxilary rv's for the first tuple-valued function.
 	void set_aux_rvs(std::vector<CExprPtr> _rvs);
 
+	// Serves map accesses from the slots of _cache, where applicable.
+	void set_map_cache(MapAccessCache const* _cache);
+
+	// Generates the read of the map entry designated by the expression, without
+	// consulting any cache. The value is not unwrapped.
+	CExprPtr convert_map_read();
+
 protected:
 	bool visit(Conditional const& _node) override;
 	bool visit(Assignment const& _node) override;
@@ -73,6 +81,8 @@ private:
 
 	std::vector<CExprPtr> m_aux_rvs;
 
+	MapAccessCache const* m_map_cache = nullptr;
+
 	std::shared_ptr<AnalysisStack const> m_stack;
 
 	CExprPtr m_subexpr;
@@ -89,18 +99,40 @@ private:
 	// produces such integers from Solidity literals.
 	static long long int literal_to_number(Literal const& _node);
 
+	// If _expr is an integer constant, then its value is written to _val, and
+	// true is returned.
+	static bool constant_value(Expression const& _expr, bigint & _val);
+
+	// Returns true if _val can be written as a C literal.
+	static bool fits_literal(bigint const& _val);
+
 	// Helper to format binary calls. Unlike unary calls, binary calls appear in
-	// multiple cases.
+	// multiple cases. The operands are of type _type, if it is known.
 	void generate_binary_op(
-		Expression const& _lhs, Token _op, Expression const& _rhs
+		Expression const& _lhs,
+		Token _op,
+		Expression const& _rhs,
+		Type const* _type
+	);
+
+	// Helper to format exponentiation and right shifts, through the intrinsics
+	// of libverify. If the right operand is constant, then the operation may be
+	// folded into a literal or a native C operation.
+	void generate_intrinsic_op(
+		Expression const& _lhs,
+		Token _op,
+		Expression const& _rhs,
+		Type const& _type
 	);
 
-	// Helper to format mapping operations.
+	// Helper to format mapping operations. If _slot is set, then the written
+	// value is also assigned to _slot.
 	void generate_mapping_call(
 		std::string const& _op,
 		MapDeflate::FlatMap const& _map,
 		FlatIndex const& _idx,
-		CExprPtr _v
+		CExprPtr _v,
+		CExprPtr _slot = nullptr
 	);
 
 	// Returns the correct context for initializer applications. In a
@@ -132,8 +164,12 @@ private:
 	void print_cast(FunctionCall const& _call);
 	void print_function(FunctionCall const& _call);
 	void print_method(FunctionCallAnalyzer const& _calldata);
+	void print_checked_op(
+		std::string const& _op, FunctionCallAnalyzer const& _calldata
+	);
 	void print_contract_ctor(FunctionCall const& _call);
 	void print_payment(FunctionCall const& _call, bool _nothrow);
+	void print_crypto(FunctionCall const& _call);
 	void print_call(FunctionCallAnalyzer const& _call);
 	void print_require(CExprPtr _expr, std::string const& _msg);
 	void print_revert();
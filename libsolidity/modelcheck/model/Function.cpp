@@ -8,6 +8,7 @@
 #include <libsolidity/modelcheck/analysis/Library.h>
 #include <libsolidity/modelcheck/analysis/Structure.h>
 #include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
+#include <libsolidity/modelcheck/model/Array.h>
 #include <libsolidity/modelcheck/model/Block.h>
 #include <libsolidity/modelcheck/model/Mapping.h>
 #include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
@@ -43,11 +44,15 @@ FunctionConverter::FunctionConverter(
     bool _add_sums,
     size_t _map_k,
     View _view,
-    bool _fwd_dcl
+    bool _fwd_dcl,
+    bool _array_maps,
+    bool _fuse_mods
 ): M_ADD_SUMS(_add_sums)
  , M_MAP_K(_map_k)
  , M_VIEW(_view)
  , M_FWD_DCL(_fwd_dcl)
+ , M_ARRAY_MAPS(_array_maps)
+ , M_FUSE_MODS(_fuse_mods)
  , m_stack(_stack)
  , m_nd_reg(_nd_reg)
 {
@@ -87,6 +92,11 @@ void FunctionConverter::print(ostream& _stream)
             generate_mapping(*mapping);
         }
 
+        for (auto array : contract->arrays())
+        {
+            generate_array(*array);
+        }
+
         // Prints initializer.
         handle_contract_initializer(*contract, contract->tree());
 
@@ -192,6 +202,52 @@ CParams FunctionConverter::generate_params(
 
 // -------------------------------------------------------------------------- //
 
+CBlockList FunctionConverter::alias_params(
+    SolDeclList const& _rvs, SolDeclList const& _decls, VarContext _context
+)
+{
+    CBlockList aliases;
+
+    for (size_t i = 1; i < _rvs.size(); ++i)
+    {
+        auto const& RV = *_rvs[i];
+
+        string name = RV.name();
+        if (name.empty()) name = to_string(i);
+
+        auto src = make_shared<CIdentifier>(
+            VariableScopeResolver::rewrite(name, true, _context), true
+        );
+        aliases.push_back(make_shared<CVarDecl>(
+            m_stack->types()->get_type(RV),
+            VariableScopeResolver::rewrite(name, false, _context),
+            true,
+            src
+        ));
+    }
+
+    // Unnamed arguments are unreachable from the body, and are not aliased.
+    for (auto decl : _decls)
+    {
+        if (decl->name().empty()) continue;
+
+        bool const IS_REF = decl_is_ref(*decl);
+        auto src = make_shared<CIdentifier>(
+            VariableScopeResolver::rewrite(decl->name(), true, _context), IS_REF
+        );
+        aliases.push_back(make_shared<CVarDecl>(
+            m_stack->types()->get_type(*decl),
+            VariableScopeResolver::rewrite(decl->name(), false, _context),
+            IS_REF,
+            src
+        ));
+    }
+
+    return aliases;
+}
+
+// -------------------------------------------------------------------------- //
+
 void FunctionConverter::expand_default_init(
     VariableDeclaration const* _decl,
     CBlockList & _stmts,
@@ -229,7 +285,9 @@ void FunctionConverter::generate_mapping(Mapping const& _map)
     if (M_VIEW == View::EXT) return;
     if (!m_visited.insert(make_pair(&_map, nullptr)).second) return;
 
-    MapGenerator gen(_map, M_ADD_SUMS, M_MAP_K, *m_stack->types());
+    MapGenerator gen(
+        _map, M_ADD_SUMS, M_MAP_K, *m_stack->types(), M_ARRAY_MAPS
+    );
     (*m_ostream) << gen.declare_zero_initializer(M_FWD_DCL)
                  << gen.declare_read(M_FWD_DCL)
                  << gen.declare_write(M_FWD_DCL);
@@ -237,6 +295,19 @@ void FunctionConverter::generate_mapping(Mapping const& _map)
 
 // -------------------------------------------------------------------------- //
 
+void FunctionConverter::generate_array(ArrayTypeName const& _array)
+{
+    if (M_VIEW == View::EXT) return;
+    auto const NAME = m_stack->types()->get_name(_array);
+    if (!m_visited_arrays.insert(NAME).second) return;
+
+    ArrayGenerator gen(_array, m_stack);
+    (*m_ostream) << gen.declare_zero_initializer(M_FWD_DCL)
+                 << gen.declare_index(M_FWD_DCL);
+}
+
+// -------------------------------------------------------------------------- //
+
 void FunctionConverter::generate_structure(Structure const& _struct)
 {
     if (M_VIEW == View::EXT) return;
@@ -479,8 +550,39 @@ string FunctionConverter::handle_function(
     // Filters modifiers from constructors.
     ModifierBlockConverter::Factory mods(m_stack, _spec);
 
-    // Generates a declaration for the base call.
+    // Generates a single declaration for a fused chain. The body is expanded
+    // first, and is then wrapped by each modifier, from the inside out.
     auto const CONTEXT = VarContext::FUNCTION;
+    if (M_FUSE_MODS && !mods.empty() && mods.fusable())
+    {
+        CParams params = generate_params(
+            rvs, FUNC.parameters(), &USER, dest, CONTEXT, true
+        );
+
+        shared_ptr<CBlock> body;
+        if (!M_FWD_DCL)
+        {
+            FunctionBlockConverter cov(FUNC, m_stack);
+            cov.set_for(_spec);
+
+            auto stmts = alias_params(rvs, FUNC.parameters(), CONTEXT);
+            stmts.push_back(cov.convert());
+            body = make_shared<CBlock>(move(stmts));
+
+            for (size_t i = mods.len(); i > 0; --i)
+            {
+                auto mod_cov = mods.generate(i - 1, m_stack, body);
+                mod_cov.set_for(_spec);
+                body = mod_cov.convert();
+            }
+        }
+
+        auto id = make_shared<CVarDecl>(_rv_type, _spec.name(0), _rv_is_ptr);
+        (*m_ostream) << CFuncDef(id, move(params), move(body));
+        return _spec.name(0);
+    }
+
+    // Generates a declaration for the base call.
     vector<CFuncDef> defs;
     {
         CParams params = generate_params(
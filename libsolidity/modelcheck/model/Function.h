@@ -44,14 +44,19 @@ public:
 	// Specifies the class of methods to print.
 	enum class View { FULL, INT, EXT };
 
-    // Constructs a printer for all functions in the model.
+    // Constructs a printer for all functions in the model. If _array_maps is
+	// set, then mappings are backed by arrays. If _fuse_mods is set, then each
+	// fusable modifier chain (see ModifierBlockConverter::Factory) is printed
+	// as a single function.
     FunctionConverter(
 		std::shared_ptr<AnalysisStack> _stack,
 		std::shared_ptr<NondetSourceRegistry> _nd_reg,
 		bool _add_sums,
 		size_t _map_k,
 		View _view,
-		bool _forward_declare
+		bool _forward_declare,
+		bool _array_maps = false,
+		bool _fuse_mods = false
     );
 
     // Prints all user-defined functions, and implicit utility functions such as
@@ -68,6 +73,8 @@ private:
 
 	View const M_VIEW;
 	bool const M_FWD_DCL;
+	bool const M_ARRAY_MAPS;
+	bool const M_FUSE_MODS;
 
 	std::shared_ptr<AnalysisStack> m_stack;
 
@@ -75,6 +82,9 @@ private:
 
 	std::set<std::pair<void const*, void const*>> m_visited;
 
+	// Arrays of the same name share a single set of methods.
+	std::set<std::string> m_visited_arrays;
+
 	// Formats all Solidity arguments (_decls) as a c-function argument list.
 	// If _scope is set, the function is assumed to be a method of _scope. The
 	// _context and _instrumented pass to VariableScopeDeclaration::rewrite.
@@ -87,6 +97,13 @@ private:
 		bool _instrumeneted = false
 	);
 
+	// Within a fused modifier chain, the arguments and return values are named
+	// as in generate_params, with _instrumented set. This declares an alias for
+	// each, as named for the function body.
+	CBlockList alias_params(
+		SolDeclList const& _rvs, SolDeclList const& _decls, VarContext _context
+	);
+
 	//
 	void expand_default_init(
 		VariableDeclaration const* _decl,
@@ -97,6 +114,9 @@ private:
 	// Writes all utility methods associated with _map.
 	void generate_mapping(Mapping const& _map);
 
+	// Writes all utility methods associated with _array.
+	void generate_array(ArrayTypeName const& _array);
+
 	// Writes all utility methods associated with _struct.
 	void generate_structure(Structure const& _struct);
 
@@ -4,7 +4,6 @@
 #include <libsolidity/modelcheck/analysis/VariableScope.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
 #include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
-#include <libsolidity/modelcheck/utils/KeyIterator.h>
 #include <libsolidity/modelcheck/utils/Function.h>
 #include <libsolidity/modelcheck/utils/LibVerify.h>
 #include <libsolidity/modelcheck/utils/Types.h>
@@ -26,12 +25,14 @@ MapGenerator::MapGenerator(
     Mapping const& _src,
     bool _keep_sum,
     size_t _ct,
-    TypeAnalyzer const& _converter
+    TypeAnalyzer const& _converter,
+    bool _use_arrays
 ): M_LEN(_ct)
  , M_TYPE(_converter.get_type(_src))
  , M_CONVERTER(_converter)
  , M_MAP_RECORD(_converter.map_db().try_resolve(_src))
  , M_KEEP_SUM(_keep_sum && has_simple_type(*M_MAP_RECORD->value_type))
+ , M_USE_ARRAYS(_use_arrays)
  , M_VAL_T(_converter.get_type(*M_MAP_RECORD->value_type))
  , M_TMP(make_shared<CVarDecl>(M_TYPE, "tmp", false))
  , M_ARR(make_shared<CVarDecl>(M_TYPE, "arr", true))
@@ -65,20 +66,17 @@ CStructDef MapGenerator::declare(bool _forward_declare) const
             t->push_back(make_shared<CVarDecl>(M_VAL_T, "sum"));
         }
 
-        if (M_LEN > 0)
+        if (M_USE_ARRAYS)
         {
-            KeyIterator indices(M_LEN, M_MAP_RECORD->key_types.size());
-            do
+            vector<size_t> dims(M_MAP_RECORD->key_types.size(), M_LEN);
+            t->push_back(make_shared<CVarDecl>(M_VAL_T, "data", move(dims)));
+        }
+        else
+        {
+            for (auto const& field : M_MAP_RECORD->fields(M_LEN))
             {
-                if (indices.is_full())
-                {
-                    string const SUFFIX = indices.suffix();
-
-                    t->push_back(
-                        make_shared<CVarDecl>(M_VAL_T, "data" + SUFFIX)
-                    );
-                }
-            } while (indices.next());
+                t->push_back(make_shared<CVarDecl>(M_VAL_T, field));
+            }
         }
     }
     return CStructDef(M_MAP_RECORD->name, move(t));
@@ -100,20 +98,47 @@ CFuncDef MapGenerator::declare_zero_initializer(bool _forward_declare) const
         {
             block.push_back(M_TMP->access("sum")->assign(init_val)->stmt());
         }
-        
-        KeyIterator indices(M_LEN, M_MAP_RECORD->key_types.size());
-        do
+
+        if (M_USE_ARRAYS)
         {
-            if (indices.is_full())
+            // Generates one loop per key, with the innermost loop writing data.
+            size_t const DEPTH = M_MAP_RECORD->key_types.size();
+            vector<shared_ptr<CIdentifier>> ids;
+            CExprPtr data = M_TMP->access("data");
+            for (size_t i = 0; i < DEPTH; ++i)
             {
-                string const SUFFIX = indices.suffix();
+                ids.push_back(make_shared<CIdentifier>(
+                    "i_" + to_string(i), false
+                ));
+                data = make_shared<CIndexAccess>(data, ids.back());
+            }
 
-                block.push_back(
-                    M_TMP->access("data" + SUFFIX)->assign(init_val)->stmt()
+            CStmtPtr stmt = make_shared<CAssign>(data, init_val)->stmt();
+            for (size_t i = DEPTH; i > 0; --i)
+            {
+                auto const& ID = ids[i - 1];
+                auto len = make_shared<CIntLiteral>(M_LEN);
+                stmt = make_shared<CForLoop>(
+                    make_shared<CVarDecl>(
+                        "uint64_t", "i_" + to_string(i - 1), false,
+                        Literals::ZERO
+                    ),
+                    make_shared<CBinaryOp>(ID, "<", move(len)),
+                    make_shared<CUnaryOp>("++", ID, true)->stmt(),
+                    move(stmt)
                 );
             }
-        } while (indices.next());
-        
+            block.push_back(stmt);
+        }
+        else
+        {
+            for (auto const& field : M_MAP_RECORD->fields(M_LEN))
+            {
+                block.push_back(M_TMP->access(field)->assign(init_val)->stmt());
+            }
+        }
+
+
         block.push_back(make_shared<CReturn>(M_TMP->id()));
         body = make_shared<CBlock>(move(block));
     }
@@ -136,7 +161,15 @@ CFuncDef MapGenerator::declare_write(bool _forward_declare) const
     shared_ptr<CBlock> body;
     if (!_forward_declare)
     {
-        CBlockList block{expand_access(0, "", true, M_KEEP_SUM)};
+        CBlockList block;
+        if (M_USE_ARRAYS)
+        {
+            block.push_back(array_access(true, M_KEEP_SUM));
+        }
+        else
+        {
+            block.push_back(expand_access(0, 0, true, M_KEEP_SUM));
+        }
 
         if (M_KEEP_SUM)
         {
@@ -169,9 +202,18 @@ CFuncDef MapGenerator::declare_read(bool _forward_declare) const
     {
         auto default_val = M_CONVERTER.get_init_val(*M_MAP_RECORD->value_type);
 
+        CStmtPtr access;
+        if (M_USE_ARRAYS)
+        {
+            access = array_access(false, false);
+        }
+        else
+        {
+            access = expand_access(0, 0, false, false);
+        }
+
         body = make_shared<CBlock>(CBlockList{
-            expand_access(0, "", false, false),
-            make_shared<CReturn>(move(default_val))
+            move(access), make_shared<CReturn>(move(default_val))
         });
     }
 
@@ -181,12 +223,13 @@ CFuncDef MapGenerator::declare_read(bool _forward_declare) const
 // -------------------------------------------------------------------------- //
 
 CStmtPtr MapGenerator::expand_access(
-    size_t _depth, string const& _suffix, bool _is_writer, bool _maintain_sum
+    size_t _depth, size_t _ordinal, bool _is_writer, bool _maintain_sum
 ) const
 {
     if (_depth == M_MAP_RECORD->key_types.size())
     {
-        auto const DATA = M_ARR->access("data" + _suffix);
+        auto const& FIELD = M_MAP_RECORD->fields(M_LEN)[_ordinal];
+        auto const DATA = M_ARR->access(FIELD);
         if (_is_writer)
         {
             CBlockList block;
@@ -209,13 +252,13 @@ CStmtPtr MapGenerator::expand_access(
         shared_ptr<CIf> stmt;
         for (size_t i = 0; i < M_LEN; ++i)
         {
-            auto const SUFFIX = _suffix + "_" + to_string(i);
+            auto const ORDINAL = _ordinal * M_LEN + i;
             auto const REQ_KEY = m_keys[_depth]->access("v");
 
             auto key = make_shared<CIntLiteral>(i);
             auto cond = make_shared<CBinaryOp>(move(key), "==", REQ_KEY);
             auto next = expand_access(
-                _depth + 1, SUFFIX, _is_writer, _maintain_sum
+                _depth + 1, ORDINAL, _is_writer, _maintain_sum
             );
 
             stmt = make_shared<CIf>(move(cond), move(next), move(stmt));
@@ -224,17 +267,7 @@ CStmtPtr MapGenerator::expand_access(
         CBlockList stmts;
         if (_depth == 0)
         {
-            for (size_t i = 0; i < M_MAP_RECORD->key_types.size(); ++i)
-            {
-                auto const REQ_KEY = m_keys[i]->access("v");
-                auto key = make_shared<CIntLiteral>(M_LEN);
-                auto cond = make_shared<CBinaryOp>(move(key), ">=", REQ_KEY);
-
-                ostringstream err_msg;
-                err_msg << "Model failure, mapping key out of bounds.";
-
-                LibVerify::add_assert(stmts, cond, err_msg.str());
-            }
+            check_bounds(stmts);
         }
         stmts.push_back(stmt);
         return make_shared<CBlock>(move(stmts));
@@ -243,6 +276,74 @@ CStmtPtr MapGenerator::expand_access(
 
 // -------------------------------------------------------------------------- //
 
+CStmtPtr MapGenerator::array_access(bool _is_writer, bool _maintain_sum) const
+{
+    // Entries are only accessed if every key is within the array's bounds.
+    CExprPtr in_bounds;
+    CExprPtr data = M_ARR->access("data");
+    for (auto key : m_keys)
+    {
+        auto const REQ_KEY = key->access("v");
+        auto len = make_shared<CIntLiteral>(M_LEN);
+        auto cond = make_shared<CBinaryOp>(REQ_KEY, "<", move(len));
+        if (in_bounds)
+        {
+            in_bounds = make_shared<CBinaryOp>(in_bounds, "&&", cond);
+        }
+        else
+        {
+            in_bounds = cond;
+        }
+
+        auto idx = make_shared<CCast>(REQ_KEY, "uint64_t");
+        data = make_shared<CIndexAccess>(data, idx);
+    }
+
+    CStmtPtr stmt;
+    if (_is_writer)
+    {
+        CBlockList block;
+        if (_maintain_sum)
+        {
+            block.push_back(make_shared<CBinaryOp>(
+                M_ARR->access("sum")->access("v"),
+                "-=",
+                make_shared<CMemberAccess>(data, "v")
+            )->stmt());
+        }
+        block.push_back(make_shared<CAssign>(data, M_DAT->id())->stmt());
+        stmt = make_shared<CBlock>(move(block));
+    }
+    else
+    {
+        stmt = make_shared<CReturn>(data);
+    }
+
+    CBlockList stmts;
+    check_bounds(stmts);
+    stmts.push_back(make_shared<CIf>(in_bounds, move(stmt)));
+    return make_shared<CBlock>(move(stmts));
+}
+
+// -------------------------------------------------------------------------- //
+
+void MapGenerator::check_bounds(CBlockList & _block) const
+{
+    for (auto key : m_keys)
+    {
+        auto const REQ_KEY = key->access("v");
+        auto len = make_shared<CIntLiteral>(M_LEN);
+        auto cond = make_shared<CBinaryOp>(move(len), ">=", REQ_KEY);
+
+        ostringstream err_msg;
+        err_msg << "Model failure, mapping key out of bounds.";
+
+        LibVerify::add_assert(_block, cond, err_msg.str());
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
 }
 }
 }
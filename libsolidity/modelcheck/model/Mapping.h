@@ -35,12 +35,15 @@ public:
     // Constructs a new map. The map models AST node _src. The map will model
     // _ct entries. Its key and value types are converted using _converter,
     // along with the map itself. If _keep_sum is set and if the map's values
-    // have a simple type, the sum aggregator is instrumented by default.
+    // have a simple type, the sum aggregator is instrumented by default. If
+    // _use_arrays is set, then entries are stored in a multi-dimensional array,
+    // rather than as one field per entry.
     MapGenerator(
         Mapping const& _src,
         bool _keep_sum,
         size_t _ct,
-        TypeAnalyzer const& _converter
+        TypeAnalyzer const& _converter,
+        bool _use_arrays = false
     );
 
     // Declares all structures and functions used by a map.
@@ -61,6 +64,9 @@ private:
     // Maintain sum of values in maps of simple types.
     bool const M_KEEP_SUM;
 
+    // Store entries in an array, indexed by key.
+    bool const M_USE_ARRAYS;
+
     // Const type names to simplify generation.
     std::string const M_VAL_T;
 
@@ -73,15 +79,23 @@ private:
     std::vector<std::shared_ptr<CVarDecl>> m_keys;
 
     // Generate the (_depth)-th block in either a read or write method, for a
-    // nested mapping. _suffix is used to identify the key. _is_writer
-    // distinguishes reads from writes. _maintain_sum specifies whether or not
-    // a sum variable should be updated on write.
+    // nested mapping. _ordinal is the ordinal of the keys matched so far (see
+    // KeyIterator::ordinal). _is_writer distinguishes reads from writes.
+    // _maintain_sum specifies whether or not a sum variable should be updated
+    // on write.
     CStmtPtr expand_access(
         size_t _depth,
-        std::string const& _suffix,
+        size_t _ordinal,
         bool _is_writer,
         bool _maintain_sum
     ) const;
+
+    // Generates the body of either a read or write method, for an array-backed
+    // mapping. _is_writer and _maintain_sum are as in expand_access.
+    CStmtPtr array_access(bool _is_writer, bool _maintain_sum) const;
+
+    // Generates an assertion that each key is within the model's bounds.
+    void check_bounds(CBlockList & _block) const;
 };
 
 // -------------------------------------------------------------------------- //
@@ -95,6 +95,55 @@ CExprPtr NondetSourceRegistry::simple_val(Type const& _type, string const& _msg)
     return InitFunction::wrap(_type, raw_val(_type, _msg));
 }
 
+bool NondetSourceRegistry::is_batchable(Type const& _type)
+{
+    if (!is_simple_type(_type)) return false;
+
+    auto const CATEGORY = unwrap(_type).category();
+    if (CATEGORY == Type::Category::Bool) return false;
+    if (CATEGORY == Type::Category::Address) return false;
+    return (dynamic_cast<EnumType const*>(&_type) == nullptr);
+}
+
+shared_ptr<CVarDecl> NondetSourceRegistry::raw_array(
+    CBlockList & _block, Type const& _type, size_t _n, string const& _msg
+)
+{
+    if (!is_batchable(_type))
+    {
+        throw std::runtime_error("raw_array expects a batchable type.");
+    }
+
+    size_t loc = m_registry.size();
+    m_registry.insert(m_registry.end(), _n, &_type);
+    m_batches.emplace_back(loc, _n);
+
+    auto const BITS = simple_bit_count(_type);
+    auto const SIGN = simple_is_signed(_type);
+    auto const TYPE = PrimitiveToRaw::integer(BITS, SIGN);
+    auto const NAME = "nd_batch_" + to_string(loc);
+    auto array = make_shared<CVarDecl>(TYPE, NAME, vector<size_t>{_n});
+    _block.push_back(array);
+
+    CFuncCallBuilder call(SIGN ? "GET_ND_INT_ARRAY" : "GET_ND_UINT_ARRAY");
+    call.push(make_shared<CIntLiteral>(loc));
+    call.push(make_shared<CIntLiteral>(BITS));
+    call.push(make_shared<CIntLiteral>(_n));
+    call.push(array->id());
+    call.push(make_shared<CStringLiteral>(_msg));
+    _block.push_back(call.merge_and_pop_stmt());
+
+    return array;
+}
+
+CExprPtr NondetSourceRegistry::simple_elem(
+    Type const& _type, CVarDecl const& _array, CExprPtr _idx
+)
+{
+    auto entry = make_shared<CIndexAccess>(_array.id(), move(_idx));
+    return InitFunction::wrap(_type, move(entry));
+}
+
 CExprPtr NondetSourceRegistry::val(TypeName const& _type, string const& _msg)
 {
     if (has_simple_type(_type))
@@ -143,6 +192,28 @@ void NondetSourceRegistry::print(std::ostream& _stream)
         auto id = make_shared<CVarDecl>(TYPE, NAME);
         _stream << CFuncDef(move(id), args, nullptr, mod);
     }
+
+    // With external non-determinism, GET_ND_(U)INT_ARRAY expands to the batch
+    // macro SEA_ND_BATCH_<loc>, so that each value is read from its own hook.
+    if (m_batches.empty()) return;
+    _stream << endl << "#ifdef MC_USE_EXTERNAL_NONDET" << endl;
+    for (auto const& batch : m_batches)
+    {
+        auto const& SRC = (*m_registry[batch.first]);
+        auto const BITS = to_string(simple_bit_count(SRC));
+        auto const MACRO = simple_is_signed(SRC) ? "GET_ND_INT" : "GET_ND_UINT";
+
+        _stream << "#define SEA_ND_BATCH_" << batch.first
+                << "(__out,__msg) do{";
+        for (size_t i = 0; i < batch.second; ++i)
+        {
+            auto const LOC = to_string(batch.first + i);
+            _stream << "(__out)[" << i << "]="
+                    << MACRO << "(" << LOC << "," << BITS << ",__msg);";
+        }
+        _stream << "}while(0)" << endl;
+    }
+    _stream << "#endif" << endl;
 }
 
 // -------------------------------------------------------------------------- //
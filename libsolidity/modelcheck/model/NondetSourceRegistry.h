@@ -50,6 +50,28 @@ public:
     // Requests a non-deterministic value for _type described by _msg.
     CExprPtr simple_val(Type const& _type, std::string const& _msg);
 
+    // Returns true if raw_val requests values of _type as integers of a fixed
+    // width, rather than from a range. Only such values are batched.
+    static bool is_batchable(Type const& _type);
+
+    // Requests _n non-deterministic values for primitive _type described by
+    // _msg. An array of the raw values is declared in _block, and populated by
+    // a single request. The array is returned. Requires is_batchable(_type).
+    //
+    // Each value still has its own source. With external non-determinism, the
+    // request expands to a scalar request per value (see print).
+    std::shared_ptr<CVarDecl> raw_array(
+        CBlockList & _block,
+        Type const& _type,
+        size_t _n,
+        std::string const& _msg
+    );
+
+    // Returns entry _idx of _array, as a value of _type. The _array must be the
+    // result of raw_array for a type with the same raw representation.
+    static CExprPtr
+        simple_elem(Type const& _type, CVarDecl const& _array, CExprPtr _idx);
+
     // Requests a non-deterministic value for _type described by _msg. If the
     // type is a mapping, then nullptr is returned.
 	CExprPtr val(TypeName const& _type, std::string const& _msg);
@@ -58,12 +80,16 @@ public:
     // type is a mapping, then nullptr is returned.
 	CExprPtr val(Declaration const& _decl, std::string const& _msg);
 
-    // Prints all non-deterministic methods to _stream.
+    // Prints all non-deterministic methods to _stream. For each batch, this
+    // includes the expansion of the batch into scalar requests.
     void print(std::ostream& _stream);
 
 private:
     std::vector<Type const*> m_registry;
 
+    // The first source and the size of each batch, in order of request.
+    std::vector<std::pair<size_t, size_t>> m_batches;
+
     std::shared_ptr<AnalysisStack const> m_stack;
 
     // Adds a record for _type into m_registry.
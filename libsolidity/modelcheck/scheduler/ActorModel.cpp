@@ -5,6 +5,7 @@
 #include <libsolidity/modelcheck/analysis/AnalysisStack.h>
 #include <libsolidity/modelcheck/analysis/CallState.h>
 #include <libsolidity/modelcheck/analysis/Inheritance.h>
+#include <libsolidity/modelcheck/analysis/StateFootprint.h>
 #include <libsolidity/modelcheck/analysis/TightBundle.h>
 #include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
 #include <libsolidity/modelcheck/analysis/VariableScope.h>
@@ -36,11 +37,14 @@ Actor::Actor(
  , address(_contract->address())
  , global(_contract->can_fallback_through_send())
 {
-    // Reserves a unique identifier for the actor.
+    // Reserves a unique identifier for the actor. Global actors are lifted in
+    // reentrant models.
     decl = make_shared<CVarDecl>(
         _stack->types()->get_type(*contract->raw()),
         "contract_" + to_string(address),
-        _path != nullptr
+        _path != nullptr,
+        nullptr,
+        global && _stack->settings().reentrant
     );
 
     // Analyzes all children and function calls.
@@ -75,6 +79,12 @@ ActorModel::ActorModel(
         }
     }
 
+    // Drops transactions which cannot lead to new states.
+    if (m_stack->settings().elide_getters)
+    {
+        elide_getters();
+    }
+
     // Extracts the address variable for each contract.
     for (auto actor : m_actors)
     {
@@ -98,13 +108,13 @@ ActorModel::ActorModel(
 
 // -------------------------------------------------------------------------- //
 
-void ActorModel::declare_global(ostream& _stream) const
+void ActorModel::declare_global(CParams & _globals) const
 {
     for (auto const& actor : m_actors)
     {
         if (actor.global)
         {
-            _stream << (*actor.decl);
+            _globals.push_back(actor.decl);
         }
     }
 }
@@ -136,7 +146,7 @@ void ActorModel::initialize(
         auto ctx = actor.contract;
 
         stringstream caselog;
-        caselog << "[Initializing " << (*actor.decl->id());
+        caselog << "[Initializing " << actor.decl->name();
         if (actor.has_children) caselog << " and children";
         caselog << "]";
         LibVerify::log(_block, caselog.str());
@@ -179,14 +189,9 @@ void ActorModel::assign_addresses(CBlockList & _block) const
     // Assigns an address to each contract
     for (auto const& actor : m_actors)
     {
-        auto const& DECL = actor.decl;
-        if (actor.path)
-        {
-            _block.push_back(
-                DECL->assign(make_shared<CReference>(actor.path))->stmt()
-            );
-        }
+        assign_path(_block, actor);
 
+        auto const& DECL = actor.decl;
         auto const& ADDR = DECL->access(ContractUtilities::address_member());
         _block.push_back(ADDR->access("v")->assign(
             make_shared<CIntLiteral>(actor.address)
@@ -202,6 +207,16 @@ void ActorModel::assign_addresses(CBlockList & _block) const
 
 // -------------------------------------------------------------------------- //
 
+void ActorModel::assign_paths(CBlockList & _block) const
+{
+    for (auto const& actor : m_actors)
+    {
+        assign_path(_block, actor);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
 vector<shared_ptr<CMemberAccess>> const& ActorModel::vars() const
 {
     return m_addrvar;
@@ -216,6 +231,19 @@ vector<Actor> const& ActorModel::inspect() const
 
 // -------------------------------------------------------------------------- //
 
+void ActorModel::assign_path(CBlockList & _block, Actor const& _actor)
+{
+    if (_actor.path)
+    {
+        auto const& DECL = _actor.decl;
+        _block.push_back(
+            DECL->assign(make_shared<CReference>(_actor.path))->stmt()
+        );
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
 void ActorModel::recursive_setup(shared_ptr<BundleContract const> _src)
 {
     // Caches information about the parent, since the vector may resize in loop.
@@ -235,6 +263,36 @@ void ActorModel::recursive_setup(shared_ptr<BundleContract const> _src)
     }
 }
 
+void ActorModel::elide_getters()
+{
+    vector<vector<FunctionSpecialization>> kept(m_actors.size());
+    bool any_kept = false;
+    for (size_t i = 0; i < m_actors.size(); ++i)
+    {
+        auto const& actor = m_actors[i];
+        for (auto const& spec : actor.specs)
+        {
+            auto const& FUNC = spec.func();
+            auto const MUTABILITY = FUNC.stateMutability();
+            bool const READONLY = (MUTABILITY == StateMutability::Pure
+                                || MUTABILITY == StateMutability::View);
+            StateFootprint footprint(*actor.contract, FUNC);
+            if (!footprint.preserves_state(READONLY))
+            {
+                kept[i].push_back(spec);
+                any_kept = true;
+            }
+        }
+    }
+
+    // A harness must schedule at least one transaction.
+    if (!any_kept) return;
+    for (size_t i = 0; i < m_actors.size(); ++i)
+    {
+        m_actors[i].specs = move(kept[i]);
+    }
+}
+
 // -------------------------------------------------------------------------- //
 
 }
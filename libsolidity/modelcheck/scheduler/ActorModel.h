@@ -77,14 +77,17 @@ class ActorModel
 {
 public:
     // Generates an actor for each Tight Bundle Contract. Note that _nd_reg is
-    // used for all non-deterministic allocations.
+    // used for all non-deterministic allocations. If elide_getters is set for
+    // _stack, then specializations which can neither change the state of the
+    // model nor fail an assertion (see StateFootprint) are dropped, unless this
+    // would drop every specialization.
     ActorModel(
         std::shared_ptr<AnalysisStack const> _stack,
         std::shared_ptr<NondetSourceRegistry> _nd_reg
     );
 
-    // Generates global actor declarations.
-    void declare_global(std::ostream& _stream) const;
+    // Appends a declaration for each global actor onto _globals.
+    void declare_global(CParams & _globals) const;
 
     // Appends a declaration for (non-global) each actor onto _block.
     void declare(CBlockList & _block) const;
@@ -100,6 +103,9 @@ public:
     // Appends statements onto _block to allocate addresses for each actor.
     void assign_addresses(CBlockList & _block) const;
 
+    // Appends statements onto _block to bind each child actor to its parent.
+    void assign_paths(CBlockList & _block) const;
+
     // Returns a list of contract address declarations.
     std::vector<std::shared_ptr<CMemberAccess>> const& vars() const;
 
@@ -117,9 +123,15 @@ private:
     // An anonymous list of contract address member variables.
     std::vector<std::shared_ptr<CMemberAccess>> m_addrvar;
 
+    // Appends a statement onto _block to bind _actor to its parent, if any.
+    static void assign_path(CBlockList & _block, Actor const& _actor);
+
     // Extends setup to children. It is assumed that the last element of
     // m_actors corresponds to _src upon entry.
     void recursive_setup(std::shared_ptr<BundleContract const> _src);
+
+    // Drops each specialization which preserves the state of the model.
+    void elide_getters();
 };
 
 // -------------------------------------------------------------------------- //
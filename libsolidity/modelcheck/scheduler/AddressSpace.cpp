@@ -1,6 +1,7 @@
 #include <libsolidity/modelcheck/scheduler/AddressSpace.h>
 
 #include <libsolidity/modelcheck/analysis/AbstractAddressDomain.h>
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
 #include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
 #include <libsolidity/modelcheck/utils/AbstractAddressDomain.h>
@@ -21,17 +22,53 @@ namespace modelcheck
 
 // -------------------------------------------------------------------------- //
 
+const string AddressSpace::NEXT_USER = "next_user";
+
+// -------------------------------------------------------------------------- //
+
 AddressSpace::AddressSpace(
-    shared_ptr<PTGBuilder const> _address_data,
+    shared_ptr<AnalysisStack const> _stack,
     shared_ptr<NondetSourceRegistry> _nd_reg
-): MAX_ADDR(_address_data->implicit_count())
- , m_address_data(_address_data)
+): MAX_ADDR(_stack->addresses()->implicit_count())
+ , MIN_USER(_stack->addresses()->implicit_count())
+ , MAX_USER(_stack->addresses()->max_sender())
+ , M_USE_SYMMETRY(
+        _stack->settings().reduce_users && MIN_USER + 1 < MAX_USER
+   )
+ , m_stack(_stack)
+ , m_address_data(_stack->addresses())
  , m_nd_reg(_nd_reg)
 {
 }
 
 // -------------------------------------------------------------------------- //
 
+void AddressSpace::declare(CBlockList & _block) const
+{
+    if (!M_USE_SYMMETRY) return;
+
+    auto init = make_shared<CIntLiteral>(MIN_USER);
+    auto decl = make_shared<CVarDecl>("sol_raw_uint160_t", NEXT_USER);
+    _block.push_back(decl);
+    _block.push_back(decl->assign(init)->stmt());
+}
+
+// -------------------------------------------------------------------------- //
+
+void AddressSpace::declare_literals(CParams & _globals) const
+{
+    bool const LIFTED = m_stack->settings().reentrant;
+    for (auto lit : m_address_data->literals())
+    {
+        auto const NAME = AbstractAddressDomain::literal_name(lit);
+        _globals.push_back(make_shared<CVarDecl>(
+            "sol_raw_uint160_t", NAME, false, nullptr, LIFTED
+        ));
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
 void AddressSpace::map_constants(CBlockList & _block) const
 {
     // Reserves space for each address.
@@ -45,10 +82,11 @@ void AddressSpace::map_constants(CBlockList & _block) const
     }
 
     // Assigns each address, and handles equality.
+    bool const LIFTED = m_stack->settings().reentrant;
     for (auto lit : m_address_data->literals())
     {
         auto const NAME = AbstractAddressDomain::literal_name(lit);
-        auto decl = make_shared<CIdentifier>(NAME, false);
+        auto decl = make_shared<CIdentifier>(NAME, false, LIFTED);
 
         if (lit == 0)
         {
@@ -63,7 +101,7 @@ void AddressSpace::map_constants(CBlockList & _block) const
             {
                 // TODO: bad for fuzzing, though used_so_far is often small.
                 auto check = make_shared<CBinaryOp>(decl, "!=", otr);
-                LibVerify::add_require(_block, check);
+                LibVerify::add_require(*m_stack, _block, check);
             }
 
             used_so_far.push_back(decl);
@@ -73,6 +111,28 @@ void AddressSpace::map_constants(CBlockList & _block) const
 
 // -------------------------------------------------------------------------- //
 
+void AddressSpace::canonicalize(CBlockList & _block, CExprPtr _addr) const
+{
+    if (!M_USE_SYMMETRY) return;
+
+    auto next = make_shared<CIdentifier>(NEXT_USER, false);
+    auto min_user = make_shared<CIntLiteral>(MIN_USER);
+
+    // Either the user is distinguished, or it is not fresh, or it is next.
+    auto is_distinct = make_shared<CBinaryOp>(_addr, "<", min_user);
+    auto is_canon = make_shared<CBinaryOp>(_addr, "<=", next);
+    auto cond = make_shared<CBinaryOp>(is_distinct, "||", is_canon);
+    string const MSG = "Non-canonical user selection.";
+    LibVerify::add_require(*m_stack, _block, cond, MSG);
+
+    // If this is the first use of a user, the next user is reserved.
+    auto is_next = make_shared<CBinaryOp>(_addr, "==", next);
+    auto incr = make_shared<CBinaryOp>(next, "+", Literals::ONE);
+    _block.push_back(make_shared<CIf>(is_next, next->assign(incr)->stmt()));
+}
+
+// -------------------------------------------------------------------------- //
+
 }
 }
 }
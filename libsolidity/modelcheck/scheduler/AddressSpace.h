@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace dev
 {
@@ -19,6 +20,7 @@ namespace solidity
 namespace modelcheck
 {
 
+class AnalysisStack;
 class NondetSourceRegistry;
 class PTGBuilder;
 
@@ -27,25 +29,57 @@ class PTGBuilder;
 /**
  * Describes the possible addresses, maintains their allocations, and provides a
  * utility to allocate distinct addresses.
+ *
+ * The users between implicit_count() and max_sender() are interchangeable. If
+ * symmetry reduction is enabled, then these users are canonicalized, such that
+ * the first use of each user is in increasing order. Any trace of the model can
+ * be relabeled to satisfy this ordering.
  */
 class AddressSpace
 {
 public:
+    // The addresses are taken from _stack. If reduce_users is set by the
+    // settings of _stack, then interchangeable users are canonicalized.
     AddressSpace(
-        std::shared_ptr<PTGBuilder const> _address_data,
+        std::shared_ptr<AnalysisStack const> _stack,
         std::shared_ptr<NondetSourceRegistry> _nd_reg
     );
 
+    // Appends the declarations used to track interchangeable users to _block.
+    void declare(CBlockList & _block) const;
+
+    // Appends a declaration for each literal address to _globals.
+    void declare_literals(CParams & _globals) const;
+
     // Generates statements in _block to map all constants to distinct values.
     void map_constants(CBlockList & _block) const;
 
+    // Appends statements to _block which require that the address in _addr is
+    // either distinguished, or is the lowest interchangeable user which is not
+    // yet in use. If _addr is the lowest unused user, it is then marked.
+    void canonicalize(CBlockList & _block, CExprPtr _addr) const;
+
 private:
+    // The variable name used to track the next unused interchangeable user.
+    static const std::string NEXT_USER;
+
     // Stores the minimum allocatable address. This accounts for 0.
     const uint64_t MIN_ADDR = 1;
 
     // The maximum allocated address.
     const uint64_t MAX_ADDR;
 
+    // The first interchangeable user.
+    const uint64_t MIN_USER;
+
+    // One past the last interchangeable user.
+    const uint64_t MAX_USER;
+
+    // If true, interchangeable users are canonicalized.
+    const bool M_USE_SYMMETRY;
+
+    std::shared_ptr<AnalysisStack const> m_stack;
+
     // Stores all parameters over the address space.
     std::shared_ptr<PTGBuilder const> m_address_data;
 
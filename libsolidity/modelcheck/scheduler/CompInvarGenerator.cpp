@@ -113,18 +113,43 @@ void CompInvarGenerator::print_invariants(ostream& _stream)
 
 CBlockList CompInvarGenerator::apply_interference(NondetSourceRegistry &_nd_reg)
 {
-    // Wraps interference application in a lambda.
+    // Array-backed mappings are updated in loops.
     CBlockList block;
-    auto apply = [&self=(*this),&_nd_reg,&block]
+    if (m_settings.array_maps)
+    {
+        for (auto const& map : m_maps)
+        {
+            block.push_back(loop_interference(map, _nd_reg));
+        }
+        return block;
+    }
+
+    // Wraps interference application in a lambda. If the entries of a mapping
+    // are batched, then each entry is read from batch, in order.
+    auto const WIDTH = m_stack->addresses()->count();
+    shared_ptr<CVarDecl> batch;
+    size_t entry = 0;
+    auto apply = [&self=(*this),&_nd_reg,&block,WIDTH,&batch,&entry]
                  (MapData const& _map, KeyIterator const& _indices)
     {
         // Determine field.
-        string const FIELD = "data" + _indices.suffix();
+        auto const& FIELD = _map.record->fields(WIDTH)[_indices.ordinal()];
         auto const DATA = make_shared<CMemberAccess>(_map.path, FIELD);
 
         // Create non-deterministic value.
-        string const MSG = _map.display + "::" + _indices.suffix();
-        auto const ND = _nd_reg.val(*_map.base_type, MSG);
+        CExprPtr ND;
+        if (batch)
+        {
+            ND = NondetSourceRegistry::simple_elem(
+                *_map.base_type->annotation().type,
+                *batch,
+                make_shared<CIntLiteral>(entry++)
+            );
+        }
+        else
+        {
+            ND = _nd_reg.val(*_map.base_type, _map.display + "::" + FIELD);
+        }
 
         // Initializes.
         CStmtPtr initializer = DATA->assign(ND)->stmt();
@@ -147,8 +172,30 @@ CBlockList CompInvarGenerator::apply_interference(NondetSourceRegistry &_nd_reg)
         self.apply_invariant(block, false, _map, values, _indices.view());
     };
 
-    // Populates and returns block.
-    expand_maps(apply);
+    // Populates and returns block. The entries of each mapping are requested
+    // as a single batch, when possible. Role guards are evaluated at runtime,
+    // so guarded entries are requested individually, and only when applied.
+    bool const GUARDED = (m_settings.type == InvarType::RoleBased);
+    for (auto const& map : m_maps)
+    {
+        batch = nullptr;
+        entry = 0;
+        if (!GUARDED && has_simple_type(*map.base_type))
+        {
+            size_t count = 0;
+            expand_map(map, [&count](MapData const&, KeyIterator const&) {
+                ++count;
+            });
+
+            auto const& TYPE = *map.base_type->annotation().type;
+            if (count > 1 && NondetSourceRegistry::is_batchable(TYPE))
+            {
+                string const MSG = map.display + "::data";
+                batch = _nd_reg.raw_array(block, TYPE, count, MSG);
+            }
+        }
+        expand_map(map, apply);
+    }
     return block;
 }
 
@@ -166,7 +213,9 @@ CBlockList CompInvarGenerator::check_interference(NondetSourceRegistry &_nd_reg)
     // Default, unreachable case.
     CBlockList default_case;
     string default_err("Model failure, entry_id out of bounds.");
-    LibVerify::add_require(default_case, Literals::ZERO, default_err);
+    LibVerify::add_require(
+        *m_stack, default_case, Literals::ZERO, default_err
+    );
 
     // Selects mapping and field.
     auto map_id = make_shared<CVarDecl>("uint64_t", "map_id");
@@ -185,12 +234,23 @@ CBlockList CompInvarGenerator::check_interference(NondetSourceRegistry &_nd_reg)
             values.push_back(vars.back()->id());
         }
 
+        // Array-backed mappings select each index directly.
+        if (m_settings.array_maps)
+        {
+            select_entry(map_block, map, vars, _nd_reg);
+            apply_invariant(map_block, true, map, values, {});
+            map_block.push_back(make_shared<CBreak>());
+            mcases->add_case(mcases->size(), move(map_block));
+            continue;
+        }
+
         // Declares switch statement and switch variable.
         auto entry_id = make_shared<CVarDecl>("uint64_t", "entry_id");
         auto ecases = make_shared<CSwitch>(entry_id->id(), default_case);
 
         // Generates callback to populate each switch case.
-        auto check = [&self=(*this),&ecases,&vars]
+        auto const WIDTH = m_stack->addresses()->count();
+        auto check = [&self=(*this),&ecases,&vars,WIDTH]
                      (MapData const& _map, KeyIterator const& _indices)
         {
             CBlockList entry_block;
@@ -202,10 +262,12 @@ CBlockList CompInvarGenerator::check_interference(NondetSourceRegistry &_nd_reg)
             entry_block.push_back(self.guard(
                 gv->assign(Literals::ONE)->stmt(), _indices.view()
             ));
-            LibVerify::add_require(entry_block, gv->id(), "Guard");
+            LibVerify::add_require(
+                *self.m_stack, entry_block, gv->id(), "Guard"
+            );
 
             // Visits each field and default value (see above).
-            string const FIELD = "data" + _indices.suffix();
+            auto const& FIELD = _map.record->fields(WIDTH)[_indices.ordinal()];
             auto const DATA = make_shared<CMemberAccess>(_map.path, FIELD);
             for (size_t i = 0; i < _map.fields.size(); ++i)
             {
@@ -285,6 +347,7 @@ void CompInvarGenerator::analyze_actor(
         m_maps.back().path = _path;
         m_maps.back().base_type = entry->value_type;
         m_maps.back().display = _display;
+        m_maps.back().record = entry;
 
         // Populates fields.
         vector<string> path;
@@ -307,14 +370,6 @@ void CompInvarGenerator::analyze_actor(
 
 // -------------------------------------------------------------------------- //
 
-void CompInvarGenerator::expand_maps(MapVisitor _f)
-{
-    for (auto map : m_maps)
-    {
-        expand_map(map, _f);
-    }
-}
-
 void CompInvarGenerator::expand_map(MapData const& _map, MapVisitor _f)
 {
     // Determines initial index.
@@ -374,6 +429,179 @@ CStmtPtr CompInvarGenerator::guard(
 
 // -------------------------------------------------------------------------- //
 
+CExprPtr CompInvarGenerator::index_guard(
+    vector<shared_ptr<CIdentifier>> const& _indices
+) const
+{
+    // All entries are visited if there are no implicit users to exclude.
+    if (m_settings.type == InvarType::Universal)
+    {
+        return nullptr;
+    }
+
+    // The mapping entry is abstract if at least one index is abstract.
+    auto const OFFSET = m_stack->addresses()->implicit_count();
+    CExprPtr guards;
+    for (auto idx : _indices)
+    {
+        auto offset = make_shared<CIntLiteral>(OFFSET);
+        CExprPtr clause = make_shared<CBinaryOp>(idx, ">=", offset);
+        if (m_settings.type == InvarType::RoleBased)
+        {
+            for (auto role : m_roles)
+            {
+                auto term = make_shared<CBinaryOp>(role, "!=", idx);
+                clause = make_shared<CBinaryOp>(clause, "&&", term);
+            }
+        }
+
+        if (guards)
+        {
+            guards = make_shared<CBinaryOp>(guards, "||", clause);
+        }
+        else
+        {
+            guards = clause;
+        }
+    }
+    return guards;
+}
+
+// -------------------------------------------------------------------------- //
+
+CStmtPtr CompInvarGenerator::loop_interference(
+    MapData const& _map, NondetSourceRegistry &_nd_reg
+) const
+{
+    // Determines the entry at the current indices.
+    vector<shared_ptr<CIdentifier>> indices;
+    CExprPtr data = make_shared<CMemberAccess>(_map.path, "data");
+    for (size_t i = 0; i < _map.depth; ++i)
+    {
+        indices.push_back(make_shared<CIdentifier>("i_" + to_string(i), false));
+        data = make_shared<CIndexAccess>(data, indices.back());
+    }
+
+    // If possible, all entries are requested as a single batch. The entry at
+    // the current indices is then at their row-major offset. If entries are
+    // guarded, then only the entries which pass the guard are requested.
+    CBlockList outer;
+    CExprPtr ND;
+    auto const GUARD = index_guard(indices);
+    auto const WIDTH = m_stack->addresses()->count();
+    auto const MSG = _map.display + "::data";
+    size_t count = 1;
+    for (size_t i = 0; i < _map.depth; ++i) count *= WIDTH;
+    if (!GUARD && count > 1 && has_simple_type(*_map.base_type))
+    {
+        auto const& TYPE = *_map.base_type->annotation().type;
+        if (NondetSourceRegistry::is_batchable(TYPE))
+        {
+            auto batch = _nd_reg.raw_array(outer, TYPE, count, MSG);
+            CExprPtr offset = indices.front();
+            for (size_t i = 1; i < _map.depth; ++i)
+            {
+                auto width = make_shared<CIntLiteral>(WIDTH);
+                auto row = make_shared<CBinaryOp>(offset, "*", width);
+                offset = make_shared<CBinaryOp>(row, "+", indices[i]);
+            }
+            ND = NondetSourceRegistry::simple_elem(TYPE, *batch, offset);
+        }
+    }
+    if (!ND)
+    {
+        ND = _nd_reg.val(*_map.base_type, MSG);
+    }
+
+    // Updates the entry and then assumes the invariant.
+    CBlockList body;
+    body.push_back(make_shared<CAssign>(data, ND)->stmt());
+    apply_invariant(body, false, _map, extract_values(_map, data), {});
+
+    // Applies the role guard.
+    CStmtPtr stmt = make_shared<CBlock>(move(body));
+    if (GUARD)
+    {
+        stmt = make_shared<CIf>(GUARD, stmt);
+    }
+
+    // Generates a loop for each index, starting from the innermost loop.
+    for (size_t i = _map.depth; i > 0; --i)
+    {
+        auto const& IDX = indices[i - 1];
+        auto const NAME = "i_" + to_string(i - 1);
+        auto width = make_shared<CIntLiteral>(WIDTH);
+        stmt = make_shared<CForLoop>(
+            make_shared<CVarDecl>("uint64_t", NAME, false, Literals::ZERO),
+            make_shared<CBinaryOp>(IDX, "<", width),
+            make_shared<CUnaryOp>("++", IDX, true)->stmt(),
+            stmt
+        );
+    }
+
+    // Places the loops after the batch, if there is one.
+    if (outer.empty()) return stmt;
+    outer.push_back(stmt);
+    return make_shared<CBlock>(move(outer));
+}
+
+// -------------------------------------------------------------------------- //
+
+void CompInvarGenerator::select_entry(
+    CBlockList &_block,
+    MapData const& _map,
+    vector<shared_ptr<CVarDecl>> const& _vars,
+    NondetSourceRegistry &_nd_reg
+) const
+{
+    // Selects each index.
+    auto const WIDTH = m_stack->addresses()->count();
+    vector<shared_ptr<CIdentifier>> indices;
+    CExprPtr data = make_shared<CMemberAccess>(_map.path, "data");
+    for (size_t i = 0; i < _map.depth; ++i)
+    {
+        auto idx = make_shared<CVarDecl>("uint64_t", "i_" + to_string(i));
+        _block.push_back(idx);
+        _block.push_back(idx->assign(_nd_reg.range(0, WIDTH, "entry"))->stmt());
+        indices.push_back(idx->id());
+        data = make_shared<CIndexAccess>(data, indices.back());
+    }
+
+    // Applies role guards (concretization).
+    if (auto guard = index_guard(indices))
+    {
+        LibVerify::add_require(*m_stack, _block, guard, "Guard");
+    }
+
+    // Visits each field.
+    auto values = extract_values(_map, data);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        _block.push_back(_vars[i]->assign(values[i])->stmt());
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+vector<CExprPtr> CompInvarGenerator::extract_values(
+    MapData const& _map, CExprPtr _data
+) const
+{
+    vector<CExprPtr> values;
+    for (auto field : _map.fields)
+    {
+        auto data = _data;
+        for (auto id : field.path)
+        {
+            data = make_shared<CMemberAccess>(data, id);
+        }
+        values.push_back(make_shared<CMemberAccess>(data, "v"));
+    }
+    return values;
+}
+
+// -------------------------------------------------------------------------- //
+
 void CompInvarGenerator::apply_invariant(
     CBlockList &_block,
     bool _assert,
@@ -416,7 +644,8 @@ void CompInvarGenerator::apply_invariant(
         }
         else
         {
-            inv_chk = make_shared<CExprStmt>(LibVerify::make_require(inv_call));
+            auto req = LibVerify::make_require(*m_stack, inv_call);
+            inv_chk = make_shared<CExprStmt>(req);
         }
     }
 
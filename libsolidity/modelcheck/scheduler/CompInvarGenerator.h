@@ -8,6 +8,7 @@
 #pragma once
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/modelcheck/analysis/Mapping.h>
 #include <libsolidity/modelcheck/codegen/Details.h>
 #include <libsolidity/modelcheck/utils/KeyIterator.h>
 #include <libsolidity/modelcheck/utils/LibVerify.h>
@@ -62,6 +63,10 @@ public:
 
         // If true, then an invariant synthesis problem is generated.
         bool inferred = false;
+
+        // If true, then mappings are backed by arrays, and interference is
+        // applied through loops over each array, rather than by unrolling.
+        bool array_maps = false;
     };
 
     // Generates invariants for all contracts in _actors, that conform to the
@@ -99,6 +104,7 @@ private:
         TypeName const* base_type;
         MapFieldList fields;
         std::string display;
+        MapDeflate::Record record;
     };
     std::vector<MapData> m_maps;
 
@@ -129,11 +135,10 @@ private:
         VariableDeclaration const* _decl
     );
 
-    // Helper method to iterate over all indices of all mappings. For each
-    // entry, the provided function is applied to the mapping entry and the
-    // index summary. Note that literal users are filtered out.
+    // Helper method to iterate over all indices of a mapping. For each entry,
+    // the provided function is applied to the mapping entry and the index
+    // summary. Note that literal users are filtered out.
     using MapVisitor = std::function<void(MapData const&, KeyIterator const&)>;
-    void expand_maps(MapVisitor _f);
     void expand_map(MapData const&_map, MapVisitor _f);
 
     // Helper method to guard a statement with a role check. The statement is
@@ -141,6 +146,34 @@ private:
     // does not equate with any role.
     CStmtPtr guard(CStmtPtr _inst, std::vector<size_t> const& _indices) const;
 
+    // Helper method to guard an entry of an array-backed mapping. The indices
+    // are given by the variables _indices. The guard is analogous to that of
+    // guard() and expand_map(). If no guard is required, nullptr is returned.
+    CExprPtr index_guard(
+        std::vector<std::shared_ptr<CIdentifier>> const& _indices
+    ) const;
+
+    // Generates a loop nest over all entries of array-backed mapping _map. The
+    // entry at _indices is nondeterministically updated and then the invariant
+    // is assumed.
+    CStmtPtr loop_interference(
+        MapData const& _map, NondetSourceRegistry &_nd_reg
+    ) const;
+
+    // Selects an entry of array-backed mapping _map, and then copies each field
+    // of the entry into _vars. The statements are appended to _block.
+    void select_entry(
+        CBlockList &_block,
+        MapData const& _map,
+        std::vector<std::shared_ptr<CVarDecl>> const& _vars,
+        NondetSourceRegistry &_nd_reg
+    ) const;
+
+    // Returns the path to each field of _data, where _data is an entry of _map.
+    std::vector<CExprPtr> extract_values(
+        MapData const& _map, CExprPtr _data
+    ) const;
+
     // Applies the invariants of _map to _data. The application is appended to
     // _block. If _assert is set, then the invariant is asserted, otherwise it
     // is assumed.
@@ -0,0 +1,123 @@
+#include <libsolidity/modelcheck/scheduler/FuzzDictionary.h>
+
+#include <libsolidity/modelcheck/analysis/AbstractAddressDomain.h>
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/analysis/CallGraph.h>
+#include <libsolidity/modelcheck/analysis/StringLookup.h>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+FuzzDictionary::FuzzDictionary(
+    shared_ptr<AnalysisStack const> _stack, size_t _cases
+)
+{
+    // Transaction selectors, and then address selectors.
+    for (size_t i = 0; i < _cases; ++i)
+    {
+        add_byte("call_", i);
+    }
+    for (size_t i = 0; i < _stack->addresses()->count(); ++i)
+    {
+        add_byte("addr_", i);
+    }
+
+    // String literals. Note that 0 is reserved for the empty string.
+    for (uint32_t i = 1; i < _stack->strings()->count(); ++i)
+    {
+        add_word("str_", i);
+    }
+
+    // Integer literals.
+    for (auto function : _stack->calls()->executed_code())
+    {
+        function->accept(*this);
+    }
+    for (auto modifier : _stack->calls()->applied_modifiers())
+    {
+        modifier->accept(*this);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void FuzzDictionary::print(ostream& _stream) const
+{
+    for (auto const& entry : m_entries)
+    {
+        _stream << entry.first << "=\"";
+        for (unsigned char byte : entry.second)
+        {
+            _stream << "\\x" << hex << setw(2) << setfill('0') << (int)byte;
+        }
+        _stream << dec << "\"" << endl;
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void FuzzDictionary::endVisit(Literal const& _node)
+{
+    if (_node.token() != Token::Number) return;
+
+    auto type = dynamic_cast<RationalNumberType const*>(
+        _node.annotation().type
+    );
+    if (type && !type->isFractional())
+    {
+        add_word("num_", type->literalValue(&_node));
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void FuzzDictionary::add(string _name, string _value)
+{
+    if (m_seen.insert(_value).second)
+    {
+        m_entries.emplace_back(move(_name), move(_value));
+    }
+}
+
+void FuzzDictionary::add_byte(string const& _prefix, size_t _value)
+{
+    add(_prefix + to_string(_value), string(1, (char)(_value & 0xFF)));
+}
+
+void FuzzDictionary::add_word(string const& _prefix, u256 _value)
+{
+    string const NAME = _prefix + _value.str();
+
+    // Extracts the big-endian encoding of _value.
+    string word(32, '\0');
+    for (size_t i = 32; i > 0; --i)
+    {
+        word[i - 1] = (char)(unsigned)(_value & 0xFF);
+        _value >>= 8;
+    }
+
+    // The shortest encoding holds at least one byte.
+    size_t const START = min(word.find_first_not_of('\0'), size_t(31));
+    if (START > 0)
+    {
+        add(NAME + "_short", word.substr(START));
+    }
+    add(NAME, move(word));
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
@@ -0,0 +1,70 @@
+/**
+ * Generates a dictionary for libfuzzer. The dictionary is derived from values
+ * which the scheduler and the contracts are known to compare against, so that
+ * the fuzzer need not guess these values byte-by-byte.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+class AnalysisStack;
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Collects the entries of a libfuzzer dictionary. Each entry is encoded as the
+ * libfuzzer runtime decodes non-deterministic values. That is, a selector is a
+ * single byte, whereas an integer is a sequence of big-endian bytes.
+ */
+class FuzzDictionary : public ASTConstVisitor
+{
+public:
+    // Collects entries for each of the _cases transactions, each address of
+    // _stack, each string literal, and each integer literal in executed code.
+    FuzzDictionary(std::shared_ptr<AnalysisStack const> _stack, size_t _cases);
+
+    // Prints the dictionary in the libfuzzer format.
+    void print(std::ostream& _stream) const;
+
+protected:
+    void endVisit(Literal const& _node) override;
+
+private:
+    // The named entries, in order of discovery.
+    std::vector<std::pair<std::string, std::string>> m_entries;
+
+    // The encoding of each entry, so that duplicates are discarded.
+    std::set<std::string> m_seen;
+
+    // Adds _value as the entry _name, unless it is already in use.
+    void add(std::string _name, std::string _value);
+
+    // Adds a single byte entry for _value.
+    void add_byte(std::string const& _prefix, size_t _value);
+
+    // Adds entries for _value with the fewest bytes and with all 32 bytes.
+    void add_word(std::string const& _prefix, dev::u256 _value);
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
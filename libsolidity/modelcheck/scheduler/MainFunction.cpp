@@ -8,10 +8,12 @@
 #include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
 #include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
+#include <libsolidity/modelcheck/scheduler/FuzzDictionary.h>
 #include <libsolidity/modelcheck/utils/CallState.h>
 #include <libsolidity/modelcheck/utils/Contract.h>
 #include <libsolidity/modelcheck/utils/Function.h>
 #include <libsolidity/modelcheck/utils/LibVerify.h>
+#include <libsolidity/modelcheck/utils/Types.h>
 
 #include <set>
 
@@ -26,6 +28,12 @@ namespace modelcheck
 
 // -------------------------------------------------------------------------- //
 
+string const MainFunctionGenerator::CONTEXT_TYPE = "sol_model_ctx";
+string const MainFunctionGenerator::WORLD_TYPE = "sol_world";
+string const MainFunctionGenerator::WORLD_VAR = "world";
+
+// -------------------------------------------------------------------------- //
+
 MainFunctionGenerator::MainFunctionGenerator(
     bool _lockstep_time,
     CompInvarGenerator::Settings _settings,
@@ -33,11 +41,21 @@ MainFunctionGenerator::MainFunctionGenerator(
     shared_ptr<NondetSourceRegistry> _nd_reg
 ): m_stack(_stack)
  , m_nd_reg(_nd_reg)
- , m_addrspace(_stack->addresses(), _nd_reg)
- , m_stategen(_stack, _nd_reg, _lockstep_time)
+ , m_addrspace(_stack, _nd_reg)
+ , m_stategen(_stack, _nd_reg, m_addrspace, _lockstep_time)
  , m_actors(_stack, _nd_reg)
  , m_invars(_stack, m_actors, _settings)
 {
+    auto const& SETTINGS = m_stack->settings();
+    if (SETTINGS.reduce_order)
+    {
+        m_por = make_shared<PartialOrderReduction>(m_stack, m_actors);
+    }
+
+    // An empty context is not lifted, as C forbids empty structures.
+    m_reentrant = (SETTINGS.reentrant && !globals()->empty());
+    m_snapshots = SETTINGS.snapshots;
+    m_instrument = SETTINGS.instrument;
 }
 
 // -------------------------------------------------------------------------- //
@@ -51,7 +69,19 @@ void MainFunctionGenerator::print_invariants(ostream& _stream)
 
 void MainFunctionGenerator::print_globals(ostream& _stream)
 {
-    m_actors.declare_global(_stream);
+    auto decls = globals();
+    if (!m_reentrant)
+    {
+        for (auto decl : *decls) _stream << (*decl);
+        return;
+    }
+
+    // The context is owned by run_model. Each global is declared as lifted, so
+    // that its identifiers resolve to the field of the same name.
+    CStructDef context(CONTEXT_TYPE, decls);
+    _stream << context;
+    _stream << "static SOL_THREAD_LOCAL ";
+    _stream << (*context.decl(CIdentifier::CONTEXT_PTR, true));
 }
 
 // -------------------------------------------------------------------------- //
@@ -63,7 +93,9 @@ void MainFunctionGenerator::print_main(ostream& _stream)
 
     CBlockList default_case;
     string default_err("Model failure, next_call out of bounds.");
-    LibVerify::add_require(default_case, Literals::ZERO, default_err);
+    LibVerify::add_require(
+        *m_stack, default_case, Literals::ZERO, default_err
+    );
 
     size_t case_count = 0;
     auto call_cases = make_shared<CSwitch>(next_case->id(), move(default_case));
@@ -71,8 +103,9 @@ void MainFunctionGenerator::print_main(ostream& _stream)
     {
         for (auto const& spec : actor.specs)
         {
-            auto call_body = build_case(spec, actor.decl);
-            call_cases->add_case(call_cases->size(), move(call_body));
+            auto const CASE = call_cases->size();
+            auto call_body = build_case(spec, actor.decl, CASE);
+            call_cases->add_case(CASE, move(call_body));
             case_count += 1;
         }
     }
@@ -84,25 +117,59 @@ void MainFunctionGenerator::print_main(ostream& _stream)
 
     // Contract setup and tear-down.
     CBlockList main;
-    m_stategen.declare(main);
-    m_actors.declare(main);
-    m_addrspace.map_constants(main);
-    m_actors.assign_addresses(main);
-    m_actors.initialize(main, m_stategen);
+    if (m_reentrant)
+    {
+        auto ctx = make_shared<CVarDecl>("struct " + CONTEXT_TYPE, "model_ctx");
+        auto ptr = make_shared<CIdentifier>(CIdentifier::CONTEXT_PTR, true);
+        main.push_back(ctx);
+        main.push_back(ptr->assign(make_shared<CReference>(ctx->id()))->stmt());
+    }
+
+    CBlockList setup;
+    m_stategen.declare(setup);
+    m_addrspace.declare(setup);
+    m_actors.declare(setup);
+    m_addrspace.map_constants(setup);
+    m_actors.assign_addresses(setup);
+    m_actors.initialize(setup, m_stategen);
+    if (m_por)
+    {
+        m_por->declare(setup);
+    }
+
+    // If snapshots are enabled, setup is skipped when a world state is restored.
+    shared_ptr<CVarDecl> world;
+    shared_ptr<CParams> fields;
+    if (m_snapshots)
+    {
+        world = make_shared<CVarDecl>("struct " + WORLD_TYPE, WORLD_VAR);
+        fields = make_resumable(setup, main, world);
+    }
+    else
+    {
+        main.insert(main.end(), setup.begin(), setup.end());
+    }
 
     // Generates transactionals loop.
     CBlockList transactionals;
+    if (m_snapshots)
+    {
+        checkpoint(transactionals, *fields, world);
+    }
     transactionals.push_back(
         make_shared<CFuncCall>("sol_on_transaction", CArgList{})->stmt()
     );
-    transactionals.push_back(make_shared<CIf>(
-        make_shared<CFuncCall>("sol_can_infer", CArgList{}),
-        make_shared<CBlock>(m_invars.check_interference(*m_nd_reg))
-    ));
-    transactionals.push_back(make_shared<CIf>(
-        make_shared<CFuncCall>("sol_can_infer", CArgList{}),
-        make_shared<CBlock>(m_invars.apply_interference(*m_nd_reg))
-    ));
+    for (auto interference : {
+        m_invars.check_interference(*m_nd_reg),
+        m_invars.apply_interference(*m_nd_reg)
+    })
+    {
+        if (interference.empty()) continue;
+        transactionals.push_back(make_shared<CIf>(
+            make_shared<CFuncCall>("sol_can_infer", CArgList{}),
+            make_shared<CBlock>(move(interference))
+        ));
+    }
     m_stategen.update_global(transactionals);
     transactionals.push_back(next_case);
     transactionals.push_back(next_case->assign(
@@ -119,17 +186,140 @@ void MainFunctionGenerator::print_main(ostream& _stream)
     ));
 
     // Implements body as a run_model function.
+    if (m_snapshots)
+    {
+        _stream << CStructDef(WORLD_TYPE, fields);
+    }
     auto id = make_shared<CVarDecl>("void", "run_model");
     _stream << CFuncDef(id, CParams{}, make_shared<CBlock>(move(main)));
 }
 
 // -------------------------------------------------------------------------- //
 
+void MainFunctionGenerator::print_dictionary(ostream& _stream)
+{
+    size_t case_count = 0;
+    for (auto actor : m_actors.inspect())
+    {
+        case_count += actor.specs.size();
+    }
+
+    FuzzDictionary(m_stack, case_count).print(_stream);
+}
+
+// -------------------------------------------------------------------------- //
+
+shared_ptr<CParams> MainFunctionGenerator::globals() const
+{
+    auto decls = make_shared<CParams>();
+    m_addrspace.declare_literals(*decls);
+    m_actors.declare_global(*decls);
+    return decls;
+}
+
+// -------------------------------------------------------------------------- //
+
+shared_ptr<CParams> MainFunctionGenerator::make_resumable(
+    CBlockList & _main,
+    CBlockList & _body,
+    shared_ptr<CVarDecl> _world
+) const
+{
+    // Pointers into the state of a past run would dangle, so they are never
+    // part of the world. Instead, they are recomputed after each restore.
+    auto fields = make_shared<CParams>();
+    auto add_field = [&fields](shared_ptr<CVarDecl> _decl)
+    {
+        if (!_decl->id()->is_pointer()) fields->push_back(_decl);
+    };
+
+    // The world includes the globals, unless they are held by the context.
+    if (!m_reentrant)
+    {
+        auto const GLOBALS = globals();
+        for (auto decl : *GLOBALS) add_field(decl);
+    }
+
+    // The existing locals of _body are also part of the world.
+    for (auto stmt : _body)
+    {
+        if (auto decl = dynamic_pointer_cast<CVarDecl>(stmt))
+        {
+            add_field(decl);
+        }
+    }
+
+    // Declarations are hoisted before setup. As declarations of setup are not
+    // initialized, this does not change the meaning of setup.
+    CBlockList setup;
+    for (auto stmt : _main)
+    {
+        if (auto decl = dynamic_pointer_cast<CVarDecl>(stmt))
+        {
+            add_field(decl);
+            _body.push_back(decl);
+        }
+        else
+        {
+            setup.push_back(stmt);
+        }
+    }
+    _body.push_back(_world);
+
+    // Otherwise, each field is restored from the world.
+    CBlockList restore;
+    for (auto field : *fields)
+    {
+        auto val = _world->access(field->name());
+        restore.push_back(field->id()->assign(val)->stmt());
+    }
+    m_actors.assign_paths(restore);
+
+    _body.push_back(make_shared<CIf>(
+        make_shared<CFuncCall>("SOL_RESTORE", CArgList{_world->id()}),
+        make_shared<CBlock>(move(restore)),
+        make_shared<CBlock>(move(setup))
+    ));
+
+    return fields;
+}
+
+// -------------------------------------------------------------------------- //
+
+void MainFunctionGenerator::checkpoint(
+    CBlockList & _block,
+    CParams const& _fields,
+    shared_ptr<CVarDecl> _world
+)
+{
+    for (auto field : _fields)
+    {
+        auto dst = _world->access(field->name());
+        _block.push_back(dst->assign(field->id())->stmt());
+    }
+    _block.push_back(
+        make_shared<CFuncCall>("SOL_CHECKPOINT", CArgList{_world->id()})->stmt()
+    );
+}
+
+// -------------------------------------------------------------------------- //
+
 CBlockList MainFunctionGenerator::build_case(
-    FunctionSpecialization const& _spec, shared_ptr<CVarDecl const> _id
+    FunctionSpecialization const& _spec,
+    shared_ptr<CVarDecl const> _id,
+    size_t _case
 )
 {
     CBlockList call_body;
+    if (m_instrument)
+    {
+        LibVerify::add_cover_call(call_body, _case);
+    }
+    if (m_por)
+    {
+        m_por->canonicalize(call_body, _case);
+    }
+
     CExprPtr id = _id->id();
     if (!id->is_pointer())
     {
@@ -159,12 +349,60 @@ CBlockList MainFunctionGenerator::build_case(
         call_builder.push(make_shared<CReference>(output->id()));
     }
 
+    // Requests a value for each named input. Consecutive inputs with the same
+    // raw type are requested as a single batch.
+    auto const& PARAMS = _spec.func().parameters();
+    auto batches_with = [&PARAMS](size_t _i, size_t _j) {
+        auto const& LHS = *PARAMS[_i]->type();
+        auto const& RHS = *PARAMS[_j]->type();
+        return !PARAMS[_j]->name().empty()
+            && NondetSourceRegistry::is_batchable(RHS)
+            && simple_bit_count(LHS) == simple_bit_count(RHS)
+            && simple_is_signed(LHS) == simple_is_signed(RHS);
+    };
+
+    vector<CExprPtr> values(PARAMS.size());
+    for (size_t i = 0; i < PARAMS.size(); ++i)
+    {
+        auto const& ARG = *PARAMS[i];
+        if (ARG.name().empty()) continue;
+
+        size_t end = i + 1;
+        if (NondetSourceRegistry::is_batchable(*ARG.type()))
+        {
+            while (end < PARAMS.size() && batches_with(i, end)) ++end;
+        }
+
+        if (end - i < 2)
+        {
+            values[i] = m_nd_reg->val(ARG, ARG.name());
+            continue;
+        }
+
+        string msg = ARG.name();
+        for (size_t j = i + 1; j < end; ++j)
+        {
+            msg += "," + PARAMS[j]->name();
+        }
+
+        auto batch = m_nd_reg->raw_array(call_body, *ARG.type(), end - i, msg);
+        for (size_t j = i; j < end; ++j)
+        {
+            values[j] = NondetSourceRegistry::simple_elem(
+                *PARAMS[j]->type(), *batch, make_shared<CIntLiteral>(j - i)
+            );
+        }
+        i = end - 1;
+    }
+
     size_t placeholder_count = 0;
-    for (auto const arg : _spec.func().parameters())
+    for (size_t i = 0; i < PARAMS.size(); ++i)
     {
+        auto const& arg = PARAMS[i];
+
         // Handles the case of unnamed (i.e., unused) inputs.
         string argname;
-        CExprPtr value = nullptr;
+        CExprPtr value = values[i];
         if (arg->name().empty())
         {
             argname = "placeholder_" + to_string(placeholder_count);
@@ -173,7 +411,6 @@ CBlockList MainFunctionGenerator::build_case(
         else
         {
             argname = "arg_" + arg->name();
-            value = m_nd_reg->val(*arg, arg->name());
         }
 
         auto input = make_shared<CVarDecl>(
@@ -181,6 +418,10 @@ CBlockList MainFunctionGenerator::build_case(
         );
 
         call_body.push_back(input);
+        if (value && arg->type()->category() == Type::Category::Address)
+        {
+            m_addrspace.canonicalize(call_body, input->id()->access("v"));
+        }
         call_builder.push(input->id());
     }
 
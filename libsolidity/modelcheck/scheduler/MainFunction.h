@@ -13,6 +13,7 @@
 #include <libsolidity/modelcheck/scheduler/ActorModel.h>
 #include <libsolidity/modelcheck/scheduler/AddressSpace.h>
 #include <libsolidity/modelcheck/scheduler/CompInvarGenerator.h>
+#include <libsolidity/modelcheck/scheduler/PartialOrderReduction.h>
 #include <libsolidity/modelcheck/scheduler/StateGenerator.h>
 
 #include <memory>
@@ -39,6 +40,8 @@ class MainFunctionGenerator
 {
 public:
     // Constructs a printer for all function forward decl's required by the ast.
+    // The scheduling options (e.g., reduce_order, reentrant, snapshots) are
+    // taken from the settings of _stack.
     MainFunctionGenerator(
         bool _lockstep_time,
         CompInvarGenerator::Settings _settings,
@@ -49,13 +52,24 @@ public:
     // Declares are invariants used by the bundle.
     void print_invariants(std::ostream& _stream);
 
-    // Prints global declarations.
+    // Prints global declarations. In reentrant mode, this instead prints the
+    // context type, and redirects each global to the context of this thread.
     void print_globals(std::ostream& _stream);
 
     // Prints the main function.
     void print_main(std::ostream& _stream);
 
+    // Prints a libfuzzer dictionary for the transactions of the main function.
+    void print_dictionary(std::ostream& _stream);
+
 private:
+    // The type of the model context (see CIdentifier::CONTEXT_PTR).
+    static std::string const CONTEXT_TYPE;
+
+    // The type of the world state, and the snapshot of the running model.
+    static std::string const WORLD_TYPE;
+    static std::string const WORLD_VAR;
+
     // Analysis results.
     std::shared_ptr<AnalysisStack const> m_stack;
 
@@ -74,11 +88,47 @@ private:
     // Stores data to generate compositional invariants.
     CompInvarGenerator m_invars;
 
+    // Stores data to constrain transaction order, if enabled.
+    std::shared_ptr<PartialOrderReduction> m_por;
+
+    // If true, all globals are lifted into a model context.
+    bool m_reentrant;
+
+    // If true, the world state is snapshot at each transaction boundary.
+    bool m_snapshots;
+
+    // If true, each transaction is marked for coverage.
+    bool m_instrument;
+
+    // Returns the declaration of each global.
+    std::shared_ptr<CParams> globals() const;
+
+    // Splits the setup of run_model, _main, into declarations and statements.
+    // The declarations are moved to _body, and the statements are guarded by
+    // an attempt to restore the world state. The fields of the world state are
+    // returned, with _world as the snapshot of the current run. Pointers are
+    // not fields, and are instead reassigned upon restoration.
+    std::shared_ptr<CParams> make_resumable(
+        CBlockList & _main,
+        CBlockList & _body,
+        std::shared_ptr<CVarDecl> _world
+    ) const;
+
+    // Appends to _block the statements to copy each of _fields into _world, and
+    // then to checkpoint _world.
+    static void checkpoint(
+        CBlockList & _block,
+        CParams const& _fields,
+        std::shared_ptr<CVarDecl> _world
+    );
+
     // For each method on each contract, this will generate a case for the
     // switch block. Note that _args have been initialized first by
-    // analyze_decls.
+    // analyze_decls. The case is labeled by _case.
     CBlockList build_case(
-        FunctionSpecialization const& _spec, std::shared_ptr<CVarDecl const> _id
+        FunctionSpecialization const& _spec,
+        std::shared_ptr<CVarDecl const> _id,
+        size_t _case
     );
 
     // Helper method to format and log a call selection. The log statement is
@@ -0,0 +1,118 @@
+#include <libsolidity/modelcheck/scheduler/PartialOrderReduction.h>
+
+#include <libsolidity/modelcheck/analysis/Inheritance.h>
+#include <libsolidity/modelcheck/analysis/StateFootprint.h>
+#include <libsolidity/modelcheck/scheduler/ActorModel.h>
+#include <libsolidity/modelcheck/utils/Function.h>
+#include <libsolidity/modelcheck/utils/LibVerify.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+// -------------------------------------------------------------------------- //
+
+string const PartialOrderReduction::LAST_CALL = "last_call";
+
+// -------------------------------------------------------------------------- //
+
+PartialOrderReduction::PartialOrderReduction(
+    shared_ptr<AnalysisStack const> _stack, ActorModel const& _actors
+): m_stack(move(_stack))
+{
+    // Summarizes each transaction, in scheduler order.
+    vector<size_t> owners;
+    vector<StateFootprint> footprints;
+    auto const& actors = _actors.inspect();
+    for (size_t i = 0; i < actors.size(); ++i)
+    {
+        for (auto const& spec : actors[i].specs)
+        {
+            owners.push_back(i);
+            footprints.emplace_back(*actors[i].contract, spec.func());
+        }
+    }
+
+    // Transactions on distinct actors share no state variables.
+    m_successors.resize(footprints.size());
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+        for (size_t j = i + 1; j < footprints.size(); ++j)
+        {
+            bool const SHARED = (owners[i] == owners[j]);
+            if (!footprints[i].conflicts(footprints[j], SHARED))
+            {
+                m_successors[i].push_back(j);
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void PartialOrderReduction::declare(CBlockList & _block) const
+{
+    // No transaction is indexed by size().
+    auto init = make_shared<CIntLiteral>(size());
+    auto decl = make_shared<CVarDecl>("uint8_t", LAST_CALL);
+    _block.push_back(decl);
+    _block.push_back(decl->assign(init)->stmt());
+}
+
+// -------------------------------------------------------------------------- //
+
+void PartialOrderReduction::canonicalize(CBlockList & _block, size_t _case) const
+{
+    CExprPtr cond;
+    for (auto succ : m_successors[_case])
+    {
+        auto lit = make_shared<CIntLiteral>(succ);
+        auto check = make_shared<CBinaryOp>(last_call(), "!=", lit);
+        cond = (cond ? make_shared<CBinaryOp>(cond, "&&", check) : check);
+    }
+
+    if (cond)
+    {
+        string const MSG = "Non-canonical transaction order.";
+        LibVerify::add_require(*m_stack, _block, cond, MSG);
+    }
+
+    auto lit = make_shared<CIntLiteral>(_case);
+    _block.push_back(last_call()->assign(lit)->stmt());
+}
+
+// -------------------------------------------------------------------------- //
+
+size_t PartialOrderReduction::size() const
+{
+    return m_successors.size();
+}
+
+// -------------------------------------------------------------------------- //
+
+bool PartialOrderReduction::commutes(size_t _i, size_t _j) const
+{
+    if (_i > _j) return commutes(_j, _i);
+    auto const& succ = m_successors[_i];
+    return (find(succ.begin(), succ.end(), _j) != succ.end());
+}
+
+// -------------------------------------------------------------------------- //
+
+shared_ptr<CIdentifier> PartialOrderReduction::last_call()
+{
+    return make_shared<CIdentifier>(LAST_CALL, false);
+}
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
@@ -0,0 +1,73 @@
+/**
+ * Generates ordering constraints over the transactions of the scheduler. If two
+ * consecutive transactions commute, then only one of their orders is explored.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <libsolidity/modelcheck/codegen/Details.h>
+
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+
+class ActorModel;
+class AnalysisStack;
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * Implements a sleep-set style reduction over the `next_call` selector. Each
+ * transaction is numbered in the order that it appears in the scheduler. If
+ * transaction j commutes with transaction i, and j > i, then i may not follow
+ * j. Every trace of the unreduced model is equivalent (up to reordering of
+ * commuting neighbours) to some trace of the reduced model.
+ */
+class PartialOrderReduction
+{
+public:
+    // Computes the dependencies between all transactions of _actors. The
+    // requires are labeled through _stack.
+    PartialOrderReduction(
+        std::shared_ptr<AnalysisStack const> _stack, ActorModel const& _actors
+    );
+
+    // Appends the declaration of the last transaction to _block.
+    void declare(CBlockList & _block) const;
+
+    // Appends statements to _block, which reject transaction _case if it does
+    // not occur in canonical order. The transaction is then recorded.
+    void canonicalize(CBlockList & _block, size_t _case) const;
+
+    // Returns the number of transactions.
+    size_t size() const;
+
+    // Returns true if transactions _i and _j commute.
+    bool commutes(size_t _i, size_t _j) const;
+
+private:
+    // The variable name used to record the last transaction.
+    static std::string const LAST_CALL;
+
+    std::shared_ptr<AnalysisStack const> m_stack;
+
+    // Maps each transaction to all larger transactions it commutes with.
+    std::vector<std::vector<size_t>> m_successors;
+
+    // Helper method to return an identifier for the last transaction.
+    static std::shared_ptr<CIdentifier> last_call();
+};
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
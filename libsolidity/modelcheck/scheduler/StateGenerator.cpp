@@ -5,6 +5,7 @@
 #include <libsolidity/modelcheck/analysis/CallState.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
 #include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
+#include <libsolidity/modelcheck/scheduler/AddressSpace.h>
 #include <libsolidity/modelcheck/utils/CallState.h>
 
 #include <memory>
@@ -27,8 +28,12 @@ const string StateGenerator::LAST_SENDER = "last_sender";
 StateGenerator::StateGenerator(
     shared_ptr<AnalysisStack const> _stack,
     shared_ptr<NondetSourceRegistry> _nd_reg,
+    AddressSpace const& _addrspace,
     bool _use_lockstep_time
-): M_USE_LOCKSTEP_TIME(_use_lockstep_time), m_stack(_stack), m_nd_reg(_nd_reg)
+): M_USE_LOCKSTEP_TIME(_use_lockstep_time)
+ , m_stack(_stack)
+ , m_nd_reg(_nd_reg)
+ , m_addrspace(_addrspace)
 {
 }
 
@@ -150,6 +155,7 @@ void StateGenerator::update_local(CBlockList & _block) const
         {
             auto last = make_shared<CIdentifier>(LAST_SENDER, false);
             auto curr = decl->id()->access("v");
+            m_addrspace.canonicalize(_block, curr);
             _block.push_back(last->access("v")->assign(curr)->stmt());
         }
     }
@@ -18,6 +18,7 @@ namespace solidity
 namespace modelcheck
 {
 
+class AddressSpace;
 class AnalysisStack;
 class MapIndexSummary;
 class NondetSourceRegistry;
@@ -30,9 +31,11 @@ class NondetSourceRegistry;
 class StateGenerator
 {
 public:
+    // Senders are selected from the users of _addrspace.
     StateGenerator(
         std::shared_ptr<AnalysisStack const> _stack,
         std::shared_ptr<NondetSourceRegistry> _nd_reg,
+        AddressSpace const& _addrspace,
         bool _use_lockstep_time
     );
 
@@ -42,7 +45,8 @@ public:
     // Generate the instructions required to update the call state.
     void update_global(CBlockList & _block) const;
 
-    //
+    // Generates the instructions required to select a new sender and message.
+    // The sender is canonicalized by the address space.
     void update_local(CBlockList & _block) const;
 
     // Generates a value for a payable method.
@@ -58,6 +62,8 @@ private:
     std::shared_ptr<AnalysisStack const> m_stack;
 
     std::shared_ptr<NondetSourceRegistry> m_nd_reg;
+
+    AddressSpace const& m_addrspace;
 };
 
 // -------------------------------------------------------------------------- //
@@ -142,6 +142,16 @@ CExprPtr InitFunction::wrap(Type const& _type, CExprPtr _expr)
     return _expr;
 }
 
+CExprPtr InitFunction::unwrap(Type const& _type, CExprPtr _expr)
+{
+    if (is_wrapped_type(_type))
+    {
+        string const WRAP = PREFIX + TypeAnalyzer::get_simple_ctype(_type);
+        return make_shared<CMemberAccess>(move(_expr), "v", WRAP);
+    }
+    return _expr;
+}
+
 InitFunction::InitFunction(string _name, string _type)
  : M_NAME(move(_name)), M_TYPE(move(_type))
 {
@@ -96,6 +96,11 @@ public:
     // against _expr. Otherwise, _expr is returned unmodified.
     static CExprPtr wrap(Type const& _type, CExprPtr _expr);
 
+    // For a simple type, _type, this returns the value of _expr, (_expr).v,
+    // such that wrap(_type, unwrap(_type, _expr)) simplifies to _expr.
+    // Otherwise, _expr is returned unmodified.
+    static CExprPtr unwrap(Type const& _type, CExprPtr _expr);
+
     // The variable name reserved for initializers to set return values by ref.
     static std::string const INIT_VAR;
 
@@ -72,6 +72,13 @@ vector<size_t> const& KeyIterator::view() const
 
 // -------------------------------------------------------------------------- //
 
+size_t KeyIterator::ordinal() const
+{
+    return m_ordinal;
+}
+
+// -------------------------------------------------------------------------- //
+
 bool KeyIterator::next()
 {
     if (M_WIDTH == 0 || M_DEPTH == 0)
@@ -81,15 +88,20 @@ bool KeyIterator::next()
     else if (!is_at_max())
     {
         m_indices.push_back(0);
+        m_ordinal *= M_WIDTH;
     }
     else
     {
         ++m_indices.back();
+        ++m_ordinal;
         while (m_indices.back() == M_WIDTH)
         {
+            // The ordinal of the prefix is one less than the overflowed value.
             m_indices.pop_back();
+            m_ordinal = m_ordinal / M_WIDTH - 1;
             if (m_indices.empty()) break;
             ++m_indices.back();
+            ++m_ordinal;
         }
     }
 
@@ -48,6 +48,11 @@ public:
     // Returns call indices.
     std::vector<size_t> const& view() const;
 
+    // Returns the position of the current string, among all strings of the
+    // same length, in lexicographical order. This is a dense ordinal over all
+    // full strings, and is maintained incrementally by next().
+    size_t ordinal() const;
+
     // Advances indices. Returns true if one or more valid suffixes remain.
     bool next();
     
@@ -64,6 +69,9 @@ private:
     // - The stl vector does not deallocate memory so all operations are O(1).
     // - This is more efficient than a list, as it does not require allocations.
     std::vector<size_t> m_indices;
+
+    // The ordinal of the current string.
+    size_t m_ordinal = 0;
 };
 
 // -------------------------------------------------------------------------- //
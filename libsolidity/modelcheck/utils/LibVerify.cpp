@@ -7,7 +7,9 @@
 
 #include <libsolidity/modelcheck/utils/LibVerify.h>
 
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
 #include <libsolidity/modelcheck/codegen/Literals.h>
+#include <libsolidity/modelcheck/utils/Types.h>
 
 #include <memory>
 
@@ -28,9 +30,17 @@ IntegerType LibVerify::INCR_TYPE(256, IntegerType::Modifier::Unsigned);
 
 // -------------------------------------------------------------------------- //
 
-CExprPtr LibVerify::make_require(CExprPtr _cond, string _msg)
+CExprPtr LibVerify::make_require(
+    AnalysisStack const& _stack, CExprPtr _cond, string _msg
+)
 {
-    return make_property("sol_require", _cond, _msg);
+    if (!_stack.settings().instrument)
+    {
+        return make_property("sol_require", _cond, _msg);
+    }
+
+    auto site = make_shared<CIntLiteral>(_stack.next_site());
+    return make_property("SOL_REQUIRE", _cond, _msg, site);
 }
 
 CExprPtr LibVerify::make_assert(CExprPtr _cond, string _msg)
@@ -43,9 +53,34 @@ void LibVerify::add_assert(CBlockList & _block, CExprPtr _cond, string _msg)
     add_property("sol_assert", _block, _cond, _msg);
 }
 
-void LibVerify::add_require(CBlockList & _block, CExprPtr _cond, string _msg)
+void LibVerify::add_require(
+    AnalysisStack const& _stack,
+    CBlockList & _block,
+    CExprPtr _cond,
+    string _msg
+)
 {
-    add_property("sol_require", _block, _cond, _msg);
+    auto require = make_require(_stack, move(_cond), move(_msg));
+    _block.push_back(make_shared<CExprStmt>(move(require)));
+}
+
+CExprPtr LibVerify::make_assume(AnalysisStack const& _stack, CExprPtr _cond)
+{
+    if (!_stack.settings().instrument)
+    {
+        return make_shared<CFuncCall>("ll_assume", CArgList{_cond});
+    }
+
+    auto site = make_shared<CIntLiteral>(_stack.next_site());
+    return make_shared<CFuncCall>("SOL_ASSUME", CArgList{site, _cond});
+}
+
+void LibVerify::add_assume(
+    AnalysisStack const& _stack, CBlockList & _block, CExprPtr _cond
+)
+{
+    auto assume = make_assume(_stack, move(_cond));
+    _block.push_back(make_shared<CExprStmt>(move(assume)));
 }
 
 CExprPtr LibVerify::range(
@@ -96,6 +131,37 @@ CExprPtr LibVerify::increase(
     return builder.merge_and_pop();
 }
 
+CExprPtr LibVerify::exp(Type const& _type, CExprPtr _base, CExprPtr _exp)
+{
+    string const NAME = "sol_exp_u" + to_string(simple_bit_count(_type));
+    return make_shared<CFuncCall>(NAME, CArgList{_base, _exp});
+}
+
+CExprPtr LibVerify::shift_right(
+    Type const& _type, CExprPtr _val, CExprPtr _shift
+)
+{
+    string name = simple_is_signed(_type) ? "sol_sar_i" : "sol_shr_u";
+    name += to_string(simple_bit_count(_type));
+    return make_shared<CFuncCall>(name, CArgList{_val, _shift});
+}
+
+CExprPtr LibVerify::checked(
+    string const& _op, Type const& _type, CExprPtr _lhs, CExprPtr _rhs
+)
+{
+    string name = "sol_checked_" + _op + "_u";
+    name += to_string(simple_bit_count(_type));
+    return make_shared<CFuncCall>(name, CArgList{_lhs, _rhs});
+}
+
+void LibVerify::add_cover_call(CBlockList & _block, size_t _case)
+{
+    CArgList arglist{ make_shared<CIntLiteral>(_case) };
+    auto fn = make_shared<CFuncCall>("SOL_COVER_CALL", move(arglist));
+    _block.push_back(fn->stmt());
+}
+
 void LibVerify::add_property(
     string _op, CBlockList & _block, CExprPtr _cond, string _msg
 )
@@ -103,7 +169,9 @@ void LibVerify::add_property(
     _block.push_back(make_shared<CExprStmt>(make_property(_op, _cond, _msg)));
 }
 
-CExprPtr LibVerify::make_property(string _op, CExprPtr _cond, string _msg)
+CExprPtr LibVerify::make_property(
+    string _op, CExprPtr _cond, string _msg, CExprPtr _site
+)
 {
     CExprPtr msg_param;
     if (_msg.empty())
@@ -114,6 +182,11 @@ CExprPtr LibVerify::make_property(string _op, CExprPtr _cond, string _msg)
     {
         msg_param = make_shared<CStringLiteral>(_msg);
     }
+
+    if (_site)
+    {
+        return make_shared<CFuncCall>(_op, CArgList{_site, _cond, msg_param});
+    }
     return make_shared<CFuncCall>(_op, CArgList{_cond, msg_param});
 }
 
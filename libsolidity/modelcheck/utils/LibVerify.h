@@ -19,6 +19,8 @@ namespace solidity
 namespace modelcheck
 {
 
+class AnalysisStack;
+
 // -------------------------------------------------------------------------- //
 
 /**
@@ -33,19 +35,37 @@ public:
     // The type of ND_GET_INCREASE.
     static IntegerType INCR_TYPE;
 
-    // Generates a call to `sol_require(<_cond>, <_msg>)`.
-    static CExprPtr make_require(CExprPtr _cond, std::string _msg = "");
+    // Generates a call to `sol_require(<_cond>, <_msg>)`. If _stack is
+    // instrumented, then the require is labeled by a new site of _stack, as
+    // `SOL_REQUIRE(<site>, <_cond>, <_msg>)`.
+    static CExprPtr make_require(
+        AnalysisStack const& _stack, CExprPtr _cond, std::string _msg = ""
+    );
 
     // Generates a call to `sol_assert(<_cond>, <_msg>)`.
     static CExprPtr make_assert(CExprPtr _cond, std::string _msg = "");
 
-    // Appends to _block a call to `sol_require(<_cond>, <_msg>)`.
+    // Appends to _block a call to `sol_assert(<_cond>, <_msg>)`.
     static void
         add_assert(CBlockList & _block, CExprPtr _cond, std::string _msg = "");
 
-    // Appends to _block a call to `sol_assert(<_cond>, <_msg>)`.
-    static void
-        add_require(CBlockList & _block, CExprPtr _cond, std::string _msg = "");
+    // Appends to _block the require of make_require(_stack, _cond, _msg).
+    static void add_require(
+        AnalysisStack const& _stack,
+        CBlockList & _block,
+        CExprPtr _cond,
+        std::string _msg = ""
+    );
+
+    // Generates a call to `ll_assume(<_cond>)`. If _stack is instrumented, then
+    // the assumption is labeled by a new site of _stack, as
+    // `SOL_ASSUME(<site>, <_cond>)`.
+    static CExprPtr make_assume(AnalysisStack const& _stack, CExprPtr _cond);
+
+    // Appends to _block the assumption of make_assume(_stack, _cond).
+    static void add_assume(
+        AnalysisStack const& _stack, CBlockList & _block, CExprPtr _cond
+    );
 
     // Produces a range between two values.
     static CExprPtr range(
@@ -63,15 +83,37 @@ public:
         size_t _loc, CExprPtr _curr, bool _strict, std::string _msg
     );
 
+    // Generates `sol_exp_u<N>(<_base>, <_exp>)`, where N is the width of _type.
+    static CExprPtr exp(Type const& _type, CExprPtr _base, CExprPtr _exp);
+
+    // Generates `sol_shr_u<N>(<_val>, <_shift>)`, where N is the width of
+    // _type. If _type is signed, then `sol_sar_i<N>` is used instead.
+    static CExprPtr
+        shift_right(Type const& _type, CExprPtr _val, CExprPtr _shift);
+
+    // Generates `sol_checked_<_op>_u<N>(<_lhs>, <_rhs>)`, where N is the width
+    // of _type, and _op is a SafeMath operation.
+    static CExprPtr checked(
+        std::string const& _op, Type const& _type, CExprPtr _lhs, CExprPtr _rhs
+    );
+
+    // Appends to _block a coverage marker for transaction _case.
+    static void add_cover_call(CBlockList & _block, size_t _case);
+
 private:
     // Appends to _block a call to `<_op>(<_cond>, <_msg>)`.
     static void add_property(
         std::string _op, CBlockList & _block, CExprPtr _cond, std::string _msg
     );
 
-    // Returns a call to `<_op>(<_cond>, <_msg>)`.
-    static CExprPtr
-        make_property(std::string _op, CExprPtr _cond, std::string _msg);
+    // Returns a call to `<_op>(<_cond>, <_msg>)`. If _site is given, then the
+    // call is instead `<_op>(<_site>, <_cond>, <_msg>)`.
+    static CExprPtr make_property(
+        std::string _op,
+        CExprPtr _cond,
+        std::string _msg,
+        CExprPtr _site = nullptr
+    );
 };
 
 // -------------------------------------------------------------------------- //
@@ -32,6 +32,24 @@ string PrimitiveToRaw::address()
 
 // -------------------------------------------------------------------------- //
 
+void PrimitiveToRaw::unwrap(ostream & _os, bool _enable)
+{
+    _os.iword(unwrap_index()) = (_enable ? 1 : 0);
+}
+
+bool PrimitiveToRaw::is_unwrapped(ostream & _os)
+{
+    return (_os.iword(unwrap_index()) != 0);
+}
+
+int PrimitiveToRaw::unwrap_index()
+{
+    static int const INDEX = ios_base::xalloc();
+    return INDEX;
+}
+
+// -------------------------------------------------------------------------- //
+
 }
 }
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <ostream>
 #include <string>
 
 namespace dev
@@ -34,6 +35,19 @@ public:
 
     // Returns the raw type used to represent addresses.
     static std::string address();
+
+    // If _enable is set, each primitive type printed to _os is declared as a
+    // typedef of its raw type, rather than as a singleton structure. Accesses
+    // to the value of a primitive (the member v) then print as the primitive
+    // itself.
+    static void unwrap(std::ostream & _os, bool _enable);
+
+    // Returns true if primitive types printed to _os are declared as typedefs.
+    static bool is_unwrapped(std::ostream & _os);
+
+private:
+    // Returns the index of the unwrapping flag for each stream.
+    static int unwrap_index();
 };
 
 // -------------------------------------------------------------------------- //
@@ -5,9 +5,29 @@
 
 #pragma once
 
+#include <stddef.h>
+
 // Macro for ghost variable autoinstrumentation.
 #define GHOST_VAR 
 
+// Storage class for mutable state in the model and its runtime. If the model is
+// reentrant, then each thread runs its own instance of the model.
+#ifdef MC_USE_REENTRANT
+    #ifdef __cplusplus
+    #define SOL_THREAD_LOCAL thread_local
+    #else
+    #define SOL_THREAD_LOCAL _Thread_local
+    #endif
+#else
+#define SOL_THREAD_LOCAL
+#endif
+
+// Applies F to each native Solidity bit-width.
+#define SOL_WIDTHS(F) \
+    F(8) F(16) F(24) F(32) F(40) F(48) F(56) F(64) F(72) F(80) F(88) F(96) \
+    F(104) F(112) F(120) F(128) F(136) F(144) F(152) F(160) F(168) F(176) \
+    F(184) F(192) F(200) F(208) F(216) F(224) F(232) F(240) F(248) F(256)
+
 // Switches interger implementations based on preprocessor flags.
 #ifdef MC_USE_BOOST_MP
     #ifndef __cplusplus
@@ -86,6 +106,20 @@ typedef BOOST_UINT(248) sol_raw_uint248_t;
 typedef BOOST_INT(256) sol_raw_int256_t;
 typedef BOOST_UINT(256) sol_raw_uint256_t;
 #define SOL_UINT256_MAX sol_raw_uint256_t("0xFFFFFFFFFFFFFFFF")
+// The out-of-line members of each integer type are instantiated once, by
+// verify_boost.cpp, rather than by every translation unit of the model.
+#define BOOST_MP_MEMBERS(PREFIX, T) \
+    PREFIX template std::string T::str( \
+        std::streamsize, std::ios_base::fmtflags) const; \
+    PREFIX template int T::compare(T const&) const; \
+    PREFIX template bool T::is_zero() const; \
+    PREFIX template int T::sign() const;
+#define BOOST_MP_EXTERN(BITS) \
+    BOOST_MP_MEMBERS(extern, BOOST_INT(BITS)) \
+    BOOST_MP_MEMBERS(extern, BOOST_UINT(BITS))
+#ifndef MC_INSTANTIATE_BOOST_MP
+SOL_WIDTHS(BOOST_MP_EXTERN)
+#endif
 #elif defined MC_USE_STDINT
 #include <stdint.h>
 // TODO(scottwe): this should be 256 but we don't support it.
@@ -161,6 +195,39 @@ typedef uint64_t sol_raw_uint256_t;
 // Overapproximation of keccak256.
 sol_raw_uint8_t sol_crypto(void);
 
+// Hooks for models generated with --native-crypto. The input to keccak256 is
+// built from __state, by appending the low __bytes bytes of each __val in
+// big-endian order. If __signed, then __val is sign-extended. Native runtimes
+// then compute keccak256 over the input. Otherwise, the input is discarded, and
+// keccak256 is overapproximated by sol_crypto. An input must not exceed
+// SOL_KECCAK_CAPACITY bytes.
+#define SOL_KECCAK_CAPACITY 256
+#ifdef MC_USE_NATIVE_CRYPTO
+struct sol_keccak_t
+{
+    uint8_t data[SOL_KECCAK_CAPACITY];
+    size_t len;
+};
+struct sol_keccak_t sol_keccak_init(void);
+struct sol_keccak_t sol_keccak_update(
+    struct sol_keccak_t _state,
+    sol_raw_uint256_t _val,
+    uint8_t _bytes,
+    uint8_t _signed
+);
+sol_raw_uint256_t sol_keccak_final(struct sol_keccak_t _state);
+#define SOL_KECCAK_INIT() \
+    sol_keccak_init()
+#define SOL_KECCAK_UPDATE(__state, __val, __bytes, __signed) \
+    sol_keccak_update((__state), (__val), (__bytes), (__signed))
+#define SOL_KECCAK_FINAL(__state) \
+    sol_keccak_final(__state)
+#else
+#define SOL_KECCAK_INIT() 0
+#define SOL_KECCAK_UPDATE(__state, __val, __bytes, __signed) (__state)
+#define SOL_KECCAK_FINAL(__state) sol_crypto()
+#endif
+
 // Forward declares the entry-point to the c-model.
 void run_model(void);
 
@@ -195,9 +262,54 @@ void ll_assume(sol_raw_uint8_t _cond);
 // Allows logs from the model.
 void smartace_log(const char* _msg);
 
+// Hooks for models generated with --coverage. Each require and assume of the
+// model is labeled by a unique __site, and each transaction is marked by its
+// __case. If the runtime does not collect coverage, then the labels are
+// discarded.
+#ifdef MC_USE_COVERAGE
+void sol_require_at(uint32_t _site, sol_raw_uint8_t _cond, const char* _msg);
+void ll_assume_at(uint32_t _site, sol_raw_uint8_t _cond);
+void sol_cover_call(uint8_t _case);
+#define SOL_REQUIRE(__site, __cond, __msg) \
+    sol_require_at((__site), (__cond), (__msg))
+#define SOL_ASSUME(__site, __cond) \
+    ll_assume_at((__site), (__cond))
+#define SOL_COVER_CALL(__case) \
+    sol_cover_call(__case)
+#else
+#define SOL_REQUIRE(__site, __cond, __msg) \
+    sol_require((__cond), (__msg))
+#define SOL_ASSUME(__site, __cond) \
+    ll_assume(__cond)
+#define SOL_COVER_CALL(__case)
+#endif
+
+// Hooks for models generated with --snapshots. At each transaction boundary,
+// the world state __world is offered to the runtime. At the start of a run,
+// the runtime may restore __world (and the input consumed to reach it), in
+// which case setup is skipped. If the runtime does not cache snapshots, then
+// the world is never restored. As the world is copied bytewise, its integers
+// must be trivially copyable.
+#ifdef MC_USE_SNAPSHOTS
+    #ifndef MC_USE_STDINT
+    #error Snapshots require the stdint integer model.
+    #endif
+uint8_t sol_restore(void* _world, size_t _size);
+void sol_checkpoint(void const* _world, size_t _size);
+#define SOL_RESTORE(__world) \
+    sol_restore(&(__world), sizeof(__world))
+#define SOL_CHECKPOINT(__world) \
+    sol_checkpoint(&(__world), sizeof(__world))
+#else
+#define SOL_RESTORE(__world) 0
+#define SOL_CHECKPOINT(__world)
+#endif
+
 // Macros for generating location-specifc non-deterministic sources. The __loc
 // values are used to distinguish sources. All other arguments are forwarded to
-// the underlying method.
+// the underlying method. With external non-determinism, a batch of __n values
+// at __loc uses the sources __loc to __loc + __n - 1, through the macro
+// SEA_ND_BATCH_<__loc> of the model.
 #ifdef MC_USE_EXTERNAL_NONDET
 #define GET_SEA_ND_HOOK(__loc) \
     (sea_nd_ ## __loc ())
@@ -211,6 +323,10 @@ void smartace_log(const char* _msg);
     (nd_int ## __width ## _t(GET_SEA_ND_HOOK(__loc), (__msg)))
 #define GET_ND_UINT(__loc, __width, __msg) \
     (nd_uint ## __width ## _t(GET_SEA_ND_HOOK(__loc), (__msg)))
+#define GET_ND_INT_ARRAY(__loc, __width, __n, __out, __msg) \
+    SEA_ND_BATCH_ ## __loc((__out), (__msg))
+#define GET_ND_UINT_ARRAY(__loc, __width, __n, __out, __msg) \
+    SEA_ND_BATCH_ ## __loc((__out), (__msg))
 #else
 #define GET_ND_BYTE(__loc, __msg) \
     nd_byte(0, (__msg))
@@ -222,6 +338,10 @@ void smartace_log(const char* _msg);
     (nd_int ## __width ## _t(0, (__msg)))
 #define GET_ND_UINT(__loc, __width, __msg) \
     (nd_uint ## __width ## _t(0, (__msg)))
+#define GET_ND_INT_ARRAY(__loc, __width, __n, __out, __msg) \
+    nd_int ## __width ## _array(0, (__n), (__out), (__msg))
+#define GET_ND_UINT_ARRAY(__loc, __width, __n, __out, __msg) \
+    nd_uint ## __width ## _array(0, (__n), (__out), (__msg))
 #endif
 
 // Returns a raw byte without any wrapping. This is meant to be used by the
@@ -291,7 +411,7 @@ sol_raw_int184_t nd_int184_t(sol_raw_int184_t _sea_hint, const char* _msg);
 sol_raw_uint184_t nd_uint184_t(sol_raw_int184_t _sea_hint, const char* _msg);
 sol_raw_int192_t nd_int192_t(sol_raw_int192_t _sea_hint, const char* _msg);
 sol_raw_uint192_t nd_uint192_t(sol_raw_int192_t _sea_hint, const char* _msg);
-sol_raw_int200_t nd_int200_t(sol_raw_int120_t _sea_hint, const char* _msg);
+sol_raw_int200_t nd_int200_t(sol_raw_int200_t _sea_hint, const char* _msg);
 sol_raw_uint200_t nd_uint200_t(sol_raw_int200_t _sea_hint, const char* _msg);
 sol_raw_int208_t nd_int208_t(sol_raw_int208_t _sea_hint, const char* _msg);
 sol_raw_uint208_t nd_uint208_t(sol_raw_int208_t _sea_hint, const char* _msg);
@@ -307,3 +427,186 @@ sol_raw_int248_t nd_int248_t(sol_raw_int248_t _sea_hint, const char* _msg);
 sol_raw_uint248_t nd_uint248_t(sol_raw_int248_t _sea_hint, const char* _msg);
 sol_raw_int256_t nd_int256_t(sol_raw_int256_t _sea_hint, const char* _msg);
 sol_raw_uint256_t nd_uint256_t(sol_raw_int256_t _sea_hint, const char* _msg);
+
+// Fills _out[0], ..., _out[_n - 1] with non-deterministic integers, as if by _n
+// calls to the corresponding nd_int or nd_uint method. This allows runtimes to
+// decode a run of same-typed values at once. External sources do not use these
+// methods, as each value must be drawn from its own hook.
+#define SOL_ND_ARRAY_DECL(BITS) \
+    void nd_int ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t _sea_hint, \
+        size_t _n, \
+        sol_raw_int ## BITS ## _t* _out, \
+        const char* _msg \
+    ); \
+    void nd_uint ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t _sea_hint, \
+        size_t _n, \
+        sol_raw_uint ## BITS ## _t* _out, \
+        const char* _msg \
+    );
+SOL_WIDTHS(SOL_ND_ARRAY_DECL)
+
+// Intrinsics for the Solidity operators without a C equivalent. The result of
+// sol_exp_uN is reduced modulo the width of the base. A shift by at least N
+// bits produces zero, or -1 if sol_sar_iN shifts a negative value. Wide
+// integers use square-and-multiply and the word-level shifts of their backend.
+// Machine integers use a fixed number of branch-free steps, so that symbolic
+// exponents do not fork paths in SeaHorn or KLEE.
+#ifdef MC_USE_BOOST_MP
+#define SOL_OP_IMPL(BITS) \
+    inline sol_raw_uint ## BITS ## _t sol_exp_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _base, sol_raw_uint256_t _exp \
+    ) { \
+        sol_raw_uint ## BITS ## _t res = 1; \
+        for (; !_exp.is_zero(); _exp >>= 1) \
+        { \
+            if (bit_test(_exp, 0)) res *= _base; \
+            _base *= _base; \
+        } \
+        return res; \
+    } \
+    inline sol_raw_uint ## BITS ## _t sol_shr_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _val, sol_raw_uint256_t _shift \
+    ) { \
+        if (_shift >= BITS) return 0; \
+        return _val >> _shift.convert_to<unsigned>(); \
+    } \
+    inline sol_raw_int ## BITS ## _t sol_sar_i ## BITS( \
+        sol_raw_int ## BITS ## _t _val, sol_raw_uint256_t _shift \
+    ) { \
+        if (_shift >= BITS) return (_val < 0) ? -1 : 0; \
+        return _val >> _shift.convert_to<unsigned>(); \
+    }
+#else
+#define SOL_OP_IMPL(BITS) \
+    static inline sol_raw_uint ## BITS ## _t sol_exp_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _base, sol_raw_uint256_t _exp \
+    ) { \
+        uint64_t res = 1; \
+        uint64_t pow = _base; \
+        for (size_t i = 0; i < 8 * sizeof(_exp); ++i) \
+        { \
+            res *= 1 + ((_exp >> i) & 1) * (pow - 1); \
+            pow *= pow; \
+        } \
+        return (sol_raw_uint ## BITS ## _t)res; \
+    } \
+    static inline sol_raw_uint ## BITS ## _t sol_shr_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _val, sol_raw_uint256_t _shift \
+    ) { \
+        if (_shift >= 8 * sizeof(_val)) return 0; \
+        return (sol_raw_uint ## BITS ## _t)(_val >> _shift); \
+    } \
+    static inline sol_raw_int ## BITS ## _t sol_sar_i ## BITS( \
+        sol_raw_int ## BITS ## _t _val, sol_raw_uint256_t _shift \
+    ) { \
+        if (_shift >= 8 * sizeof(_val)) return (_val < 0) ? -1 : 0; \
+        return (sol_raw_int ## BITS ## _t)(_val >> _shift); \
+    }
+#endif
+SOL_WIDTHS(SOL_OP_IMPL)
+
+// Checked arithmetic, as in SafeMath. Each method applies its operator, and
+// requires that the result does not overflow, or that the divisor is non-zero.
+// Wide integers compare against the wrapped result. Machine integers use the
+// overflow builtins of the compiler, unless MC_USE_SYMBOLIC is set (as it is
+// for SeaHorn and KLEE), in which case each result is guarded by one condition.
+#define SOL_CHECKED_DIV_IMPL(SPEC, BITS) \
+    SPEC sol_raw_uint ## BITS ## _t sol_checked_div_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_require(_b != 0, "SafeMath: division by zero"); \
+        return _a / _b; \
+    } \
+    SPEC sol_raw_uint ## BITS ## _t sol_checked_mod_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_require(_b != 0, "SafeMath: modulo by zero"); \
+        return _a % _b; \
+    }
+#ifdef MC_USE_BOOST_MP
+#define SOL_CHECKED_IMPL(BITS) \
+    inline sol_raw_uint ## BITS ## _t sol_checked_add_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res = _a + _b; \
+        sol_require(res >= _a, "SafeMath: addition overflow"); \
+        return res; \
+    } \
+    inline sol_raw_uint ## BITS ## _t sol_checked_sub_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_require(_b <= _a, "SafeMath: subtraction overflow"); \
+        return _a - _b; \
+    } \
+    inline sol_raw_uint ## BITS ## _t sol_checked_mul_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res = _a * _b; \
+        if (_a.is_zero() || _b.is_zero()) return res; \
+        if (msb(_a) + msb(_b) + 2 <= BITS) return res; \
+        sol_require(res / _a == _b, "SafeMath: multiplication overflow"); \
+        return res; \
+    } \
+    SOL_CHECKED_DIV_IMPL(inline, BITS)
+#elif defined MC_USE_SYMBOLIC
+#define SOL_CHECKED_IMPL(BITS) \
+    static inline sol_raw_uint ## BITS ## _t sol_checked_add_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res = _a + _b; \
+        sol_require(res >= _a, "SafeMath: addition overflow"); \
+        return res; \
+    } \
+    static inline sol_raw_uint ## BITS ## _t sol_checked_sub_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_require(_b <= _a, "SafeMath: subtraction overflow"); \
+        return _a - _b; \
+    } \
+    static inline sol_raw_uint ## BITS ## _t sol_checked_mul_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res = (uint64_t)_a * _b; \
+        sol_require( \
+            _a == 0 || res / _a == _b, "SafeMath: multiplication overflow" \
+        ); \
+        return res; \
+    } \
+    SOL_CHECKED_DIV_IMPL(static inline, BITS)
+#else
+#define SOL_CHECKED_IMPL(BITS) \
+    static inline sol_raw_uint ## BITS ## _t sol_checked_add_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res; \
+        sol_require( \
+            !__builtin_add_overflow(_a, _b, &res), \
+            "SafeMath: addition overflow" \
+        ); \
+        return res; \
+    } \
+    static inline sol_raw_uint ## BITS ## _t sol_checked_sub_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res; \
+        sol_require( \
+            !__builtin_sub_overflow(_a, _b, &res), \
+            "SafeMath: subtraction overflow" \
+        ); \
+        return res; \
+    } \
+    static inline sol_raw_uint ## BITS ## _t sol_checked_mul_u ## BITS( \
+        sol_raw_uint ## BITS ## _t _a, sol_raw_uint ## BITS ## _t _b \
+    ) { \
+        sol_raw_uint ## BITS ## _t res; \
+        sol_require( \
+            !__builtin_mul_overflow(_a, _b, &res), \
+            "SafeMath: multiplication overflow" \
+        ); \
+        return res; \
+    } \
+    SOL_CHECKED_DIV_IMPL(static inline, BITS)
+#endif
+SOL_WIDTHS(SOL_CHECKED_IMPL)
@@ -0,0 +1,18 @@
+/**
+ * Instantiates the out-of-line members of each Boost integer type. Translation
+ * units which include verify.h only declare these instantiations, so they are
+ * compiled once per build, rather than once per translation unit. This file is
+ * empty for all other integer models.
+ *
+ * @date 2021
+ */
+
+#define MC_INSTANTIATE_BOOST_MP
+#include "verify.h"
+
+#ifdef MC_USE_BOOST_MP
+#define BOOST_MP_DEFINE(BITS) \
+    BOOST_MP_MEMBERS(, BOOST_INT(BITS)) \
+    BOOST_MP_MEMBERS(, BOOST_UINT(BITS))
+SOL_WIDTHS(BOOST_MP_DEFINE)
+#endif
@@ -17,7 +17,7 @@ using namespace std;
 
 // -------------------------------------------------------------------------- //
 
-static uint64_t g_solTransactionNumber;
+static SOL_THREAD_LOCAL uint64_t g_solTransactionNumber;
 
 static const char g_solHelpCliArg[] = "help";
 static const char g_solHelpCliMsg[] = "display options and settings";
@@ -1063,3 +1063,32 @@ sol_raw_uint256_t nd_uint256_t(sol_raw_int256_t, const char* _msg)
 }
 
 // -------------------------------------------------------------------------- //
+
+// Each value of a batch is read in order, as by the scalar methods.
+#define SOL_ND_ARRAY_IMPL(BITS) \
+    void nd_int ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t _sea_hint, \
+        size_t _n, \
+        sol_raw_int ## BITS ## _t* _out, \
+        const char* _msg \
+    ) { \
+        for (size_t i = 0; i < _n; ++i) \
+        { \
+            _out[i] = nd_int ## BITS ## _t(_sea_hint, _msg); \
+        } \
+    } \
+    void nd_uint ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t _sea_hint, \
+        size_t _n, \
+        sol_raw_uint ## BITS ## _t* _out, \
+        const char* _msg \
+    ) { \
+        for (size_t i = 0; i < _n; ++i) \
+        { \
+            _out[i] = nd_uint ## BITS ## _t(_sea_hint, _msg); \
+        } \
+    }
+
+SOL_WIDTHS(SOL_ND_ARRAY_IMPL)
+
+// -------------------------------------------------------------------------- //
@@ -0,0 +1,240 @@
+/**
+ * Implements keccak256 for native runtimes. The permutation is ported from
+ * libdevcore/Keccak256.cpp (libkeccak-tiny), so that the runtime does not
+ * depend on libdevcore. As contracts tend to hash the same keys many times,
+ * each digest is memoized in a small open-addressing table, keyed by input.
+ *
+ * The model must be generated with --native-crypto, and built with
+ * MC_USE_NATIVE_CRYPTO.
+ *
+ * @date 2021
+ */
+
+#include "verify.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+// The number of bytes absorbed per permutation of keccak256.
+size_t const RATE = 200 - (256 / 4);
+
+// The number of entries in the cache. This must be a power of two.
+size_t const CACHE_SIZE = 256;
+
+// The number of entries to probe, before the home slot is evicted.
+size_t const MAX_PROBES = 8;
+
+/*** Constants of the Keccak-f[1600] permutation. ***/
+uint8_t const rho[24] = \
+    { 1,  3,   6, 10, 15, 21,
+    28, 36, 45, 55,  2, 14,
+    27, 41, 56,  8, 25, 43,
+    62, 18, 39, 61, 20, 44};
+uint8_t const pi[24] = \
+    {10,  7, 11, 17, 18, 3,
+    5, 16,  8, 21, 24, 4,
+    15, 23, 19, 13, 12, 2,
+    20, 14, 22,  9, 6,  1};
+uint64_t const RC[24] = \
+    {1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
+    0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
+
+uint64_t rol(uint64_t _x, uint8_t _s)
+{
+    return (_x << _s) | (_x >> (64 - _s));
+}
+
+// Applies Keccak-f[1600] to _state.
+void keccakf(uint64_t* _state)
+{
+    uint64_t* a = _state;
+    uint64_t b[5] = {0};
+    for (int i = 0; i < 24; ++i)
+    {
+        // Theta
+        for (int x = 0; x < 5; ++x)
+        {
+            b[x] = 0;
+            for (int y = 0; y < 25; y += 5) b[x] ^= a[x + y];
+        }
+        for (int x = 0; x < 5; ++x)
+        {
+            for (int y = 0; y < 25; y += 5)
+            {
+                a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1);
+            }
+        }
+        // Rho and pi
+        uint64_t t = a[1];
+        for (int x = 0; x < 24; ++x)
+        {
+            b[0] = a[pi[x]];
+            a[pi[x]] = rol(t, rho[x]);
+            t = b[0];
+        }
+        // Chi
+        for (int y = 0; y < 25; y += 5)
+        {
+            for (int x = 0; x < 5; ++x) b[x] = a[y + x];
+            for (int x = 0; x < 5; ++x)
+            {
+                a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]);
+            }
+        }
+        // Iota
+        a[0] ^= RC[i];
+    }
+}
+
+// Writes the keccak256 digest of _in[0], ..., _in[_len - 1] to _out.
+void keccak256(uint8_t* _out, uint8_t const* _in, size_t _len)
+{
+    uint64_t state[25] = {0};
+    uint8_t* a = reinterpret_cast<uint8_t*>(state);
+
+    // Absorbs each full block of input.
+    for (; _len >= RATE; _in += RATE, _len -= RATE)
+    {
+        for (size_t i = 0; i < RATE; ++i) a[i] ^= _in[i];
+        keccakf(state);
+    }
+
+    // Absorbs the last block, along with the padding of keccak.
+    for (size_t i = 0; i < _len; ++i) a[i] ^= _in[i];
+    a[_len] ^= 0x01;
+    a[RATE - 1] ^= 0x80;
+    keccakf(state);
+
+    memcpy(_out, a, 32);
+}
+
+// An entry of the cache. The entry is empty, unless used is set.
+struct CacheEntry
+{
+    bool used;
+    size_t len;
+    uint8_t data[SOL_KECCAK_CAPACITY];
+    uint8_t digest[32];
+};
+
+SOL_THREAD_LOCAL CacheEntry g_cache[CACHE_SIZE];
+
+// Returns the FNV-1a hash of _state.
+size_t fnv1a(struct sol_keccak_t const& _state)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < _state.len; ++i)
+    {
+        hash = (hash ^ _state.data[i]) * 0x100000001b3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+// Returns the cached digest of _state, computing it on a miss.
+uint8_t const* lookup(struct sol_keccak_t const& _state)
+{
+    size_t const HOME = fnv1a(_state) & (CACHE_SIZE - 1);
+    for (size_t i = 0; i < MAX_PROBES; ++i)
+    {
+        auto & entry = g_cache[(HOME + i) & (CACHE_SIZE - 1)];
+        if (!entry.used)
+        {
+            break;
+        }
+        else if (entry.len == _state.len
+              && memcmp(entry.data, _state.data, _state.len) == 0)
+        {
+            return entry.digest;
+        }
+    }
+
+    // The first empty slot is filled, or else the home slot is evicted.
+    size_t slot = HOME;
+    for (size_t i = 0; i < MAX_PROBES; ++i)
+    {
+        size_t const NEXT = (HOME + i) & (CACHE_SIZE - 1);
+        if (!g_cache[NEXT].used)
+        {
+            slot = NEXT;
+            break;
+        }
+    }
+
+    auto & entry = g_cache[slot];
+    entry.used = true;
+    entry.len = _state.len;
+    memcpy(entry.data, _state.data, _state.len);
+    keccak256(entry.digest, _state.data, _state.len);
+    return entry.digest;
+}
+}
+
+// -------------------------------------------------------------------------- //
+
+struct sol_keccak_t sol_keccak_init(void)
+{
+    struct sol_keccak_t state;
+    state.len = 0;
+    return state;
+}
+
+// -------------------------------------------------------------------------- //
+
+struct sol_keccak_t sol_keccak_update(
+    struct sol_keccak_t _state,
+    sol_raw_uint256_t _val,
+    uint8_t _bytes,
+    uint8_t _signed
+)
+{
+    if (_state.len + _bytes > SOL_KECCAK_CAPACITY)
+    {
+        sol_require(0, "Input to keccak256 exceeds capacity.");
+        return _state;
+    }
+
+    // If the value is negative, then the bytes beyond its width are all set.
+    sol_raw_uint256_t const ONES = ~sol_raw_uint256_t(0);
+    sol_raw_uint256_t const MSB = ONES ^ (ONES >> 1);
+    bool const NEG = _signed && (_val & MSB) != 0;
+
+    // The bytes are written in big-endian order.
+    for (size_t i = 0; i < _bytes; ++i)
+    {
+        uint8_t byte = static_cast<uint8_t>(_val & 0xFF);
+        if (NEG && _val == 0) byte = 0xFF;
+        _state.data[_state.len + _bytes - i - 1] = byte;
+        _val >>= 8;
+    }
+    _state.len += _bytes;
+    return _state;
+}
+
+// -------------------------------------------------------------------------- //
+
+sol_raw_uint256_t sol_keccak_final(struct sol_keccak_t _state)
+{
+    // The digest is read as a big-endian integer, and is truncated if the
+    // integer model is narrower than 256 bits.
+    uint8_t const* digest = lookup(_state);
+    sol_raw_uint256_t res = 0;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        res <<= 8;
+        res |= digest[i];
+    }
+    return res;
+}
+
+// -------------------------------------------------------------------------- //
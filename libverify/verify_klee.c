@@ -619,3 +619,28 @@ sol_raw_uint256_t nd_uint256_t(sol_raw_int256_t tmp, const char* _msg)
 }
 
 // -------------------------------------------------------------------------- //
+
+// Each batch is a single symbolic object.
+#define SOL_ND_ARRAY_IMPL(BITS) \
+	void nd_int ## BITS ## _array( \
+		sol_raw_int ## BITS ## _t tmp, \
+		size_t _n, \
+		sol_raw_int ## BITS ## _t* _out, \
+		const char* _msg \
+	) { \
+		(void) tmp; \
+		klee_make_symbolic(_out, _n * sizeof(*_out), _msg); \
+	} \
+	void nd_uint ## BITS ## _array( \
+		sol_raw_int ## BITS ## _t tmp, \
+		size_t _n, \
+		sol_raw_uint ## BITS ## _t* _out, \
+		const char* _msg \
+	) { \
+		(void) tmp; \
+		klee_make_symbolic(_out, _n * sizeof(*_out), _msg); \
+	}
+
+SOL_WIDTHS(SOL_ND_ARRAY_IMPL)
+
+// -------------------------------------------------------------------------- //
@@ -6,6 +6,10 @@
 
 #include "verify.h"
 
+#ifdef MC_USE_COVERAGE
+#include "verify_profile.h"
+#endif
+
 #include <cassert>
 #include <csetjmp>
 #include <cstddef>
@@ -14,6 +18,12 @@
 #include <cstring>
 #include <iostream>
 
+#ifdef MC_USE_SNAPSHOTS
+#include <list>
+#include <unordered_map>
+#include <vector>
+#endif
+
 using namespace std;
 
 // -------------------------------------------------------------------------- //
@@ -25,18 +35,18 @@ using namespace std;
 enum ExceptionType { NONE, OUT_OF_DATA, REQUIRE_FAILED };
 
 // A global variable which stores the state to restore on exception.
-static jmp_buf Env;
+static SOL_THREAD_LOCAL jmp_buf Env;
 
 // Global variable used to proprogation exceptions. If it is none, no exceptions
 // are being proprogated. It should only be set by setjmp, which will raise the
 // current exception flag.
-static ExceptionType exception_type = NONE;
+static SOL_THREAD_LOCAL ExceptionType exception_type = NONE;
 
 // Defines a global array RandData, with SizeOfRandData bytes. CounterOfRandData
 // maintains an index to track which byte is currently being read.
-static uint8_t * RandData;
-static size_t SizeOfRandData = 0;
-static size_t CounterOfRandData = 0;
+static SOL_THREAD_LOCAL uint8_t * RandData;
+static SOL_THREAD_LOCAL size_t SizeOfRandData = 0;
+static SOL_THREAD_LOCAL size_t CounterOfRandData = 0;
 
 // Sets up the exploration with Env environment, and returns the result of setjmp.
 int SetupExploration(void);
@@ -55,6 +65,80 @@ uint8_t tryGetNextRandByte();
 // Inputs the data.
 extern "C" int LLVMFuzzerTestOneInput(uint8_t const* Data, size_t Size);
 
+// Called once by libFuzzer, before any input.
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv);
+
+#ifdef MC_USE_COVERAGE
+// Transaction-level coverage, which libFuzzer treats as additional edges. The
+// counters are partitioned into: each transaction, each ordered pair of
+// transactions, each require outcome, and each require outcome per transaction.
+static const size_t CallCounters = 256;
+static const size_t OrderCounters = 4096;
+static const size_t RequireCounters = 4096;
+static const size_t PairCounters = 4096;
+__attribute__((section("__libfuzzer_extra_counters")))
+uint8_t CoverageCounters[
+	CallCounters + OrderCounters + RequireCounters + PairCounters
+];
+
+// The current and previous transaction. NoCall is used before the first call.
+static const size_t NoCall = 256;
+static size_t CurrentCall = NoCall;
+static size_t PreviousCall = NoCall;
+
+// Increments the coverage counter at _offset + (_key % _width).
+void cover(size_t _offset, size_t _width, size_t _key);
+
+// Increments the coverage counter at _index.
+void hit(size_t _index);
+#endif
+
+#ifdef MC_USE_SNAPSHOTS
+// A world state of the model, at the end of some transaction. The state is
+// reached by consuming exactly the bytes of prefix.
+struct Snapshot
+{
+	uint64_t key;
+	vector<uint8_t> prefix;
+	vector<uint8_t> world;
+	#ifdef MC_USE_COVERAGE
+	size_t current_call;
+	vector<uint16_t> coverage;
+	#endif
+};
+
+// A bounded cache of snapshots, from most to least recently used. Snapshots
+// are indexed by the hash of their prefix, and counted by prefix length.
+static const size_t SnapshotCapacity = 256;
+static list<Snapshot> Snapshots;
+static unordered_map<uint64_t, list<Snapshot>::iterator> SnapshotIndex;
+static vector<size_t> SnapshotLengths;
+
+// The hash of all bytes consumed so far (FNV-1a).
+static const uint64_t PrefixSeed = 0xCBF29CE484222325ULL;
+static uint64_t PrefixHash = PrefixSeed;
+
+// Set upon restoring a snapshot, so that it is not immediately cached again.
+static bool SkipCheckpoint = false;
+
+#ifdef MC_USE_COVERAGE
+// The coverage counters hit by the current run, in order. A restored snapshot
+// replays the counters of its prefix, so that an input reports the same
+// transaction-level coverage whether or not its prefix was cached.
+static vector<uint16_t> RunCoverage;
+static_assert(
+	sizeof(CoverageCounters) <= UINT16_MAX + 1,
+	"Coverage counters must be indexed by uint16_t."
+);
+#endif
+
+// Returns the hash of the bytes consumed by _hash, and then _byte.
+uint64_t extend_hash(uint64_t _hash, uint8_t _byte);
+
+// Returns the cache key for a prefix of _len bytes with hash _hash.
+uint64_t snapshot_key(uint64_t _hash, size_t _len);
+#endif
+
 // -------------------------------------------------------------------------- //
 
 sol_raw_uint8_t sol_crypto(void)
@@ -75,7 +159,12 @@ uint8_t sol_continue(void)
 
 // -------------------------------------------------------------------------- //
 
-void sol_on_transaction(void) {}
+void sol_on_transaction(void)
+{
+	#ifdef MC_USE_COVERAGE
+	g_solRequireProfile.poll();
+	#endif
+}
 
 // -------------------------------------------------------------------------- //
 
@@ -113,7 +202,11 @@ void sol_require(sol_raw_uint8_t _cond, const char* _msg)
 		cout << endl; 
 		*/
     }
-	ll_assume(_cond);	
+
+	#ifdef MC_USE_COVERAGE
+	g_solRequireProfile.record(RequireProfile::UNLABELED, (bool)_cond);
+	#endif
+	if (!_cond) TerminateExploration(REQUIRE_FAILED);
 }
 
 // -------------------------------------------------------------------------- //
@@ -124,6 +217,9 @@ void sol_emit(const char*) {}
 
 void ll_assume(sol_raw_uint8_t _cond)
 {
+	#ifdef MC_USE_COVERAGE
+	g_solRequireProfile.record(RequireProfile::ASSUME, (bool)_cond);
+	#endif
     if (!_cond) TerminateExploration(REQUIRE_FAILED);
 }
 
@@ -192,10 +288,16 @@ uint8_t tryGetNextRandByte()
 {
 	if (CounterOfRandData >= SizeOfRandData)
 	{
+		#ifdef MC_USE_COVERAGE
+		g_solRequireProfile.record(RequireProfile::OUT_OF_DATA, false);
+		#endif
 		TerminateExploration(OUT_OF_DATA);
 	}
 	uint8_t ret = RandData[CounterOfRandData];
 	CounterOfRandData++;
+	#ifdef MC_USE_SNAPSHOTS
+	PrefixHash = extend_hash(PrefixHash, ret);
+	#endif
 	return ret;
 }
 
@@ -207,12 +309,24 @@ void ran(uint8_t const* Data, size_t Size)
 
 	SizeOfRandData = Size;
 	CounterOfRandData = 0;
+	#ifdef MC_USE_SNAPSHOTS
+	PrefixHash = PrefixSeed;
+	SkipCheckpoint = false;
+	#endif
 	for (size_t i = 0; i < Size; ++i)
 	{
 		RandData[i] = Data[i];
 	}
 }
 
+extern "C" int LLVMFuzzerInitialize(int*, char***)
+{
+	#ifdef MC_USE_COVERAGE
+	g_solRequireProfile.setup();
+	#endif
+	return 0;
+}
+
 extern "C" int LLVMFuzzerTestOneInput(uint8_t const* Data, size_t Size)
 {
 	exception_type = NONE;
@@ -223,6 +337,13 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* Data, size_t Size)
 		case REQUIRE_FAILED: break;
 		case NONE:
 			// cout << endl;
+			#ifdef MC_USE_COVERAGE
+			CurrentCall = NoCall;
+			PreviousCall = NoCall;
+			#ifdef MC_USE_SNAPSHOTS
+			RunCoverage.clear();
+			#endif
+			#endif
 			ran(Data, Size);
 			run_model();
 			break;
@@ -1003,3 +1124,231 @@ sol_raw_uint256_t nd_uint256_t(sol_raw_int256_t, const char* _msg)
 }
 
 // -------------------------------------------------------------------------- //
+
+// Decodes _n values of _bytes bytes each into _out, as if each were decoded by
+// the scalar methods above. If enough data remains, then the values are decoded
+// directly from RandData, in a single pass. Otherwise, the bytes are consumed
+// one at a time, so that exploration terminates at the same byte.
+template <typename T>
+void nd_array(size_t _bytes, size_t _n, T* _out)
+{
+	size_t const TOTAL = _bytes * _n;
+	if (SizeOfRandData - CounterOfRandData < TOTAL)
+	{
+		for (size_t i = 0; i < _n; ++i)
+		{
+			T retval = 0;
+			for (size_t j = 0; j < _bytes; ++j)
+			{
+				retval = retval << 8;
+				retval = retval + (T)tryGetNextRandByte();
+			}
+			_out[i] = retval;
+		}
+		return;
+	}
+
+	uint8_t const* src = RandData + CounterOfRandData;
+	for (size_t i = 0; i < _n; ++i)
+	{
+		T retval = 0;
+		for (size_t j = 0; j < _bytes; ++j)
+		{
+			retval = retval << 8;
+			retval = retval + (T)src[j];
+		}
+		_out[i] = retval;
+		src += _bytes;
+	}
+
+	#ifdef MC_USE_SNAPSHOTS
+	for (size_t i = 0; i < TOTAL; ++i)
+	{
+		PrefixHash = extend_hash(PrefixHash, RandData[CounterOfRandData + i]);
+	}
+	#endif
+	CounterOfRandData += TOTAL;
+}
+
+#define SOL_ND_ARRAY_IMPL(BITS) \
+	void nd_int ## BITS ## _array( \
+		sol_raw_int ## BITS ## _t, \
+		size_t _n, \
+		sol_raw_int ## BITS ## _t* _out, \
+		const char* _msg \
+	) { \
+		on_entry("int" #BITS, _msg); \
+		nd_array(BITS / 8, _n, _out); \
+	} \
+	void nd_uint ## BITS ## _array( \
+		sol_raw_int ## BITS ## _t, \
+		size_t _n, \
+		sol_raw_uint ## BITS ## _t* _out, \
+		const char* _msg \
+	) { \
+		on_entry("uint" #BITS, _msg); \
+		nd_array(BITS / 8, _n, _out); \
+	}
+
+SOL_WIDTHS(SOL_ND_ARRAY_IMPL)
+
+// -------------------------------------------------------------------------- //
+
+#ifdef MC_USE_COVERAGE
+void cover(size_t _offset, size_t _width, size_t _key)
+{
+	size_t const INDEX = _offset + (_key % _width);
+	hit(INDEX);
+	#ifdef MC_USE_SNAPSHOTS
+	RunCoverage.push_back(static_cast<uint16_t>(INDEX));
+	#endif
+}
+
+void hit(size_t _index)
+{
+	uint8_t & counter = CoverageCounters[_index];
+	if (counter < UINT8_MAX) ++counter;
+}
+
+void sol_cover_call(uint8_t _case)
+{
+	PreviousCall = CurrentCall;
+	CurrentCall = _case;
+
+	size_t offset = 0;
+	cover(offset, CallCounters, CurrentCall);
+	offset += CallCounters;
+	cover(offset, OrderCounters, PreviousCall * (NoCall + 1) + CurrentCall);
+}
+
+void cover_site(uint32_t _site, sol_raw_uint8_t _cond, const char* _msg)
+{
+	size_t const OUTCOME = 2 * size_t(_site) + (_cond ? 1 : 0);
+
+	size_t offset = CallCounters + OrderCounters;
+	cover(offset, RequireCounters, OUTCOME);
+	offset += RequireCounters;
+	cover(offset, PairCounters, OUTCOME * (NoCall + 1) + CurrentCall);
+
+	g_solRequireProfile.record(_site, (bool)_cond, _msg);
+}
+
+void sol_require_at(uint32_t _site, sol_raw_uint8_t _cond, const char* _msg)
+{
+	cover_site(_site, _cond, _msg);
+	if (!_cond) TerminateExploration(REQUIRE_FAILED);
+}
+
+void ll_assume_at(uint32_t _site, sol_raw_uint8_t _cond)
+{
+	cover_site(_site, _cond, "[assume]");
+	if (!_cond) TerminateExploration(REQUIRE_FAILED);
+}
+
+// -------------------------------------------------------------------------- //
+#endif
+
+#ifdef MC_USE_SNAPSHOTS
+uint64_t extend_hash(uint64_t _hash, uint8_t _byte)
+{
+	return (_hash ^ _byte) * 0x100000001B3ULL;
+}
+
+uint64_t snapshot_key(uint64_t _hash, size_t _len)
+{
+	return _hash ^ (_len * 0x9E3779B97F4A7C15ULL);
+}
+
+uint8_t sol_restore(void* _world, size_t _size)
+{
+	// Finds the deepest snapshot whose prefix is also a prefix of this input.
+	auto match = Snapshots.end();
+	uint64_t match_hash = PrefixSeed;
+
+	uint64_t hash = PrefixSeed;
+	size_t const LIMIT = min(SizeOfRandData + 1, SnapshotLengths.size());
+	for (size_t len = 1; len < LIMIT; ++len)
+	{
+		hash = extend_hash(hash, RandData[len - 1]);
+		if (SnapshotLengths[len] == 0) continue;
+
+		auto res = SnapshotIndex.find(snapshot_key(hash, len));
+		if (res == SnapshotIndex.end()) continue;
+
+		auto const& snapshot = *res->second;
+		if (snapshot.world.size() != _size) continue;
+		if (snapshot.prefix.size() != len) continue;
+		if (memcmp(snapshot.prefix.data(), RandData, len) != 0) continue;
+
+		match = res->second;
+		match_hash = hash;
+	}
+
+	if (match == Snapshots.end()) return 0;
+
+	// Resumes the input from the end of the prefix.
+	memcpy(_world, match->world.data(), _size);
+	CounterOfRandData = match->prefix.size();
+	PrefixHash = match_hash;
+	#ifdef MC_USE_COVERAGE
+	CurrentCall = match->current_call;
+	RunCoverage = match->coverage;
+	for (auto index : RunCoverage) hit(index);
+	#endif
+
+	Snapshots.splice(Snapshots.begin(), Snapshots, match);
+	SkipCheckpoint = true;
+	return 1;
+}
+
+void sol_checkpoint(void const* _world, size_t _size)
+{
+	if (SkipCheckpoint)
+	{
+		SkipCheckpoint = false;
+		return;
+	}
+	else if (CounterOfRandData == 0)
+	{
+		return;
+	}
+
+	// If this prefix is cached, then it is marked as recently used.
+	uint64_t const KEY = snapshot_key(PrefixHash, CounterOfRandData);
+	auto res = SnapshotIndex.find(KEY);
+	if (res != SnapshotIndex.end())
+	{
+		Snapshots.splice(Snapshots.begin(), Snapshots, res->second);
+		return;
+	}
+
+	// Otherwise, the least recently used snapshot is replaced.
+	if (Snapshots.size() >= SnapshotCapacity)
+	{
+		auto const& victim = Snapshots.back();
+		--SnapshotLengths[victim.prefix.size()];
+		SnapshotIndex.erase(victim.key);
+		Snapshots.pop_back();
+	}
+
+	Snapshots.emplace_front();
+	auto & snapshot = Snapshots.front();
+	snapshot.key = KEY;
+	snapshot.prefix.assign(RandData, RandData + CounterOfRandData);
+	snapshot.world.resize(_size);
+	memcpy(snapshot.world.data(), _world, _size);
+	#ifdef MC_USE_COVERAGE
+	snapshot.current_call = CurrentCall;
+	snapshot.coverage = RunCoverage;
+	#endif
+
+	SnapshotIndex[KEY] = Snapshots.begin();
+	if (SnapshotLengths.size() <= CounterOfRandData)
+	{
+		SnapshotLengths.resize(CounterOfRandData + 1, 0);
+	}
+	++SnapshotLengths[CounterOfRandData];
+}
+
+// -------------------------------------------------------------------------- //
+#endif
@@ -0,0 +1,130 @@
+/**
+ * Implements the require profiler.
+ *
+ * @date 2021
+ */
+
+#include "verify_profile.h"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// -------------------------------------------------------------------------- //
+
+const size_t RequireProfile::MAX_SITES;
+const size_t RequireProfile::SLOT_COUNT;
+
+RequireProfile g_solRequireProfile;
+
+// Set by SIGUSR1, and cleared once the report is written.
+static atomic<bool> g_solReportRequested(false);
+
+// -------------------------------------------------------------------------- //
+
+void report_at_exit(void)
+{
+    g_solRequireProfile.report(cerr);
+}
+
+void request_report(int)
+{
+    g_solReportRequested.store(true, memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------- //
+
+void RequireProfile::setup(void)
+{
+    atexit(report_at_exit);
+    signal(SIGUSR1, request_report);
+}
+
+void RequireProfile::record(uint32_t _site, bool _cond, const char* _msg)
+{
+    size_t const SLOT = SPECIAL_COUNT + min<size_t>(_site, MAX_SITES);
+    record_slot(SLOT, _cond);
+    if (_msg && !m_msgs[SLOT].load(memory_order_relaxed))
+    {
+        m_msgs[SLOT].store(_msg, memory_order_relaxed);
+    }
+}
+
+void RequireProfile::record(Special _kind, bool _cond)
+{
+    record_slot(_kind, _cond);
+}
+
+void RequireProfile::poll(void)
+{
+    if (g_solReportRequested.exchange(false, memory_order_relaxed))
+    {
+        report(cerr);
+    }
+}
+
+void RequireProfile::report(ostream& _out) const
+{
+    vector<size_t> slots;
+    uint64_t total = 0;
+    for (size_t i = 0; i < SLOT_COUNT; ++i)
+    {
+        auto const REJECTS = m_rejects[i].load(memory_order_relaxed);
+        if (REJECTS > 0) slots.push_back(i);
+        total += REJECTS;
+    }
+
+    stable_sort(slots.begin(), slots.end(), [this](size_t _a, size_t _b) {
+        return m_rejects[_a].load(memory_order_relaxed)
+             > m_rejects[_b].load(memory_order_relaxed);
+    });
+
+    _out << "Require Profile (" << total << " rejections)" << endl;
+    _out << "  rejected /         hits   share  site" << endl;
+    for (auto i : slots)
+    {
+        auto const HITS = m_hits[i].load(memory_order_relaxed);
+        auto const REJECTS = m_rejects[i].load(memory_order_relaxed);
+        _out << setw(10) << REJECTS << " / " << setw(12) << HITS << " "
+             << setw(6) << fixed << setprecision(2)
+             << (100.0 * REJECTS / total) << "%  ";
+        describe(_out, i);
+        _out << endl;
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void RequireProfile::record_slot(size_t _slot, bool _cond)
+{
+    m_hits[_slot].fetch_add(1, memory_order_relaxed);
+    if (!_cond)
+    {
+        m_rejects[_slot].fetch_add(1, memory_order_relaxed);
+    }
+}
+
+void RequireProfile::describe(ostream& _out, size_t _slot) const
+{
+    switch (_slot)
+    {
+    case UNLABELED: _out << "[unlabeled require]"; return;
+    case ASSUME: _out << "[runtime assumption]"; return;
+    case OUT_OF_DATA: _out << "[out of data]"; return;
+    default: break;
+    }
+
+    _out << "site " << (_slot - SPECIAL_COUNT);
+    if (_slot + 1 == SLOT_COUNT) _out << "+";
+    if (auto msg = m_msgs[_slot].load(memory_order_relaxed))
+    {
+        _out << ": " << msg;
+    }
+}
+
+// -------------------------------------------------------------------------- //
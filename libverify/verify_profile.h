@@ -0,0 +1,63 @@
+/**
+ * Defines a profiler for rejected executions. Each require and assume site of
+ * the model has a counter of hits and rejections. Runtime rejections (bare
+ * assumptions and exhausted inputs) are counted separately. The counters are
+ * lock-free, so that they can be shared by many threads. A report of the sites,
+ * ranked by rejections, is written at exit, or upon SIGUSR1.
+ *
+ * Sites are only available for models generated with --coverage.
+ *
+ * @date 2021
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// -------------------------------------------------------------------------- //
+
+class RequireProfile
+{
+public:
+    // Checks which do not correspond to a require of the model.
+    enum Special { UNLABELED, ASSUME, OUT_OF_DATA, SPECIAL_COUNT };
+
+    // The maximum number of sites. Larger sites share the final counter.
+    static const size_t MAX_SITES = 4096;
+
+    // Installs the report handlers. This should be called once.
+    void setup(void);
+
+    // Records that require site _site was reached, with outcome _cond.
+    void record(uint32_t _site, bool _cond, const char* _msg);
+
+    // Records that a runtime check of kind _kind was reached.
+    void record(Special _kind, bool _cond);
+
+    // Writes the report if one has been requested by a signal.
+    void poll(void);
+
+    // Writes all sites with at least one rejection, ranked by rejections.
+    void report(std::ostream& _out) const;
+
+private:
+    static const size_t SLOT_COUNT = SPECIAL_COUNT + MAX_SITES + 1;
+
+    std::atomic<uint64_t> m_hits[SLOT_COUNT];
+    std::atomic<uint64_t> m_rejects[SLOT_COUNT];
+    std::atomic<const char*> m_msgs[SLOT_COUNT];
+
+    // Increments the counters of _slot, given outcome _cond.
+    void record_slot(size_t _slot, bool _cond);
+
+    // Writes a description of _slot to _out.
+    void describe(std::ostream& _out, size_t _slot) const;
+};
+
+// The profile of the current process.
+extern RequireProfile g_solRequireProfile;
+
+// -------------------------------------------------------------------------- //
@@ -0,0 +1,600 @@
+/**
+ * Defines a random simulation runtime. Many threads execute the model at once,
+ * each drawing non-deterministic values from a seeded PRNG. In the style of
+ * swarm testing, each run is also given a random configuration, which disables
+ * some transactions and biases values towards small constants. A run is fully
+ * determined by its seed and by --depth, so that failures are replayable.
+ * Each failure is recorded as the arguments needed to replay it.
+ *
+ * The model must be generated with --reentrant, and built with
+ * MC_USE_REENTRANT. Both are checked at compile time.
+ *
+ * @date 2021
+ */
+
+#include "verify.h"
+#include "cmodel.h"
+
+#ifndef SOL_MODEL_REENTRANT
+#error The model must be generated with --reentrant.
+#endif
+
+#ifndef MC_USE_REENTRANT
+#error The simulation runtime must be built with MC_USE_REENTRANT.
+#endif
+
+#ifdef MC_USE_COVERAGE
+#include "verify_profile.h"
+#endif
+
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <csetjmp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// -------------------------------------------------------------------------- //
+
+static const char g_solHelpCliArg[] = "help";
+static const char g_solHelpCliMsg[] = "display options and settings";
+static const char g_solThreadsArg[] = "threads";
+static const char g_solThreadsMsg[] = "number of threads (0 for all cores)";
+static const char g_solRunsArg[] = "runs";
+static const char g_solRunsMsg[] = "total number of runs across all threads";
+static const char g_solDepthArg[] = "depth";
+static const char g_solDepthMsg[] = "maximum number of transactions per run";
+static const char g_solSeedArg[] = "seed";
+static const char g_solSeedMsg[] = "seed of the first run";
+static const char g_solReplayArg[] = "replay";
+static const char g_solReplayMsg[] = "replays one seed, and logs its trace";
+static const char g_solFailuresArg[] = "failures";
+static const char g_solFailuresMsg[] = "file which failing runs are added to";
+
+// Settings shared by all threads. These are fixed before any thread starts.
+static uint64_t g_solDepth = 64;
+static bool g_solReplay = false;
+static string g_solFailures = "failures.txt";
+
+// Aggregate results across all threads.
+static atomic<uint64_t> g_solNextRun(0);
+static atomic<uint64_t> g_solTransactions(0);
+static atomic<uint64_t> g_solRejections(0);
+static atomic<uint64_t> g_solFailureCount(0);
+static mutex g_solFailuresLock;
+
+// The state of the current run. Each thread owns exactly one run at a time.
+struct RunState
+{
+    // The seed of this run, and the PRNG state derived from it.
+    uint64_t seed;
+    uint64_t rng;
+
+    // Transactions executed so far, and the bound for this run.
+    uint64_t transactions;
+    uint64_t depth;
+
+    // Swarm configuration: the transactions which may be selected, and how
+    // often (out of 256) a value is restricted to a single byte.
+    bitset<256> enabled;
+    uint8_t small_bias;
+
+    // Restored when a run is rejected or fails.
+    jmp_buf env;
+};
+
+static thread_local RunState g_solRun;
+
+// -------------------------------------------------------------------------- //
+
+// Produces the next value of the PRNG (splitmix64).
+uint64_t next_random(void)
+{
+    uint64_t z = (g_solRun.rng += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint8_t next_byte(void)
+{
+    return (uint8_t)(next_random() >> 56);
+}
+
+// Resets the current thread to run _seed. The swarm configuration is drawn
+// from the PRNG before any value is given to the model. The depth of the run
+// also depends on --depth, so both are needed to replay the run.
+void configure_run(uint64_t _seed)
+{
+    g_solRun.seed = _seed;
+    g_solRun.rng = _seed;
+    g_solRun.transactions = 0;
+
+    g_solRun.depth = 1 + (next_random() % g_solDepth);
+
+    // Each transaction is enabled with probability one half.
+    for (size_t i = 0; i < g_solRun.enabled.size(); i += 64)
+    {
+        uint64_t bits = next_random();
+        for (size_t j = 0; j < 64; ++j)
+        {
+            g_solRun.enabled[i + j] = ((bits >> j) & 1);
+        }
+    }
+
+    // Picks one of: no bias, a weak bias, or a strong bias.
+    static const uint8_t BIASES[] = { 0, 64, 192 };
+    g_solRun.small_bias = BIASES[next_random() % 3];
+}
+
+// Terminates the current run, as rejected, unless _cond holds.
+void reject_unless(bool _cond);
+
+// Terminates the current run. If _failed, then the arguments which replay the
+// run are recorded.
+void end_run(bool _failed)
+{
+    if (_failed)
+    {
+        lock_guard<mutex> guard(g_solFailuresLock);
+        ofstream out(g_solFailures, ios::app);
+        out << "--" << g_solReplayArg << "=" << g_solRun.seed << " "
+            << "--" << g_solDepthArg << "=" << g_solDepth << endl;
+    }
+    longjmp(g_solRun.env, 1);
+}
+
+// Executes a single run, with the given seed.
+void simulate(uint64_t _seed)
+{
+    configure_run(_seed);
+    if (setjmp(g_solRun.env) == 0)
+    {
+        run_model();
+    }
+    g_solTransactions += g_solRun.transactions;
+}
+
+// Executes runs until all _runs have been claimed.
+void simulate_worker(uint64_t _first, uint64_t _runs)
+{
+    for (uint64_t i = g_solNextRun++; i < _runs; i = g_solNextRun++)
+    {
+        simulate(_first + i);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+int main(int _argc, const char **_argv)
+{
+    unsigned int threads = 0;
+    uint64_t runs = 100000;
+    uint64_t seed = 1;
+
+    try
+    {
+        namespace po = boost::program_options;
+
+        po::options_description desc("Random Simulation C Model Options.");
+        desc.add_options()
+            (g_solHelpCliArg, g_solHelpCliMsg)
+            (g_solThreadsArg, po::value(&threads), g_solThreadsMsg)
+            (g_solRunsArg, po::value(&runs), g_solRunsMsg)
+            (g_solDepthArg, po::value(&g_solDepth), g_solDepthMsg)
+            (g_solSeedArg, po::value(&seed), g_solSeedMsg)
+            (g_solReplayArg, po::value<uint64_t>(), g_solReplayMsg)
+            (g_solFailuresArg, po::value(&g_solFailures), g_solFailuresMsg);
+
+        po::variables_map args;
+        po::store(po::parse_command_line(_argc, _argv, desc), args);
+        po::notify(args);
+
+        if (args.count(g_solHelpCliArg))
+        {
+            cout << desc << endl;
+            return 0;
+        }
+
+        if (args.count(g_solReplayArg))
+        {
+            g_solReplay = true;
+            seed = args[g_solReplayArg].as<uint64_t>();
+        }
+    }
+    catch (exception const& e)
+    {
+        cerr << "Random Simulation Setup Error: " << e.what() << endl;
+        return -1;
+    }
+
+    if (g_solDepth == 0)
+    {
+        cerr << "Random Simulation Setup Error: depth must be positive.";
+        cerr << endl;
+        return -1;
+    }
+
+    if (g_solReplay)
+    {
+        simulate(seed);
+        return (g_solFailureCount > 0 ? -1 : 0);
+    }
+
+    #ifdef MC_USE_COVERAGE
+    g_solRequireProfile.setup();
+    #endif
+
+    if (threads == 0)
+    {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    auto const START = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        pool.emplace_back(simulate_worker, seed, runs);
+    }
+    for (auto & worker : pool)
+    {
+        worker.join();
+    }
+    auto const END = chrono::steady_clock::now();
+
+    chrono::duration<double> const ELAPSED = (END - START);
+    double const SECONDS = max(ELAPSED.count(), 1e-9);
+    cout << "Threads: " << threads << endl
+         << "Runs: " << runs << endl
+         << "Transactions: " << g_solTransactions << endl
+         << "Rejected Runs: " << g_solRejections << endl
+         << "Failed Runs: " << g_solFailureCount << endl
+         << "Seconds: " << SECONDS << endl
+         << "Transactions/Second: " << (g_solTransactions / SECONDS) << endl;
+
+    return (g_solFailureCount > 0 ? -1 : 0);
+}
+
+// -------------------------------------------------------------------------- //
+
+void sol_setup(int, const char **) {}
+
+// -------------------------------------------------------------------------- //
+
+sol_raw_uint8_t sol_crypto(void)
+{
+    return nd_byte(0, "Select crypto value");
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t sol_continue(void)
+{
+    return (g_solRun.transactions < g_solRun.depth);
+}
+
+// -------------------------------------------------------------------------- //
+
+void sol_on_transaction(void)
+{
+    ++g_solRun.transactions;
+
+    #ifdef MC_USE_COVERAGE
+    g_solRequireProfile.poll();
+    #endif
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t sol_can_infer(void)
+{
+    return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+void sol_assert(sol_raw_uint8_t _cond, const char* _msg)
+{
+    if (!_cond)
+    {
+        ++g_solFailureCount;
+
+        // The message is written at once, as other threads share cerr.
+        ostringstream out;
+        out << "assert";
+        if (_msg)
+        {
+            out << ": " << _msg;
+        }
+        out << " [seed " << g_solRun.seed << ", depth " << g_solDepth << "]";
+        out << endl;
+        cerr << out.str();
+        end_run(!g_solReplay);
+    }
+}
+
+void sol_require(sol_raw_uint8_t _cond, const char* _msg)
+{
+    if (!_cond && g_solReplay)
+    {
+        cout << "require";
+        if (_msg)
+        {
+            cout << ": " << _msg;
+        }
+        cout << endl;
+    }
+
+    #ifdef MC_USE_COVERAGE
+    g_solRequireProfile.record(RequireProfile::UNLABELED, (bool)_cond);
+    #endif
+    reject_unless((bool)_cond);
+}
+
+#ifdef MC_USE_COVERAGE
+void sol_require_at(uint32_t _site, sol_raw_uint8_t _cond, const char* _msg)
+{
+    if (!_cond && g_solReplay)
+    {
+        cout << "require [site " << _site << "]";
+        if (_msg)
+        {
+            cout << ": " << _msg;
+        }
+        cout << endl;
+    }
+
+    g_solRequireProfile.record(_site, (bool)_cond, _msg);
+    reject_unless((bool)_cond);
+}
+
+void ll_assume_at(uint32_t _site, sol_raw_uint8_t _cond)
+{
+    if (!_cond && g_solReplay)
+    {
+        cout << "assume [site " << _site << "]" << endl;
+    }
+
+    g_solRequireProfile.record(_site, (bool)_cond, "[assume]");
+    reject_unless((bool)_cond);
+}
+
+void sol_cover_call(uint8_t) {}
+#endif
+
+// -------------------------------------------------------------------------- //
+
+void sol_emit(const char* _msg)
+{
+    if (g_solReplay)
+    {
+        cout << "Emit: " << _msg << endl;
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void ll_assume(sol_raw_uint8_t _cond)
+{
+    #ifdef MC_USE_COVERAGE
+    g_solRequireProfile.record(RequireProfile::ASSUME, (bool)_cond);
+    #endif
+    reject_unless((bool)_cond);
+}
+
+void reject_unless(bool _cond)
+{
+    if (!_cond)
+    {
+        ++g_solRejections;
+        end_run(false);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void smartace_log(const char* _msg)
+{
+    if (g_solReplay)
+    {
+        cout << _msg << endl;
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+template <typename T>
+void on_entry(const char* _type, const char* _msg, T _val)
+{
+    if (g_solReplay)
+    {
+        cout << _msg << " [" << _type << "]: " << _val << endl;
+    }
+}
+
+void on_entry(const char* _type, const char* _msg, uint8_t _val)
+{
+    on_entry<unsigned int>(_type, _msg, _val);
+}
+
+void on_entry(const char* _type, const char* _msg, int8_t _val)
+{
+    on_entry<int>(_type, _msg, _val);
+}
+
+uint8_t nd_byte(int8_t, const char* _msg)
+{
+    uint8_t retval = next_byte();
+    on_entry("uint8", _msg, retval);
+    return retval;
+}
+
+uint8_t nd_range(int8_t, uint8_t _l, uint8_t _u, const char* _msg)
+{
+    // Transactions are chosen from those enabled by the swarm configuration.
+    // If none are enabled, then all transactions are used.
+    uint8_t enabled = 0;
+    if (strcmp(_msg, "next_call") == 0)
+    {
+        for (unsigned int i = _l; i < _u; ++i)
+        {
+            enabled += g_solRun.enabled[i];
+        }
+    }
+
+    uint8_t retval = _l;
+    if (enabled > 0)
+    {
+        uint8_t pick = next_byte() % enabled;
+        while (!g_solRun.enabled[retval] || pick-- > 0) ++retval;
+    }
+    else
+    {
+        retval += (next_byte() % (_u - _l));
+    }
+
+    on_entry("uint8", _msg, retval);
+    return retval;
+}
+
+// -------------------------------------------------------------------------- //
+
+// Produces a value of _bytes random bytes. Depending on the swarm
+// configuration, the value may instead be restricted to a single byte.
+template <typename T>
+T nd_value(size_t _bytes, const char* _type, const char* _msg)
+{
+    if (next_byte() < g_solRun.small_bias)
+    {
+        _bytes = 1;
+    }
+
+    T retval = 0;
+    for (size_t i = _bytes; i > 0; i--)
+    {
+        retval = retval << 8;
+        retval = retval + (T)next_byte();
+    }
+
+    on_entry(_type, _msg, retval);
+    return retval;
+}
+
+sol_raw_uint256_t nd_increase(
+    sol_raw_int256_t,
+    sol_raw_uint256_t _curr,
+    uint8_t _strict,
+    const char* _msg
+)
+{
+    if (_strict)
+    {
+        ll_assume(_curr < SOL_UINT256_MAX);
+        _curr += 1;
+    }
+
+    sol_raw_uint256_t max_increase = SOL_UINT256_MAX - _curr;
+    if (max_increase > 0)
+    {
+        sol_raw_uint256_t delta = nd_uint256_t(0, _msg) % max_increase;
+        _curr += delta;
+    }
+
+    return _curr;
+}
+
+// -------------------------------------------------------------------------- //
+
+#define SOL_ND_IMPL(BITS) \
+    sol_raw_int ## BITS ## _t nd_int ## BITS ## _t( \
+        sol_raw_int ## BITS ## _t, const char* _msg \
+    ) { \
+        return nd_value<sol_raw_int ## BITS ## _t>( \
+            BITS / 8, "int" #BITS, _msg \
+        ); \
+    } \
+    sol_raw_uint ## BITS ## _t nd_uint ## BITS ## _t( \
+        sol_raw_int ## BITS ## _t, const char* _msg \
+    ) { \
+        return nd_value<sol_raw_uint ## BITS ## _t>( \
+            BITS / 8, "uint" #BITS, _msg \
+        ); \
+    }
+
+SOL_ND_IMPL(8)
+SOL_ND_IMPL(16)
+SOL_ND_IMPL(24)
+SOL_ND_IMPL(32)
+SOL_ND_IMPL(40)
+SOL_ND_IMPL(48)
+SOL_ND_IMPL(56)
+SOL_ND_IMPL(64)
+SOL_ND_IMPL(72)
+SOL_ND_IMPL(80)
+SOL_ND_IMPL(88)
+SOL_ND_IMPL(96)
+SOL_ND_IMPL(104)
+SOL_ND_IMPL(112)
+SOL_ND_IMPL(120)
+SOL_ND_IMPL(128)
+SOL_ND_IMPL(136)
+SOL_ND_IMPL(144)
+SOL_ND_IMPL(152)
+SOL_ND_IMPL(160)
+SOL_ND_IMPL(168)
+SOL_ND_IMPL(176)
+SOL_ND_IMPL(184)
+SOL_ND_IMPL(192)
+SOL_ND_IMPL(200)
+SOL_ND_IMPL(208)
+SOL_ND_IMPL(216)
+SOL_ND_IMPL(224)
+SOL_ND_IMPL(232)
+SOL_ND_IMPL(240)
+SOL_ND_IMPL(248)
+SOL_ND_IMPL(256)
+
+// Each value of a batch is drawn independently, as by the scalar methods.
+#define SOL_ND_ARRAY_IMPL(BITS) \
+    void nd_int ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t, \
+        size_t _n, \
+        sol_raw_int ## BITS ## _t* _out, \
+        const char* _msg \
+    ) { \
+        for (size_t i = 0; i < _n; ++i) \
+        { \
+            _out[i] = nd_value<sol_raw_int ## BITS ## _t>( \
+                BITS / 8, "int" #BITS, _msg \
+            ); \
+        } \
+    } \
+    void nd_uint ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t, \
+        size_t _n, \
+        sol_raw_uint ## BITS ## _t* _out, \
+        const char* _msg \
+    ) { \
+        for (size_t i = 0; i < _n; ++i) \
+        { \
+            _out[i] = nd_value<sol_raw_uint ## BITS ## _t>( \
+                BITS / 8, "uint" #BITS, _msg \
+            ); \
+        } \
+    }
+
+SOL_WIDTHS(SOL_ND_ARRAY_IMPL)
+
+// -------------------------------------------------------------------------- //
@@ -0,0 +1,376 @@
+/**
+ * Defines a runtime which generates a seed corpus for libfuzzer. For each
+ * transaction of the model, the model is executed until the contracts are
+ * initialized, and that transaction has run once without failing a require.
+ * Every byte consumed along the way is recorded, as the libfuzzer runtime would
+ * decode it, so that replaying the seed under libfuzzer reaches the same state.
+ *
+ * Usage: fuzzseed <corpus directory>
+ *
+ * @date 2021
+ */
+
+#include "verify.h"
+
+#include <csetjmp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// -------------------------------------------------------------------------- //
+
+// The number of executions attempted for each transaction.
+static const size_t g_solAttempts = 1024;
+
+// The state of the current attempt.
+struct SeedState
+{
+    // The PRNG state of this attempt.
+    uint64_t rng;
+
+    // The transaction to execute, and the number of transactions in the model.
+    // The count is learned from the first selection of next_call.
+    size_t target;
+    size_t cases;
+
+    // The number of transactions which have started.
+    size_t transactions;
+
+    // If true, values are restricted to their lowest byte.
+    bool small;
+
+    // The bytes consumed so far, as seen by libfuzzer.
+    vector<uint8_t> bytes;
+
+    // Restored when an attempt ends. The result is one of the outcomes below.
+    jmp_buf env;
+};
+
+enum SeedOutcome { RUNNING, ACCEPTED, REJECTED };
+
+static SeedState g_solSeed;
+
+// -------------------------------------------------------------------------- //
+
+// Produces the next value of the PRNG (splitmix64).
+uint64_t next_random(void)
+{
+    uint64_t z = (g_solSeed.rng += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Records _byte as the next byte of the seed.
+uint8_t record(uint8_t _byte)
+{
+    g_solSeed.bytes.push_back(_byte);
+    return _byte;
+}
+
+// Executes the model once, in search of a seed for _target. Returns true if
+// the seed was found.
+bool attempt(size_t _target, size_t _attempt)
+{
+    g_solSeed.rng = (_target << 32) + _attempt;
+    g_solSeed.target = _target;
+    g_solSeed.transactions = 0;
+    g_solSeed.small = (_attempt % 4 != 3);
+    g_solSeed.bytes.clear();
+
+    int outcome = setjmp(g_solSeed.env);
+    if (outcome == RUNNING)
+    {
+        run_model();
+    }
+    return (outcome == ACCEPTED);
+}
+
+// Writes the bytes of the current seed to _path.
+bool write_seed(string const& _path)
+{
+    ofstream out(_path, ios::binary);
+    out.write((char const*)g_solSeed.bytes.data(), g_solSeed.bytes.size());
+    return (bool)out;
+}
+
+// -------------------------------------------------------------------------- //
+
+int main(int _argc, const char **_argv)
+{
+    if (_argc != 2)
+    {
+        cerr << "Usage: " << _argv[0] << " <corpus directory>" << endl;
+        return -1;
+    }
+
+    string const DIR(_argv[1]);
+    g_solSeed.cases = 1;
+
+    size_t found = 0;
+    for (size_t target = 0; target < g_solSeed.cases; ++target)
+    {
+        bool success = false;
+        for (size_t i = 0; !success && i < g_solAttempts; ++i)
+        {
+            success = attempt(target, i);
+        }
+
+        if (!success)
+        {
+            cerr << "No seed found for transaction " << target << "." << endl;
+        }
+        else if (!write_seed(DIR + "/seed_" + to_string(target)))
+        {
+            cerr << "Unable to write seed to " << DIR << "." << endl;
+            return -1;
+        }
+        else
+        {
+            ++found;
+        }
+    }
+
+    cout << "Seeds: " << found << " of " << g_solSeed.cases << endl;
+    return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+void sol_setup(int, const char **) {}
+
+// -------------------------------------------------------------------------- //
+
+sol_raw_uint8_t sol_crypto(void)
+{
+    return nd_byte(0, "Select crypto value");
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t sol_continue(void)
+{
+    return 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+void sol_on_transaction(void)
+{
+    // The second transaction begins once the target has succeeded.
+    ++g_solSeed.transactions;
+    if (g_solSeed.transactions > 1)
+    {
+        longjmp(g_solSeed.env, ACCEPTED);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t sol_can_infer(void)
+{
+    return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+void sol_assert(sol_raw_uint8_t _cond, const char* _msg)
+{
+    // A failing seed is kept, as it reproduces a violation.
+    if (!_cond)
+    {
+        cerr << "assert";
+        if (_msg)
+        {
+            cerr << ": " << _msg;
+        }
+        cerr << " [transaction " << g_solSeed.target << "]" << endl;
+        longjmp(g_solSeed.env, ACCEPTED);
+    }
+}
+
+void sol_require(sol_raw_uint8_t _cond, const char*)
+{
+    ll_assume(_cond);
+}
+
+#ifdef MC_USE_COVERAGE
+void sol_require_at(uint32_t, sol_raw_uint8_t _cond, const char*)
+{
+    ll_assume(_cond);
+}
+
+void ll_assume_at(uint32_t, sol_raw_uint8_t _cond)
+{
+    ll_assume(_cond);
+}
+
+void sol_cover_call(uint8_t) {}
+#endif
+
+// -------------------------------------------------------------------------- //
+
+void sol_emit(const char*) {}
+
+// -------------------------------------------------------------------------- //
+
+void ll_assume(sol_raw_uint8_t _cond)
+{
+    if (!_cond)
+    {
+        longjmp(g_solSeed.env, REJECTED);
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+void smartace_log(const char*) {}
+
+// -------------------------------------------------------------------------- //
+
+uint8_t nd_byte(int8_t, const char*)
+{
+    return record((uint8_t)next_random());
+}
+
+uint8_t nd_range(int8_t, uint8_t _l, uint8_t _u, const char* _msg)
+{
+    // libfuzzer decodes a range from a single byte b, as (b % (u - l)) + l.
+    uint8_t offset;
+    if (strcmp(_msg, "next_call") == 0)
+    {
+        g_solSeed.cases = (_u - _l);
+        offset = g_solSeed.target;
+    }
+    else
+    {
+        offset = (next_random() % (_u - _l));
+    }
+    return _l + record(offset);
+}
+
+// -------------------------------------------------------------------------- //
+
+// Produces a value of _bytes bytes, decoded as in the libfuzzer runtime. Unless
+// the attempt allows large values, only the final byte is non-zero.
+template <typename T>
+T nd_value(size_t _bytes)
+{
+    T retval = 0;
+    for (size_t i = _bytes; i > 0; i--)
+    {
+        uint8_t byte = 0;
+        if (i == 1 || !g_solSeed.small)
+        {
+            byte = (uint8_t)next_random();
+        }
+
+        retval = retval << 8;
+        retval = retval + (T)record(byte);
+    }
+    return retval;
+}
+
+sol_raw_uint256_t nd_increase(
+    sol_raw_int256_t,
+    sol_raw_uint256_t _curr,
+    uint8_t _strict,
+    const char* _msg
+)
+{
+    if (_strict)
+    {
+        ll_assume(_curr < SOL_UINT256_MAX);
+        _curr += 1;
+    }
+
+    sol_raw_uint256_t max_increase = SOL_UINT256_MAX - _curr;
+    if (max_increase > 0)
+    {
+        sol_raw_uint256_t delta = nd_uint256_t(0, _msg) % max_increase;
+        _curr += delta;
+    }
+
+    return _curr;
+}
+
+// -------------------------------------------------------------------------- //
+
+#define SOL_ND_IMPL(BITS) \
+    sol_raw_int ## BITS ## _t nd_int ## BITS ## _t( \
+        sol_raw_int ## BITS ## _t, const char* \
+    ) { \
+        return nd_value<sol_raw_int ## BITS ## _t>(BITS / 8); \
+    } \
+    sol_raw_uint ## BITS ## _t nd_uint ## BITS ## _t( \
+        sol_raw_int ## BITS ## _t, const char* \
+    ) { \
+        return nd_value<sol_raw_uint ## BITS ## _t>(BITS / 8); \
+    }
+
+SOL_ND_IMPL(8)
+SOL_ND_IMPL(16)
+SOL_ND_IMPL(24)
+SOL_ND_IMPL(32)
+SOL_ND_IMPL(40)
+SOL_ND_IMPL(48)
+SOL_ND_IMPL(56)
+SOL_ND_IMPL(64)
+SOL_ND_IMPL(72)
+SOL_ND_IMPL(80)
+SOL_ND_IMPL(88)
+SOL_ND_IMPL(96)
+SOL_ND_IMPL(104)
+SOL_ND_IMPL(112)
+SOL_ND_IMPL(120)
+SOL_ND_IMPL(128)
+SOL_ND_IMPL(136)
+SOL_ND_IMPL(144)
+SOL_ND_IMPL(152)
+SOL_ND_IMPL(160)
+SOL_ND_IMPL(168)
+SOL_ND_IMPL(176)
+SOL_ND_IMPL(184)
+SOL_ND_IMPL(192)
+SOL_ND_IMPL(200)
+SOL_ND_IMPL(208)
+SOL_ND_IMPL(216)
+SOL_ND_IMPL(224)
+SOL_ND_IMPL(232)
+SOL_ND_IMPL(240)
+SOL_ND_IMPL(248)
+SOL_ND_IMPL(256)
+
+// Each value of a batch is recorded as if by the scalar methods.
+#define SOL_ND_ARRAY_IMPL(BITS) \
+    void nd_int ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t, \
+        size_t _n, \
+        sol_raw_int ## BITS ## _t* _out, \
+        const char* \
+    ) { \
+        for (size_t i = 0; i < _n; ++i) \
+        { \
+            _out[i] = nd_value<sol_raw_int ## BITS ## _t>(BITS / 8); \
+        } \
+    } \
+    void nd_uint ## BITS ## _array( \
+        sol_raw_int ## BITS ## _t, \
+        size_t _n, \
+        sol_raw_uint ## BITS ## _t* _out, \
+        const char* \
+    ) { \
+        for (size_t i = 0; i < _n; ++i) \
+        { \
+            _out[i] = nd_value<sol_raw_uint ## BITS ## _t>(BITS / 8); \
+        } \
+    }
+
+SOL_WIDTHS(SOL_ND_ARRAY_IMPL)
+
+// -------------------------------------------------------------------------- //
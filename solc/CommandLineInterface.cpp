@@ -46,6 +46,7 @@
 #include <libsolidity/modelcheck/analysis/CallState.h>
 #include <libsolidity/modelcheck/analysis/Primitives.h>
 #include <libsolidity/modelcheck/cli/Bundle.h>
+#include <libsolidity/modelcheck/codegen/Details.h>
 #include <libsolidity/modelcheck/model/ADT.h>
 #include <libsolidity/modelcheck/model/Ether.h>
 #include <libsolidity/modelcheck/model/Function.h>
@@ -53,6 +54,8 @@
 #include <libsolidity/modelcheck/scheduler/MainFunction.h>
 #include <libsolidity/modelcheck/utils/AbstractAddressDomain.h>
 #include <libsolidity/modelcheck/utils/Function.h>
+#include <libsolidity/modelcheck/utils/LibVerify.h>
+#include <libsolidity/modelcheck/utils/Primitives.h>
 
 #include <libyul/AssemblyStack.h>
 
@@ -141,6 +144,20 @@ static string const g_strModelInvarRule = "invar-rule";
 static string const g_strModelInvarType = "invar-type";
 static string const g_strModelInvarInfer = "invar-infer";
 static string const g_strModelInvarStateful = "invar-stateful";
+static string const g_strModelReduceOrder = "reduce-order";
+static string const g_strModelReduceUsers = "reduce-users";
+static string const g_strModelArrayMaps = "array-maps";
+static string const g_strModelReentrant = "reentrant";
+static string const g_strModelCoverage = "coverage";
+static string const g_strModelSnapshots = "snapshots";
+static string const g_strModelFuseModifiers = "fuse-modifiers";
+static string const g_strModelUnwrapPrimitives = "unwrap-primitives";
+static string const g_strModelSimplify = "simplify";
+static string const g_strModelCacheMaps = "cache-map-reads";
+static string const g_strModelBoundLoops = "bound-loops";
+static string const g_strModelUnrollLimit = "unroll-limit";
+static string const g_strModelKeepGetters = "keep-getters";
+static string const g_strModelNativeCrypto = "native-crypto";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -205,6 +222,20 @@ static string const g_argModelInvarRule = g_strModelInvarRule;
 static string const g_argModelInvarType = g_strModelInvarType;
 static string const g_argModelInvarInfer = g_strModelInvarInfer;
 static string const g_argModelInvarStateful = g_strModelInvarStateful;
+static string const g_argModelReduceOrder = g_strModelReduceOrder;
+static string const g_argModelReduceUsers = g_strModelReduceUsers;
+static string const g_argModelArrayMaps = g_strModelArrayMaps;
+static string const g_argModelReentrant = g_strModelReentrant;
+static string const g_argModelCoverage = g_strModelCoverage;
+static string const g_argModelSnapshots = g_strModelSnapshots;
+static string const g_argModelFuseModifiers = g_strModelFuseModifiers;
+static string const g_argModelUnwrapPrimitives = g_strModelUnwrapPrimitives;
+static string const g_argModelSimplify = g_strModelSimplify;
+static string const g_argModelCacheMaps = g_strModelCacheMaps;
+static string const g_argModelBoundLoops = g_strModelBoundLoops;
+static string const g_argModelUnrollLimit = g_strModelUnrollLimit;
+static string const g_argModelKeepGetters = g_strModelKeepGetters;
+static string const g_argModelNativeCrypto = g_strModelNativeCrypto;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argGas = g_strGas;
@@ -860,6 +891,76 @@ Allowed options)",
 			g_argModelInvarStateful.c_str(),
 			po::value<bool>()->value_name("on")->default_value(false),
 			"Allows compositional invariants to depend on shared contract state."
+		)
+		(
+			g_argModelReduceOrder.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Explores commuting transactions in a single canonical order (partial-order reduction)."
+		)
+		(
+			g_argModelReduceUsers.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Explores interchangeable users in a single canonical order (symmetry reduction)."
+		)
+		(
+			g_argModelArrayMaps.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Stores mappings as arrays, and applies interference through loops over each array."
+		)
+		(
+			g_argModelReentrant.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Moves all global model state into a per-instance context (see MC_USE_REENTRANT)."
+		)
+		(
+			g_argModelCoverage.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Labels each transaction and require site for coverage feedback and profiling (see MC_USE_COVERAGE)."
+		)
+		(
+			g_argModelSnapshots.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Offers the world state to the runtime between transactions, so that setup may be resumed from a cache (see MC_USE_SNAPSHOTS)."
+		)
+		(
+			g_argModelFuseModifiers.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Generates each function and its modifiers as a single C function, whenever every modifier ends in its only placeholder."
+		)
+		(
+			g_argModelUnwrapPrimitives.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Declares each primitive type as a typedef of its raw type, rather than as a single-field structure."
+		)
+		(
+			g_argModelSimplify.c_str(),
+			po::value<bool>()->value_name("on")->default_value(true),
+			"Folds constants, and removes dead branches and redundant casts, from each generated function."
+		)
+		(
+			g_argModelCacheMaps.c_str(),
+			po::value<bool>()->value_name("on")->default_value(true),
+			"Keeps map entries which are accessed several times in straight-line code in temporaries."
+		)
+		(
+			g_argModelBoundLoops.c_str(),
+			po::value<bool>()->value_name("on")->default_value(true),
+			"Bounds each loop over a constant range of counter values by its iteration count."
+		)
+		(
+			g_argModelUnrollLimit.c_str(),
+			po::value<size_t>()->value_name("n")->default_value(8),
+			"Unrolls each bounded loop that always runs n or fewer iterations (requires --bound-loops)."
+		)
+		(
+			g_argModelKeepGetters.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Schedules transactions which can neither change the model state nor fail an assertion (e.g., getters). By default, these are omitted."
+		)
+		(
+			g_argModelNativeCrypto.c_str(),
+			po::value<bool>()->value_name("on")->default_value(false),
+			"Passes the encoded operands of keccak256 to libverify, so that native runtimes compute the hash. Otherwise, or for symbolic runtimes, hashes are nondeterministic."
 		);
 	desc.add(smartaceOptions);
 
@@ -1314,8 +1415,10 @@ void CommandLineInterface::handleCModel()
 	using dev::solidity::modelcheck::AnalysisSettings;
 	using dev::solidity::modelcheck::AnalysisStack;
 	using dev::solidity::modelcheck::BundleExtractor;
+	using dev::solidity::modelcheck::CFuncDef;
 	using dev::solidity::modelcheck::CompInvarGenerator;
 	using dev::solidity::modelcheck::NondetSourceRegistry;
+	using dev::solidity::modelcheck::PrimitiveToRaw;
 	using dev::solidity::modelcheck::PrimitiveTypeGenerator;
 
 	// Processes invariant rule choice.
@@ -1426,10 +1529,22 @@ void CommandLineInterface::handleCModel()
 	settings.use_global_contracts = (m_args.count(g_argModelFailOnRequire) > 0);
 	settings.escalate_reqs = (m_args.count(g_argModelFailOnRequire) > 0);
 	settings.allow_fallbacks = m_args[g_argModelAllowFallbacks].as<bool>();
+	settings.cache_map_reads = m_args[g_argModelCacheMaps].as<bool>();
+	settings.bound_loops = m_args[g_argModelBoundLoops].as<bool>();
+	settings.unroll_limit = m_args[g_argModelUnrollLimit].as<size_t>();
+	settings.native_crypto = m_args[g_argModelNativeCrypto].as<bool>();
+	settings.reduce_order = m_args[g_argModelReduceOrder].as<bool>();
+	settings.reduce_users = m_args[g_argModelReduceUsers].as<bool>();
+	settings.reentrant = m_args[g_argModelReentrant].as<bool>();
+	settings.snapshots = m_args[g_argModelSnapshots].as<bool>();
+	settings.elide_getters = !m_args[g_argModelKeepGetters].as<bool>();
+	settings.instrument = m_args[g_argModelCoverage].as<bool>();
 	auto astack = make_shared<AnalysisStack>(bundle.get(), asts, settings);
 
 	// Aggregates primitive types.
 	// TODO(scottwe): use flat model and move to model.
+	bool const unwrap_primitives = m_args[g_argModelUnwrapPrimitives].as<bool>();
+	bool const simplify_bodies = m_args[g_argModelSimplify].as<bool>();
 	PrimitiveTypeGenerator primitive_set;
 	for (auto const* ast: asts)
 	{
@@ -1450,17 +1565,27 @@ void CommandLineInterface::handleCModel()
 		copyDirectory((m_install_dir / "include/solc/yaml").string(), "yaml", true);
 
 		stringstream cmodel_cpp_data, cmodel_h_data, primitive_data, harness_data;
+		stringstream dict_data;
+		PrimitiveToRaw::unwrap(cmodel_cpp_data, unwrap_primitives);
+		PrimitiveToRaw::unwrap(cmodel_h_data, unwrap_primitives);
+		PrimitiveToRaw::unwrap(primitive_data, unwrap_primitives);
+		CFuncDef::simplify_bodies(cmodel_cpp_data, simplify_bodies);
+		CFuncDef::simplify_bodies(cmodel_h_data, simplify_bodies);
+		CFuncDef::simplify_bodies(primitive_data, simplify_bodies);
 		handleCModelHarness(harness_data);
 		handleCModelHeaders(astack, nondet_reg, cmodel_h_data);
-		handleCModelBody(invar_rule, invar_type, astack, nondet_reg, cmodel_cpp_data);
+		handleCModelBody(invar_rule, invar_type, astack, nondet_reg, cmodel_cpp_data, &dict_data);
 		handleCModelPrimitives(primitive_set, *nondet_reg, primitive_data);
 		createFile("primitive.h", primitive_data.str());
 		createFile("cmodel.h", cmodel_h_data.str());
 		createFile("cmodel.c", cmodel_cpp_data.str());
 		createFile("harness.c", harness_data.str());
+		createFile("fuzz.dict", dict_data.str());
 	}
 	else
 	{
+		PrimitiveToRaw::unwrap(sout(), unwrap_primitives);
+		CFuncDef::simplify_bodies(sout(), simplify_bodies);
 		sout() << "======= harness.c(pp) =======" << endl;
 		handleCModelHarness(sout());
 		sout() << endl << endl << "======= cmodel.h =======" << endl;
@@ -1470,6 +1595,8 @@ void CommandLineInterface::handleCModel()
 		sout() << "====== primitive.h =====" << endl;
 		handleCModelPrimitives(primitive_set, *nondet_reg, sout());
 		sout() << endl;
+		PrimitiveToRaw::unwrap(sout(), false);
+		CFuncDef::simplify_bodies(sout(), false);
 	}
 }
 
@@ -1506,18 +1633,32 @@ void CommandLineInterface::handleCModelHeaders(
 	using dev::solidity::modelcheck::FunctionConverter;
 
 	bool sum_maps = (m_args.count(g_argModelMapSum) > 0);
+	bool array_maps = m_args[g_argModelArrayMaps].as<bool>();
+	bool fuse_mods = m_args[g_argModelFuseModifiers].as<bool>();
 	size_t addr_ct = _stack->addresses()->count();
 
-	_os << "#pragma once" << endl
-	    << "#include \"primitive.h\"" << endl;
+	_os << "#pragma once" << endl;
+	if (_stack->settings().reentrant)
+	{
+		// Marks the model for runtimes which run several instances at once.
+		_os << "#define SOL_MODEL_REENTRANT" << endl;
+	}
+	_os << "#include \"primitive.h\"" << endl;
 	_os << "void run_model(void);";
 
 	EtherMethodGenerator(_stack, _nd_reg).print(_os, true);
 
-	ADTConverter(_stack, sum_maps, addr_ct, true).print(_os);
+	ADTConverter(_stack, sum_maps, addr_ct, true, array_maps).print(_os);
 
 	FunctionConverter(
-		_stack, _nd_reg, sum_maps, addr_ct, FunctionConverter::View::EXT, true
+		_stack,
+		_nd_reg,
+		sum_maps,
+		addr_ct,
+		FunctionConverter::View::EXT,
+		true,
+		array_maps,
+		fuse_mods
 	).print(_os);
 }
 
@@ -1526,20 +1667,23 @@ void CommandLineInterface::handleCModelBody(
 	modelcheck::CompInvarGenerator::InvarType _invar_type,
 	shared_ptr<modelcheck::AnalysisStack> _stack,
 	shared_ptr<modelcheck::NondetSourceRegistry> _nd_reg,
-	ostream& _os
+	ostream& _os,
+	ostream* _dict_os
 )
 {
-	using dev::solidity::modelcheck::AbstractAddressDomain;
 	using dev::solidity::modelcheck::ADTConverter;
-	using dev::solidity::modelcheck::CVarDecl;
 	using dev::solidity::modelcheck::EtherMethodGenerator;
 	using dev::solidity::modelcheck::FunctionConverter;
+	using dev::solidity::modelcheck::LibVerify;
 	using dev::solidity::modelcheck::MainFunctionGenerator;
 
 	// Parses general arguments.
 	bool sum_maps = (m_args.count(g_argModelMapSum) > 0);
 	size_t addr_ct = _stack->addresses()->count();
 	bool lockstep_time = m_args[g_argModelLockstepTime].as<bool>();
+	bool array_maps = m_args[g_argModelArrayMaps].as<bool>();
+	bool fuse_mods = m_args[g_argModelFuseModifiers].as<bool>();
+	bool coverage = _stack->settings().instrument;
 
 	// Parses invariant arguments.
 	modelcheck::CompInvarGenerator::Settings invar_settings;
@@ -1547,6 +1691,7 @@ void CommandLineInterface::handleCModelBody(
 	invar_settings.type = _invar_type;
 	invar_settings.stateful = m_args[g_argModelInvarStateful].as<bool>();
 	invar_settings.inferred = m_args[g_argModelInvarInfer].as<bool>();
+	invar_settings.array_maps = array_maps;
 
 	// Includes header.
 	_os << "#include \"cmodel.h\"" << endl;
@@ -1555,21 +1700,14 @@ void CommandLineInterface::handleCModelBody(
 		_os << "#include \"seahorn/seasynth.h\"" << endl;
 	}
 
-	// Generates global constants for literal addresses.
-	for (auto lit : _stack->addresses()->literals())
-	{
-		auto const NAME = AbstractAddressDomain::literal_name(lit);
-		_os << CVarDecl("sol_raw_uint160_t", NAME);
-	}
-
 	// Declares each invariant.
 	MainFunctionGenerator main(lockstep_time, invar_settings, _stack, _nd_reg);
 	main.print_invariants(_os);
 
 	// Generates structure definitions.
-	ADTConverter(_stack, sum_maps, addr_ct, false).print(_os);
+	ADTConverter(_stack, sum_maps, addr_ct, false, array_maps).print(_os);
 
-	// Lifts all global contracts.
+	// Lifts all literal addresses and global contracts.
 	main.print_globals(_os);
 
 	// Generates send/transfer/etc calls using global contracts.
@@ -1577,16 +1715,36 @@ void CommandLineInterface::handleCModelBody(
 
 	// Forward declares internal function calls.
 	FunctionConverter(
-		_stack, _nd_reg, sum_maps, addr_ct, FunctionConverter::View::INT, true
+		_stack,
+		_nd_reg,
+		sum_maps,
+		addr_ct,
+		FunctionConverter::View::INT,
+		true,
+		array_maps,
+		fuse_mods
 	).print(_os);
 
 	// Generates bodies for each function call.
 	FunctionConverter(
-		_stack, _nd_reg, sum_maps, addr_ct, FunctionConverter::View::FULL, false
+		_stack,
+		_nd_reg,
+		sum_maps,
+		addr_ct,
+		FunctionConverter::View::FULL,
+		false,
+		array_maps,
+		fuse_mods
 	).print(_os);
 
 	// Generates harness.
 	main.print_main(_os);
+
+	// Generates a fuzzing dictionary for the harness, if requested.
+	if (_dict_os)
+	{
+		main.print_dictionary(*_dict_os);
+	}
 }
 
 bool CommandLineInterface::actOnInput()
@@ -90,7 +90,8 @@ private:
 		modelcheck::CompInvarGenerator::InvarType _invar_type,
 		std::shared_ptr<modelcheck::AnalysisStack> _stack,
 		std::shared_ptr<modelcheck::NondetSourceRegistry> _nd_reg,
-		std::ostream & _os
+		std::ostream & _os,
+		std::ostream * _dict_os = nullptr
 	);
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
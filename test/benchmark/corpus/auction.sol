@@ -0,0 +1,125 @@
+/*
+ * Benchmark: an auction house, which sells a deed through an open auction. The
+ * auction refunds outbid bidders through withdrawals, and the house transfers
+ * the deed to the winner once the auction ends.
+ */
+
+pragma solidity ^0.5.0;
+
+contract Deed {
+    address private _registrar;
+    address private _owner;
+
+    constructor() public {
+        _registrar = msg.sender;
+        _owner = msg.sender;
+    }
+
+    function owner() public view returns (address) {
+        return _owner;
+    }
+
+    function setOwner(address newOwner) public {
+        require(msg.sender == _registrar, "Deed: caller is not the registrar");
+        require(newOwner != address(0), "Deed: new owner is the zero address");
+        _owner = newOwner;
+    }
+}
+
+contract Auction {
+    address private _house;
+    address payable private _beneficiary;
+    uint256 private _endTime;
+    uint256 private _reserve;
+
+    address private _highestBidder;
+    uint256 private _highestBid;
+    mapping(address => uint256) private _pendingReturns;
+    bool private _ended;
+
+    event HighestBidIncreased(address bidder, uint256 amount);
+    event AuctionEnded(address winner, uint256 amount);
+
+    constructor(
+        address payable beneficiary, uint256 endTime, uint256 reserve
+    ) public {
+        _house = msg.sender;
+        _beneficiary = beneficiary;
+        _endTime = endTime;
+        _reserve = reserve;
+    }
+
+    function highestBidder() public view returns (address) {
+        return _highestBidder;
+    }
+
+    function ended() public view returns (bool) {
+        return _ended;
+    }
+
+    function bid() public payable {
+        require(now <= _endTime, "Auction: auction already ended");
+        require(msg.value >= _reserve, "Auction: bid below reserve");
+        require(msg.value > _highestBid, "Auction: there already is a higher bid");
+
+        if (_highestBid != 0) {
+            _pendingReturns[_highestBidder] += _highestBid;
+        }
+        _highestBidder = msg.sender;
+        _highestBid = msg.value;
+        emit HighestBidIncreased(msg.sender, msg.value);
+    }
+
+    function withdraw() public returns (bool) {
+        uint256 amount = _pendingReturns[msg.sender];
+        if (amount > 0) {
+            _pendingReturns[msg.sender] = 0;
+            if (!msg.sender.send(amount)) {
+                _pendingReturns[msg.sender] = amount;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    function end() public {
+        require(msg.sender == _house, "Auction: caller is not the house");
+        require(now > _endTime, "Auction: auction not yet ended");
+        require(!_ended, "Auction: auctionEnd has already been called");
+
+        _ended = true;
+        emit AuctionEnded(_highestBidder, _highestBid);
+        _beneficiary.transfer(_highestBid);
+    }
+}
+
+contract AuctionHouse {
+    address payable private _seller;
+    Deed private _deed;
+    Auction private _auction;
+    bool private _settled;
+
+    constructor(uint256 endTime, uint256 reserve) public {
+        require(endTime > now, "AuctionHouse: end time is before current time");
+        _seller = msg.sender;
+        _deed = new Deed();
+        _auction = new Auction(msg.sender, endTime, reserve);
+    }
+
+    function settle() public {
+        require(!_settled, "AuctionHouse: already settled");
+        _settled = true;
+        _auction.end();
+
+        address winner = _auction.highestBidder();
+        if (winner != address(0)) {
+            _deed.setOwner(winner);
+        } else {
+            _deed.setOwner(_seller);
+        }
+    }
+
+    function repOK() public view {
+        assert(!_settled || _auction.ended());
+    }
+}
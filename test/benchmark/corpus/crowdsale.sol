@@ -0,0 +1,157 @@
+/*
+ * Benchmark: a capped and refundable crowdsale, in the style of OpenZeppelin.
+ * The crowdsale mints its own token, and holds all deposits in escrow until the
+ * sale is finalized.
+ */
+
+pragma solidity ^0.5.0;
+
+contract SaleToken {
+    address private _minter;
+    uint256 private _totalSupply;
+    mapping(address => uint256) private _balances;
+
+    constructor() public {
+        _minter = msg.sender;
+    }
+
+    function balanceOf(address account) public view returns (uint256) {
+        return _balances[account];
+    }
+
+    function transfer(address recipient, uint256 amount) public returns (bool) {
+        require(recipient != address(0), "ERC20: transfer to the zero address");
+        require(_balances[msg.sender] >= amount, "ERC20: transfer amount exceeds balance");
+        _balances[msg.sender] = _balances[msg.sender] - amount;
+        _balances[recipient] = _balances[recipient] + amount;
+        return true;
+    }
+
+    function mint(address account, uint256 amount) public returns (bool) {
+        require(msg.sender == _minter, "MinterRole: caller does not have the Minter role");
+        require(_totalSupply + amount >= _totalSupply, "SafeMath: addition overflow");
+        _totalSupply = _totalSupply + amount;
+        _balances[account] = _balances[account] + amount;
+        return true;
+    }
+}
+
+contract RefundEscrow {
+    enum State { Active, Refunding, Closed }
+
+    address private _primary;
+    address payable private _beneficiary;
+    State private _state;
+    mapping(address => uint256) private _deposits;
+
+    constructor(address payable beneficiary) public {
+        _primary = msg.sender;
+        _beneficiary = beneficiary;
+        _state = State.Active;
+    }
+
+    modifier onlyPrimary() {
+        require(msg.sender == _primary, "Secondary: caller is not the primary account");
+        _;
+    }
+
+    function deposit(address refundee) public payable onlyPrimary {
+        require(_state == State.Active, "RefundEscrow: can only deposit while active");
+        _deposits[refundee] = _deposits[refundee] + msg.value;
+    }
+
+    function close() public onlyPrimary {
+        require(_state == State.Active, "RefundEscrow: can only close while active");
+        _state = State.Closed;
+    }
+
+    function enableRefunds() public onlyPrimary {
+        require(_state == State.Active, "RefundEscrow: can only enable refunds while active");
+        _state = State.Refunding;
+    }
+
+    function beneficiaryWithdraw() public {
+        require(_state == State.Closed, "RefundEscrow: beneficiary can only withdraw while closed");
+        _beneficiary.transfer(address(this).balance);
+    }
+
+    function withdraw(address payable payee) public {
+        require(_state == State.Refunding, "ConditionalEscrow: payee is not allowed to withdraw");
+        uint256 payment = _deposits[payee];
+        _deposits[payee] = 0;
+        payee.transfer(payment);
+    }
+}
+
+contract Crowdsale {
+    SaleToken private _token;
+    RefundEscrow private _escrow;
+
+    uint256 private _rate;
+    uint256 private _cap;
+    uint256 private _goal;
+    uint256 private _closingTime;
+    uint256 private _weiRaised;
+    bool private _finalized;
+
+    constructor(
+        address payable wallet,
+        uint256 rate,
+        uint256 cap,
+        uint256 goal,
+        uint256 closingTime
+    ) public {
+        require(rate > 0, "Crowdsale: rate is 0");
+        require(goal > 0, "RefundableCrowdsale: goal is 0");
+        require(goal <= cap, "Crowdsale: goal is greater than cap");
+        require(closingTime > now, "TimedCrowdsale: closing time is before current time");
+        _token = new SaleToken();
+        _escrow = new RefundEscrow(wallet);
+        _rate = rate;
+        _cap = cap;
+        _goal = goal;
+        _closingTime = closingTime;
+    }
+
+    function weiRaised() public view returns (uint256) {
+        return _weiRaised;
+    }
+
+    function hasClosed() public view returns (bool) {
+        return now > _closingTime;
+    }
+
+    function goalReached() public view returns (bool) {
+        return _weiRaised >= _goal;
+    }
+
+    function buyTokens(address beneficiary) public payable {
+        uint256 weiAmount = msg.value;
+        require(beneficiary != address(0), "Crowdsale: beneficiary is the zero address");
+        require(weiAmount != 0, "Crowdsale: weiAmount is 0");
+        require(!hasClosed(), "TimedCrowdsale: not open");
+        require(_weiRaised + weiAmount <= _cap, "CappedCrowdsale: cap exceeded");
+
+        _weiRaised = _weiRaised + weiAmount;
+        _token.mint(beneficiary, weiAmount * _rate);
+        _escrow.deposit.value(weiAmount)(msg.sender);
+    }
+
+    function finalize() public {
+        require(!_finalized, "FinalizableCrowdsale: already finalized");
+        require(hasClosed(), "FinalizableCrowdsale: not closed");
+        _finalized = true;
+        if (goalReached()) {
+            _escrow.close();
+            _escrow.beneficiaryWithdraw();
+        } else {
+            _escrow.enableRefunds();
+        }
+    }
+
+    function claimRefund(address payable refundee) public {
+        require(_finalized, "RefundableCrowdsale: not finalized");
+        require(!goalReached(), "RefundableCrowdsale: goal reached");
+        _escrow.withdraw(refundee);
+    }
+}
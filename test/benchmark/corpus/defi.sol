@@ -0,0 +1,279 @@
+/*
+ * Benchmark: an ether staking pool, which pays rewards in its own token. The
+ * pool is built from OpenZeppelin components (Context, Ownable, Pausable,
+ * ReentrancyGuard, SafeMath and ERC20), so that the model exercises deep
+ * inheritance, modifier chains and library calls.
+ */
+
+pragma solidity ^0.5.0;
+
+library SafeMath {
+    function add(uint256 a, uint256 b) internal pure returns (uint256) {
+        uint256 c = a + b;
+        require(c >= a, "SafeMath: addition overflow");
+        return c;
+    }
+
+    function sub(uint256 a, uint256 b) internal pure returns (uint256) {
+        require(b <= a, "SafeMath: subtraction overflow");
+        uint256 c = a - b;
+        return c;
+    }
+
+    function mul(uint256 a, uint256 b) internal pure returns (uint256) {
+        if (a == 0) {
+            return 0;
+        }
+        uint256 c = a * b;
+        require(c / a == b, "SafeMath: multiplication overflow");
+        return c;
+    }
+
+    function div(uint256 a, uint256 b) internal pure returns (uint256) {
+        require(b > 0, "SafeMath: division by zero");
+        uint256 c = a / b;
+        return c;
+    }
+}
+
+contract Context {
+    function _msgSender() internal view returns (address payable) {
+        return msg.sender;
+    }
+}
+
+contract Ownable is Context {
+    address private _owner;
+
+    event OwnershipTransferred(address indexed previousOwner, address indexed newOwner);
+
+    constructor() internal {
+        _owner = _msgSender();
+        emit OwnershipTransferred(address(0), _owner);
+    }
+
+    modifier onlyOwner() {
+        require(_msgSender() == _owner, "Ownable: caller is not the owner");
+        _;
+    }
+
+    function owner() public view returns (address) {
+        return _owner;
+    }
+
+    function transferOwnership(address newOwner) public onlyOwner {
+        require(newOwner != address(0), "Ownable: new owner is the zero address");
+        emit OwnershipTransferred(_owner, newOwner);
+        _owner = newOwner;
+    }
+}
+
+contract Pausable is Ownable {
+    bool private _paused;
+
+    event Paused(address account);
+    event Unpaused(address account);
+
+    modifier whenNotPaused() {
+        require(!_paused, "Pausable: paused");
+        _;
+    }
+
+    modifier whenPaused() {
+        require(_paused, "Pausable: not paused");
+        _;
+    }
+
+    function paused() public view returns (bool) {
+        return _paused;
+    }
+
+    function pause() public onlyOwner whenNotPaused {
+        _paused = true;
+        emit Paused(_msgSender());
+    }
+
+    function unpause() public onlyOwner whenPaused {
+        _paused = false;
+        emit Unpaused(_msgSender());
+    }
+}
+
+contract ReentrancyGuard {
+    uint256 private _guardCounter;
+
+    constructor () internal {
+        _guardCounter = 1;
+    }
+
+    modifier nonReentrant() {
+        _guardCounter += 1;
+        uint256 localCounter = _guardCounter;
+        _;
+        require(localCounter == _guardCounter, "ReentrancyGuard: reentrant call");
+    }
+}
+
+contract ERC20 is Context {
+    using SafeMath for uint256;
+
+    uint256 private _totalSupply;
+    mapping(address => uint256) private _balances;
+    mapping(address => mapping(address => uint256)) private _allowances;
+
+    event Transfer(address indexed from, address indexed to, uint256 value);
+    event Approval(address indexed owner, address indexed spender, uint256 value);
+
+    function totalSupply() public view returns (uint256) {
+        return _totalSupply;
+    }
+
+    function balanceOf(address account) public view returns (uint256) {
+        return _balances[account];
+    }
+
+    function transfer(address recipient, uint256 amount) public returns (bool) {
+        _transfer(_msgSender(), recipient, amount);
+        return true;
+    }
+
+    function approve(address spender, uint256 amount) public returns (bool) {
+        _approve(_msgSender(), spender, amount);
+        return true;
+    }
+
+    function transferFrom(address sender, address recipient, uint256 amount) public returns (bool) {
+        _transfer(sender, recipient, amount);
+        _approve(sender, _msgSender(), _allowances[sender][_msgSender()].sub(amount));
+        return true;
+    }
+
+    function _transfer(address sender, address recipient, uint256 amount) internal {
+        require(sender != address(0), "ERC20: transfer from the zero address");
+        require(recipient != address(0), "ERC20: transfer to the zero address");
+        _balances[sender] = _balances[sender].sub(amount);
+        _balances[recipient] = _balances[recipient].add(amount);
+        emit Transfer(sender, recipient, amount);
+    }
+
+    function _mint(address account, uint256 amount) internal {
+        require(account != address(0), "ERC20: mint to the zero address");
+        _totalSupply = _totalSupply.add(amount);
+        _balances[account] = _balances[account].add(amount);
+        emit Transfer(address(0), account, amount);
+    }
+
+    function _approve(address owner, address spender, uint256 amount) internal {
+        require(owner != address(0), "ERC20: approve from the zero address");
+        require(spender != address(0), "ERC20: approve to the zero address");
+        _allowances[owner][spender] = amount;
+        emit Approval(owner, spender, amount);
+    }
+}
+
+contract RewardToken is ERC20, Ownable {
+    function mint(address account, uint256 amount) public onlyOwner returns (bool) {
+        _mint(account, amount);
+        return true;
+    }
+}
+
+contract StakingPool is Pausable, ReentrancyGuard {
+    using SafeMath for uint256;
+
+    uint256 constant PRECISION = 1000000000;
+
+    RewardToken private _rewardsToken;
+
+    uint256 private _rewardRate;
+    uint256 private _lastUpdateTime;
+    uint256 private _rewardPerTokenStored;
+    uint256 private _totalStaked;
+
+    mapping(address => uint256) private _stakes;
+    mapping(address => uint256) private _userRewardPerTokenPaid;
+    mapping(address => uint256) private _rewards;
+
+    event Staked(address indexed user, uint256 amount);
+    event Withdrawn(address indexed user, uint256 amount);
+    event RewardPaid(address indexed user, uint256 reward);
+
+    constructor(uint256 rewardRate) public {
+        _rewardsToken = new RewardToken();
+        _rewardRate = rewardRate;
+        _lastUpdateTime = now;
+    }
+
+    modifier updateReward(address account) {
+        _rewardPerTokenStored = rewardPerToken();
+        _lastUpdateTime = now;
+        _rewards[account] = earned(account);
+        _userRewardPerTokenPaid[account] = _rewardPerTokenStored;
+        _;
+    }
+
+    function totalStaked() public view returns (uint256) {
+        return _totalStaked;
+    }
+
+    function stakeOf(address account) public view returns (uint256) {
+        return _stakes[account];
+    }
+
+    function rewardPerToken() public view returns (uint256) {
+        if (_totalStaked == 0) {
+            return _rewardPerTokenStored;
+        }
+        uint256 elapsed = now.sub(_lastUpdateTime);
+        return _rewardPerTokenStored.add(
+            elapsed.mul(_rewardRate).mul(PRECISION).div(_totalStaked)
+        );
+    }
+
+    function earned(address account) public view returns (uint256) {
+        uint256 owed = rewardPerToken().sub(_userRewardPerTokenPaid[account]);
+        return _stakes[account].mul(owed).div(PRECISION).add(_rewards[account]);
+    }
+
+    function stake()
+        public
+        payable
+        nonReentrant
+        whenNotPaused
+        updateReward(msg.sender)
+    {
+        require(msg.value > 0, "StakingPool: cannot stake 0");
+        _totalStaked = _totalStaked.add(msg.value);
+        _stakes[_msgSender()] = _stakes[_msgSender()].add(msg.value);
+        emit Staked(_msgSender(), msg.value);
+    }
+
+    function withdraw(uint256 amount)
+        public
+        nonReentrant
+        updateReward(msg.sender)
+    {
+        require(amount > 0, "StakingPool: cannot withdraw 0");
+        _totalStaked = _totalStaked.sub(amount);
+        _stakes[_msgSender()] = _stakes[_msgSender()].sub(amount);
+        _msgSender().transfer(amount);
+        emit Withdrawn(_msgSender(), amount);
+    }
+
+    function getReward() public nonReentrant updateReward(msg.sender) {
+        uint256 reward = _rewards[_msgSender()];
+        if (reward > 0) {
+            _rewards[_msgSender()] = 0;
+            _rewardsToken.mint(_msgSender(), reward);
+            emit RewardPaid(_msgSender(), reward);
+        }
+    }
+
+    function setRewardRate(uint256 rewardRate)
+        public
+        onlyOwner
+        updateReward(address(0))
+    {
+        _rewardRate = rewardRate;
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Benchmark: an ERC721 token, in the style of OpenZeppelin. SmartACE requires
+ * that all maps are keyed by address, so the token supply is fixed, and each
+ * token is kept in its own slot.
+ */
+
+pragma solidity ^0.5.0;
+
+contract NFT {
+    uint8 constant TOKENS = 3;
+
+    address private _minter;
+
+    address private _owner0;
+    address private _owner1;
+    address private _owner2;
+
+    address private _approved0;
+    address private _approved1;
+    address private _approved2;
+
+    mapping(address => uint256) private _ownedTokensCount;
+    mapping(address => mapping(address => bool)) private _operatorApprovals;
+
+    event Transfer(address indexed from, address indexed to, uint8 indexed tokenId);
+    event Approval(address indexed owner, address indexed approved, uint8 indexed tokenId);
+    event ApprovalForAll(address indexed owner, address indexed operator, bool approved);
+
+    constructor() public {
+        _minter = msg.sender;
+    }
+
+    function balanceOf(address owner) public view returns (uint256) {
+        require(owner != address(0), "ERC721: balance query for the zero address");
+        return _ownedTokensCount[owner];
+    }
+
+    function ownerOf(uint8 tokenId) public view returns (address) {
+        address owner = _ownerOf(tokenId);
+        require(owner != address(0), "ERC721: owner query for nonexistent token");
+        return owner;
+    }
+
+    function approve(address to, uint8 tokenId) public {
+        address owner = ownerOf(tokenId);
+        require(to != owner, "ERC721: approval to current owner");
+        require(
+            msg.sender == owner || isApprovedForAll(owner, msg.sender),
+            "ERC721: approve caller is not owner nor approved for all"
+        );
+        _setApproved(tokenId, to);
+        emit Approval(owner, to, tokenId);
+    }
+
+    function getApproved(uint8 tokenId) public view returns (address) {
+        require(_exists(tokenId), "ERC721: approved query for nonexistent token");
+        return _approvedOf(tokenId);
+    }
+
+    function setApprovalForAll(address to, bool approved) public {
+        require(to != msg.sender, "ERC721: approve to caller");
+        _operatorApprovals[msg.sender][to] = approved;
+        emit ApprovalForAll(msg.sender, to, approved);
+    }
+
+    function isApprovedForAll(address owner, address operator) public view returns (bool) {
+        return _operatorApprovals[owner][operator];
+    }
+
+    function transferFrom(address from, address to, uint8 tokenId) public {
+        require(_isApprovedOrOwner(msg.sender, tokenId), "ERC721: transfer caller is not owner nor approved");
+        require(_ownerOf(tokenId) == from, "ERC721: transfer of token that is not own");
+        require(to != address(0), "ERC721: transfer to the zero address");
+
+        _setApproved(tokenId, address(0));
+        _ownedTokensCount[from] = _ownedTokensCount[from] - 1;
+        _ownedTokensCount[to] = _ownedTokensCount[to] + 1;
+        _setOwner(tokenId, to);
+
+        emit Transfer(from, to, tokenId);
+    }
+
+    function mint(address to, uint8 tokenId) public {
+        require(msg.sender == _minter, "ERC721: caller is not the minter");
+        require(to != address(0), "ERC721: mint to the zero address");
+        require(!_exists(tokenId), "ERC721: token already minted");
+
+        _setOwner(tokenId, to);
+        _ownedTokensCount[to] = _ownedTokensCount[to] + 1;
+
+        emit Transfer(address(0), to, tokenId);
+    }
+
+    function burn(uint8 tokenId) public {
+        require(_isApprovedOrOwner(msg.sender, tokenId), "ERC721: burn caller is not owner nor approved");
+        address owner = _ownerOf(tokenId);
+
+        _setApproved(tokenId, address(0));
+        _ownedTokensCount[owner] = _ownedTokensCount[owner] - 1;
+        _setOwner(tokenId, address(0));
+
+        emit Transfer(owner, address(0), tokenId);
+    }
+
+    function _exists(uint8 tokenId) internal view returns (bool) {
+        return _ownerOf(tokenId) != address(0);
+    }
+
+    function _isApprovedOrOwner(address spender, uint8 tokenId) internal view returns (bool) {
+        address owner = ownerOf(tokenId);
+        return (spender == owner || _approvedOf(tokenId) == spender || isApprovedForAll(owner, spender));
+    }
+
+    function _ownerOf(uint8 tokenId) internal view returns (address) {
+        require(tokenId < TOKENS, "ERC721: token out of range");
+        if (tokenId == 0) return _owner0;
+        else if (tokenId == 1) return _owner1;
+        return _owner2;
+    }
+
+    function _setOwner(uint8 tokenId, address owner) internal {
+        require(tokenId < TOKENS, "ERC721: token out of range");
+        if (tokenId == 0) _owner0 = owner;
+        else if (tokenId == 1) _owner1 = owner;
+        else _owner2 = owner;
+    }
+
+    function _approvedOf(uint8 tokenId) internal view returns (address) {
+        require(tokenId < TOKENS, "ERC721: token out of range");
+        if (tokenId == 0) return _approved0;
+        else if (tokenId == 1) return _approved1;
+        return _approved2;
+    }
+
+    function _setApproved(uint8 tokenId, address approved) internal {
+        require(tokenId < TOKENS, "ERC721: token out of range");
+        if (tokenId == 0) _approved0 = approved;
+        else if (tokenId == 1) _approved1 = approved;
+        else _approved2 = approved;
+    }
+}
@@ -0,0 +1,507 @@
+#!/usr/bin/env python3
+
+from argparse import ArgumentParser
+import datetime
+import json
+import os
+import platform
+import random
+import re
+import select
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+DESCRIPTION = """Measures the SmartACE pipeline over a corpus of bundles.
+
+For each bundle, this reports model generation time and memory, the size of
+the generated C files, model compile time for each integer model, fuzzer
+throughput over a fixed wall-clock window, and interactive replay time. The
+results are written as JSON, and may be compared against a prior run."""
+
+# The integer models which are compiled for each bundle.
+INT_MODELS = ["USE_STDINT", "USE_BOOST_MP"]
+
+# The generated files which are measured for each bundle.
+C_FILES = ["cmodel.c", "cmodel.h", "primitive.h", "harness.c"]
+
+# Files which are installed alongside each model by the solc install rules.
+PROJECT_FILES = [
+    ("cmodelres/CMakeLists.txt", "CMakeLists.txt"),
+    ("cmake/SmartAceOptions.cmake", "cmake/SmartAceOptions.cmake"),
+    ("libverify", "libverify"),
+    ("cmodelres/yaml", "yaml"),
+]
+
+# Interactive prompts are of the form "<msg> [<type>]: ".
+PROMPT_END = "]: "
+SELECT_MSG = "Select 0 to terminate"
+RANGE_TYPE = re.compile(r"\w+ from (?P<lo>\d+) to (?P<hi>\d+)$")
+BOUND_TYPE = re.compile(r"\w+ (?P<rel>larger|no less) than (?P<val>\d+)$")
+
+# A failed requirement ends an interactive episode. This bounds the number of
+# episodes recorded, per transaction of the replay budget.
+EPISODES_PER_TXN = 10
+
+# Fuzzer statistics, as printed by -print_final_stats=1.
+FUZZ_STAT = re.compile(r"stat::(?P<key>\w+):\s+(?P<val>\d+)")
+
+
+class BenchmarkError(Exception):
+    """Raised when a stage of the pipeline fails for a bundle."""
+
+
+def tail(text, lines=20):
+    """Returns the last few lines of text, for error reporting."""
+    if isinstance(text, bytes):
+        text = text.decode("utf-8", "replace")
+    return "\n".join(text.splitlines()[-lines:])
+
+
+def run(cmd, cwd=None, env=None):
+    """Runs cmd to completion, and returns (wall time, output).
+
+    Raises BenchmarkError if cmd fails."""
+    start = time.perf_counter()
+    proc = subprocess.run(
+        cmd, cwd=cwd, env=env, stdin=subprocess.DEVNULL,
+        stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    elapsed = time.perf_counter() - start
+    if proc.returncode != 0:
+        raise BenchmarkError("{} exited with {}:\n{}".format(
+            shlex.join(cmd), proc.returncode, tail(proc.stdout)))
+    return elapsed, proc.stdout
+
+
+def measure(cmd):
+    """Runs cmd to completion, and returns (wall time, max rss in KB, output).
+
+    The child is reaped with wait4, so that its peak memory is exact."""
+    with tempfile.TemporaryFile() as out:
+        start = time.perf_counter()
+        proc = subprocess.Popen(
+            cmd, stdin=subprocess.DEVNULL, stdout=out, stderr=out)
+        (_, status, usage) = os.wait4(proc.pid, 0)
+        elapsed = time.perf_counter() - start
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        out.seek(0)
+        text = out.read()
+    # Linux reports kilobytes, whereas macOS reports bytes.
+    rss = usage.ru_maxrss
+    if sys.platform == "darwin":
+        rss //= 1024
+    return elapsed, rss, text
+
+
+class Bundle(object):
+    """The benchmark results for a single entry of the corpus."""
+
+    def __init__(self, bench, entry):
+        self._bench = bench
+        self._args = bench.args
+        self.name = entry["name"]
+        self.source = os.path.join(bench.corpus_dir, entry["source"])
+        self.bundle = entry["bundle"]
+        self.solc_args = entry.get("args", [])
+        self.root = os.path.join(self._args.work_dir, self.name)
+        self.model = os.path.join(self.root, "model")
+        self.results = {
+            "source": entry["source"],
+            "bundle": self.bundle,
+            "errors": [],
+        }
+
+    def stage(self, key, fn):
+        """Runs a stage, recording either its result or its failure."""
+        self._bench.log("  {}...".format(key))
+        try:
+            self.results[key] = fn()
+        except BenchmarkError as e:
+            self.results[key] = None
+            self.results["errors"].append("{}: {}".format(key, e))
+            self._bench.log("  {} failed:\n{}".format(key, e))
+            return False
+        return True
+
+    def run(self):
+        shutil.rmtree(self.root, ignore_errors=True)
+        os.makedirs(self.root)
+        if not self.stage("generate", self.generate):
+            return self.results
+        self.stage("c_bytes", self.c_bytes)
+        self.layout()
+        self.stage("compile_seconds", self.compile)
+        self.stage("fuzz", self.fuzz)
+        self.stage("replay", self.replay)
+        return self.results
+
+    def generate(self):
+        """Generates the model, and reports its best time and peak memory."""
+        cmd = [self._args.solc, "--c-model", "--overwrite",
+               "--output-dir", self.model, "--bundle"] + self.bundle
+        cmd += self._bench.solc_args + self.solc_args + ["--", self.source]
+
+        best = None
+        for _ in range(self._args.repeat):
+            # solc fails if the runtime is not installed, so success is
+            # judged by the model itself.
+            (elapsed, rss, out) = measure(cmd)
+            if not os.path.isfile(os.path.join(self.model, "cmodel.c")):
+                raise BenchmarkError("{} produced no model:\n{}".format(
+                    shlex.join(cmd), tail(out)))
+            if best is None or elapsed < best["seconds"]:
+                best = {"seconds": elapsed, "max_rss_kb": rss}
+        return best
+
+    def c_bytes(self):
+        sizes = {}
+        for f in C_FILES:
+            path = os.path.join(self.model, f)
+            if not os.path.isfile(path):
+                raise BenchmarkError("{} was not generated.".format(f))
+            sizes[f] = os.path.getsize(path)
+        sizes["total"] = sum(sizes.values())
+        return sizes
+
+    def layout(self):
+        """Copies the runtime from the source tree, as solc would install."""
+        src = self._args.source_dir
+        for (frm, to) in PROJECT_FILES:
+            frm = os.path.join(src, frm)
+            to = os.path.join(self.model, to)
+            if os.path.isdir(frm):
+                shutil.copytree(frm, to, dirs_exist_ok=True)
+            else:
+                os.makedirs(os.path.dirname(to), exist_ok=True)
+                shutil.copy(frm, to)
+        cmake_dir = os.path.join(self.model, "cmake")
+        for f in os.listdir(os.path.join(src, "cmodelres")):
+            if f.endswith(".cmake"):
+                shutil.copy(os.path.join(src, "cmodelres", f), cmake_dir)
+
+    def configure(self, build, int_model, env=None):
+        os.makedirs(build, exist_ok=True)
+        cmd = [self._args.cmake, self.model, "-DINT_MODEL=" + int_model]
+        run(cmd, cwd=build, env=env)
+
+    def build(self, build, target):
+        cmd = [self._args.cmake, "--build", build, "--target", target,
+               "--parallel", str(self._args.jobs)]
+        return run(cmd)[0]
+
+    def compile(self):
+        """Times the compilation of icmodel for each integer model.
+
+        The runtime library is built first, so only the model is timed."""
+        results = {}
+        for int_model in INT_MODELS:
+            build = os.path.join(self.root, "build-" + int_model.lower())
+            self.configure(build, int_model)
+            self.build(build, "verify_interactive")
+            results[int_model] = self.build(build, "icmodel")
+        return results
+
+    def fuzz(self):
+        """Reports the throughput of libFuzzer over a fixed window.
+
+        This requires clang. If clang is not found, then null is reported."""
+        if self._args.fuzz_time <= 0:
+            return None
+        cc = shutil.which("clang")
+        cxx = shutil.which("clang++")
+        if cc is None or cxx is None:
+            self._bench.log("  clang was not found, skipping fuzz.")
+            return None
+
+        env = dict(os.environ, CC=cc, CXX=cxx)
+        build = os.path.join(self.root, "build-fuzz")
+        self.configure(build, "USE_STDINT", env)
+        target = self._args.fuzz_target
+        self.build(build, target)
+        self.build(build, "fuzzseed")
+
+        corpus = os.path.join(build, "bench_corpus")
+        shutil.rmtree(corpus, ignore_errors=True)
+        os.makedirs(corpus)
+        run([os.path.join(build, "fuzzseed"), corpus])
+
+        cmd = [os.path.join(build, target), corpus,
+               "-max_total_time={}".format(self._args.fuzz_time),
+               "-seed={}".format(self._args.seed),
+               "-use_value_profile=1", "-print_final_stats=1",
+               "-artifact_prefix={}/".format(build)]
+        fuzz_dict = os.path.join(self.model, "fuzz.dict")
+        if os.path.isfile(fuzz_dict):
+            cmd.append("-dict=" + fuzz_dict)
+
+        # A finding ends the window early, so the rate uses the true window.
+        start = time.perf_counter()
+        proc = subprocess.run(
+            cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        elapsed = time.perf_counter() - start
+        out = proc.stdout.decode("utf-8", "replace")
+        stats = {m.group("key"): int(m.group("val"))
+                 for m in FUZZ_STAT.finditer(out)}
+        if "number_of_executed_units" not in stats:
+            raise BenchmarkError("{} reported no stats:\n{}".format(
+                target, tail(out)))
+        execs = stats["number_of_executed_units"]
+        return {
+            "target": target,
+            "seconds": elapsed,
+            "executions": execs,
+            "execs_per_second": execs / elapsed,
+            "stopped_early": proc.returncode != 0,
+        }
+
+    def replay(self):
+        """Records a random interactive trace, and then times its replay.
+
+        The trace is recorded once, from a fixed seed, so that each replay
+        consumes the same inputs. Episodes end when a transaction fails, so
+        further episodes are recorded until the transaction budget is met."""
+        if self._args.replay_transactions <= 0:
+            return None
+        exe = os.path.join(self.root, "build-use_stdint", "icmodel")
+        if not os.path.isfile(exe):
+            raise BenchmarkError("icmodel was not built.")
+
+        rng = random.Random(self._args.seed)
+        budget = self._args.replay_transactions
+        traces = []
+        count = 0
+        while count < budget and len(traces) < budget * EPISODES_PER_TXN:
+            (trace, txns) = self.record(exe, rng, budget - count)
+            traces.append(trace)
+            count += txns
+
+        best = None
+        for _ in range(self._args.repeat):
+            elapsed = 0
+            for trace in traces:
+                data = (" ".join(str(v) for v in trace) + "\n").encode()
+                start = time.perf_counter()
+                subprocess.run(
+                    [exe], input=data, stdout=subprocess.DEVNULL,
+                    stderr=subprocess.DEVNULL, check=False)
+                elapsed += time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+        return {
+            "episodes": len(traces),
+            "transactions": count,
+            "inputs": sum(len(t) for t in traces),
+            "seconds": best,
+        }
+
+    def record(self, exe, rng, limit):
+        """Drives exe through a single episode of at most limit transactions.
+
+        Returns the inputs, and the number of transactions started."""
+        cmd = [exe]
+        stdbuf = shutil.which("stdbuf")
+        if stdbuf is not None:
+            cmd = [stdbuf, "-o0"] + cmd
+        proc = subprocess.Popen(
+            cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+            stderr=subprocess.DEVNULL)
+
+        trace = []
+        txns = 0
+        buf = ""
+        fd = proc.stdout.fileno()
+        try:
+            while True:
+                (ready, _, _) = select.select([fd], [], [], 10)
+                if not ready:
+                    raise BenchmarkError("icmodel stopped responding.")
+                chunk = os.read(fd, 65536)
+                if not chunk:
+                    break
+                buf += chunk.decode("utf-8", "replace")
+                if not buf.endswith(PROMPT_END):
+                    continue
+
+                # Only the most recent prompt is answered.
+                line = buf[buf.rfind("\n") + 1:]
+                buf = ""
+                open_idx = line.rfind(" [")
+                msg = line[:open_idx].split(PROMPT_END)[-1].strip()
+                ty = line[open_idx + 2:-len(PROMPT_END)]
+
+                if msg == SELECT_MSG:
+                    val = 1 if txns < limit else 0
+                    txns += val
+                else:
+                    val = self.choose(rng, ty)
+                trace.append(val)
+                proc.stdin.write("{}\n".format(val).encode())
+                proc.stdin.flush()
+                if msg == SELECT_MSG and val == 0:
+                    break
+        finally:
+            try:
+                proc.stdin.close()
+            except BrokenPipeError:
+                pass
+            proc.stdout.close()
+            proc.wait()
+        return (trace, txns)
+
+    @staticmethod
+    def choose(rng, ty):
+        """Selects an input for a prompt of the given type.
+
+        Small values are favoured, so that most requirements are met."""
+        match = RANGE_TYPE.match(ty)
+        if match:
+            return rng.randint(int(match.group("lo")), int(match.group("hi")))
+        match = BOUND_TYPE.match(ty)
+        if match:
+            base = int(match.group("val"))
+            if match.group("rel") == "larger":
+                base += 1
+            return base + rng.randint(0, 2)
+        return rng.randint(0, 3)
+
+
+class benchmark():
+    def __init__(self, description, args):
+        self._description = description
+        self.args = self.parseCmdLine(description, args)
+        self.corpus_dir = os.path.dirname(os.path.abspath(self.args.corpus))
+        self.solc_args = shlex.split(self.args.solc_args)
+
+    def parseCmdLine(self, description, args):
+        here = os.path.dirname(os.path.abspath(__file__))
+        root = os.path.dirname(os.path.dirname(here))
+
+        parser = ArgumentParser(description)
+        parser.add_argument(
+            "--solc", required=True, help="Path to the solc executable.")
+        parser.add_argument(
+            "--source-dir", default=root,
+            help="Root of this repository, from which the runtime is copied.")
+        parser.add_argument(
+            "--corpus", default=os.path.join(here, "corpus.json"),
+            help="Manifest of bundles to benchmark.")
+        parser.add_argument(
+            "--work-dir", default=os.path.abspath("modelcheck-bench"),
+            help="Directory in which models are generated and built.")
+        parser.add_argument(
+            "--output", default="modelcheck-bench.json",
+            help="File to which the JSON results are written.")
+        parser.add_argument(
+            "--baseline", default="",
+            help="Results of a prior run, to compare against.")
+        parser.add_argument(
+            "--only", action="append", default=[],
+            help="Restricts the run to the named bundle (repeatable).")
+        parser.add_argument(
+            "--solc-args", default="",
+            help="Additional arguments passed to solc for every bundle.")
+        parser.add_argument(
+            "--fuzz-time", type=int, default=10,
+            help="Wall-clock window for fuzzing, in seconds (0 disables).")
+        parser.add_argument(
+            "--fuzz-target", default="fuzztest-fast",
+            help="The fuzzer target to measure.")
+        parser.add_argument(
+            "--replay-transactions", type=int, default=200,
+            help="Number of transactions in each replay (0 disables).")
+        parser.add_argument(
+            "--repeat", type=int, default=3,
+            help="Number of timed runs, of which the fastest is reported.")
+        parser.add_argument(
+            "--seed", type=int, default=1,
+            help="Seed for the fuzzer and the replay trace.")
+        parser.add_argument(
+            "--jobs", type=int, default=os.cpu_count() or 1,
+            help="Number of parallel jobs used to build each model.")
+        parser.add_argument(
+            "--cmake", default=shutil.which("cmake") or "cmake",
+            help="Path to the cmake executable.")
+        parsed = parser.parse_args(args)
+        parsed.solc = os.path.abspath(parsed.solc)
+        parsed.work_dir = os.path.abspath(parsed.work_dir)
+        return parsed
+
+    def log(self, msg):
+        print(msg, flush=True)
+
+    def run(self):
+        with open(self.args.corpus) as f:
+            corpus = json.load(f)
+        if self.args.only:
+            corpus = [e for e in corpus if e["name"] in self.args.only]
+
+        results = {
+            "timestamp": datetime.datetime.now().isoformat(),
+            "solc": self.args.solc,
+            "solc_args": self.solc_args,
+            "host": {
+                "platform": platform.platform(),
+                "cpus": os.cpu_count(),
+            },
+            "settings": {
+                "fuzz_time": self.args.fuzz_time,
+                "fuzz_target": self.args.fuzz_target,
+                "replay_transactions": self.args.replay_transactions,
+                "repeat": self.args.repeat,
+                "seed": self.args.seed,
+            },
+            "bundles": {},
+        }
+
+        os.makedirs(self.args.work_dir, exist_ok=True)
+        for entry in corpus:
+            self.log("Benchmarking {}".format(entry["name"]))
+            bundle = Bundle(self, entry)
+            results["bundles"][bundle.name] = bundle.run()
+
+        with open(self.args.output, "w") as f:
+            json.dump(results, f, indent=4, sort_keys=True)
+        self.log("Results written to {}".format(self.args.output))
+
+        if self.args.baseline:
+            self.compare(results)
+
+        failed = [k for (k, v) in results["bundles"].items() if v["errors"]]
+        if failed:
+            self.log("Failed bundles: {}".format(", ".join(failed)))
+            return 1
+        return 0
+
+    def compare(self, results):
+        """Prints each metric beside its baseline, as new / old."""
+        with open(self.args.baseline) as f:
+            baseline = json.load(f)
+        old = flatten(baseline.get("bundles", {}))
+        new = flatten(results["bundles"])
+        self.log("")
+        self.log("{:<44} {:>14} {:>14} {:>8}".format(
+            "metric", "baseline", "current", "ratio"))
+        for key in sorted(new):
+            if key not in old:
+                continue
+            ratio = new[key] / old[key] if old[key] else float("nan")
+            self.log("{:<44} {:>14.4g} {:>14.4g} {:>8.3f}".format(
+                key, old[key], new[key], ratio))
+
+
+def flatten(obj, prefix=""):
+    """Maps each numeric leaf of obj to its dotted path."""
+    flat = {}
+    if isinstance(obj, dict):
+        for (k, v) in obj.items():
+            flat.update(flatten(v, prefix + k + "."))
+    elif isinstance(obj, (int, float)) and not isinstance(obj, bool):
+        flat[prefix[:-1]] = obj
+    return flat
+
+
+if __name__ == "__main__":
+    tool = benchmark(DESCRIPTION, sys.argv[1:])
+    sys.exit(tool.run())
@@ -68,6 +68,282 @@ BOOST_AUTO_TEST_CASE(library)
     BOOST_CHECK_EQUAL(summary.view().front()->functions().size(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(safemath)
+{
+    char const* text = R"(
+        library SafeMath {
+            function add(uint a, uint b) internal pure returns (uint) {
+                uint c = a + b;
+                require(c >= a);
+                return c;
+            }
+            function sub(uint a, uint b) internal pure returns (uint) {
+                return sub(a, b, "underflow");
+            }
+            function sub(uint a, uint b, string memory m)
+                internal pure returns (uint)
+            {
+                require(b <= a, m);
+                return a - b;
+            }
+            function mul(uint a, uint b) internal pure returns (uint) {
+                require(a < 10);
+                return b * a;
+            }
+            function div(int a, int b) internal pure returns (int) {
+                require(b != 0);
+                return a / b;
+            }
+            function mod(uint a, uint b) internal pure returns (uint) {
+                return a % b;
+            }
+        }
+        contract A {
+            using SafeMath for uint;
+            using SafeMath for int;
+            function f(uint x, int y) public pure {
+                x.add(x).sub(x).mul(x).mod(x);
+                y.div(y);
+            }
+        }
+    )";
+
+    const auto& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto lib = retrieveContractByName(unit, "SafeMath");
+
+    auto store = make_shared<StructureStore>();
+    vector<ContractDefinition const*> model({ ctrt });
+    auto alloc_graph = make_shared<AllocationGraph>(model);
+    auto flat_model = make_shared<FlatModel>(model, *alloc_graph, store);
+    auto r = make_shared<ContractExpressionAnalyzer>(flat_model, alloc_graph);
+    auto call_graph = make_shared<CallGraph>(r, flat_model);
+    LibrarySummary summary(*call_graph, store);
+
+    auto const& FUNCS = lib->definedFunctions();
+    BOOST_REQUIRE_EQUAL(FUNCS.size(), 6);
+    BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[0]), "add");
+    BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[1]), "sub");
+    BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[2]), "sub");
+    BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[3]), "");
+    BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[4]), "");
+    BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[5]), "");
+    BOOST_CHECK_EQUAL(summary.checked_op(*ctrt->definedFunctions()[0]), "");
+}
+
+BOOST_AUTO_TEST_CASE(safemath_openzeppelin)
+{
+    char const* text = R"(
+        library SafeMath {
+            function add(uint256 a, uint256 b) internal pure returns (uint256) {
+                uint256 c = a + b;
+                require(c >= a, "SafeMath: addition overflow");
+                return c;
+            }
+            function sub(uint256 a, uint256 b) internal pure returns (uint256) {
+                return sub(a, b, "SafeMath: subtraction overflow");
+            }
+            function sub(uint256 a, uint256 b, string memory errorMessage)
+                internal pure returns (uint256)
+            {
+                require(b <= a, errorMessage);
+                uint256 c = a - b;
+                return c;
+            }
+            function mul(uint256 a, uint256 b) internal pure returns (uint256) {
+                if (a == 0) {
+                    return 0;
+                }
+                uint256 c = a * b;
+                require(c / a == b, "SafeMath: multiplication overflow");
+                return c;
+            }
+            function div(uint256 a, uint256 b) internal pure returns (uint256) {
+                return div(a, b, "SafeMath: division by zero");
+            }
+            function div(uint256 a, uint256 b, string memory errorMessage)
+                internal pure returns (uint256)
+            {
+                require(b > 0, errorMessage);
+                uint256 c = a / b;
+                return c;
+            }
+            function mod(uint256 a, uint256 b) internal pure returns (uint256) {
+                return mod(a, b, "SafeMath: modulo by zero");
+            }
+            function mod(uint256 a, uint256 b, string memory errorMessage)
+                internal pure returns (uint256)
+            {
+                require(b != 0, errorMessage);
+                return a % b;
+            }
+        }
+        contract A {
+            using SafeMath for uint;
+            function f(uint x) public pure {
+                x.add(x).sub(x).mul(x).div(x).mod(x);
+            }
+        }
+    )";
+
+    const auto& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto lib = retrieveContractByName(unit, "SafeMath");
+
+    auto store = make_shared<StructureStore>();
+    vector<ContractDefinition const*> model({ ctrt });
+    auto alloc_graph = make_shared<AllocationGraph>(model);
+    auto flat_model = make_shared<FlatModel>(model, *alloc_graph, store);
+    auto r = make_shared<ContractExpressionAnalyzer>(flat_model, alloc_graph);
+    auto call_graph = make_shared<CallGraph>(r, flat_model);
+    LibrarySummary summary(*call_graph, store);
+
+    auto const& FUNCS = lib->definedFunctions();
+    BOOST_REQUIRE_EQUAL(FUNCS.size(), 8);
+    for (auto func : FUNCS)
+    {
+        BOOST_CHECK_EQUAL(summary.checked_op(*func), func->name());
+    }
+}
+
+// Each library deviates from SafeMath in a single way, so no method matches.
+BOOST_AUTO_TEST_CASE(safemath_near_misses)
+{
+    char const* text = R"(
+        library L1 {
+            function add(uint a, uint b) internal pure returns (uint) {
+                require(a > 10, "bogus");
+                return a + b + 1;
+            }
+        }
+        library L2 {
+            function add(uint a, uint b) internal pure returns (uint) {
+                uint c = a + b;
+                require(c >= a);
+                return c + 1;
+            }
+        }
+        library L3 {
+            function add(uint a, uint b) internal pure returns (uint) {
+                uint c = a + b;
+                require(c > a);
+                return c;
+            }
+        }
+        library L4 {
+            function add(uint a, uint b) internal pure returns (uint) {
+                uint c = a + b;
+                assert(c >= a);
+                return c;
+            }
+        }
+        library L5 {
+            function sub(uint a, uint b) internal pure returns (uint) {
+                require(b < a);
+                return a - b;
+            }
+        }
+        library L6 {
+            function sub(uint a, uint b) internal pure returns (uint) {
+                require(b <= a);
+                return b - a;
+            }
+        }
+        library L7 {
+            function mul(uint a, uint b) internal pure returns (uint) {
+                uint c = a * b;
+                require(c / a == b);
+                return c;
+            }
+        }
+        library L8 {
+            function mul(uint a, uint b) internal pure returns (uint) {
+                if (a == 0) return 1;
+                uint c = a * b;
+                require(c / a == b);
+                return c;
+            }
+        }
+        library L9 {
+            function div(uint a, uint b) internal pure returns (uint) {
+                require(a > 0);
+                return a / b;
+            }
+        }
+        library L10 {
+            function mod(uint a, uint b) internal pure returns (uint) {
+                return a % b;
+            }
+        }
+        library L11 {
+            function mod(uint a, uint b) internal pure returns (uint) {
+                require(b != 0);
+                uint d = 5;
+                return a % b;
+            }
+        }
+        library L12 {
+            function sub(uint a, uint b) internal pure returns (uint) {
+                return sub(b, a, "underflow");
+            }
+            function sub(uint a, uint b, string memory m)
+                internal pure returns (uint)
+            {
+                require(b <= a, m);
+                return a - b;
+            }
+        }
+        library L13 {
+            function div(uint a, uint b) internal pure returns (uint) {
+                uint c = a / b;
+                require(b > 0);
+                return c;
+            }
+        }
+        contract A {
+            function f(uint x) public pure {
+                L1.add(x, x);
+                L2.add(x, x);
+                L3.add(x, x);
+                L4.add(x, x);
+                L5.sub(x, x);
+                L6.sub(x, x);
+                L7.mul(x, x);
+                L8.mul(x, x);
+                L9.div(x, x);
+                L10.mod(x, x);
+                L11.mod(x, x);
+                L12.sub(x, x);
+                L13.div(x, x);
+            }
+        }
+    )";
+
+    const auto& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+
+    auto store = make_shared<StructureStore>();
+    vector<ContractDefinition const*> model({ ctrt });
+    auto alloc_graph = make_shared<AllocationGraph>(model);
+    auto flat_model = make_shared<FlatModel>(model, *alloc_graph, store);
+    auto r = make_shared<ContractExpressionAnalyzer>(flat_model, alloc_graph);
+    auto call_graph = make_shared<CallGraph>(r, flat_model);
+    LibrarySummary summary(*call_graph, store);
+
+    for (size_t i = 1; i <= 13; ++i)
+    {
+        auto lib = retrieveContractByName(unit, "L" + to_string(i));
+        BOOST_REQUIRE(lib != nullptr);
+
+        auto const& FUNCS = lib->definedFunctions();
+        BOOST_CHECK_EQUAL(summary.checked_op(*FUNCS[0]), "");
+    }
+
+    // The only match is the checked overload used by L12.
+    auto l12 = retrieveContractByName(unit, "L12");
+    BOOST_CHECK_EQUAL(summary.checked_op(*l12->definedFunctions()[1]), "sub");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //
@@ -0,0 +1,151 @@
+/**
+ * Tests for libsolidity/modelcheck/analysis/LoopBounds.
+ *
+ * @date 2021
+ */
+
+#include <libsolidity/modelcheck/analysis/LoopBounds.h>
+
+#include <boost/test/unit_test.hpp>
+#include <test/libsolidity/AnalysisFramework.h>
+
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+namespace test
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+// Collects all loops, in the order they appear.
+class LoopCollector : public ASTConstVisitor
+{
+public:
+    explicit LoopCollector(ASTNode const& _node) { _node.accept(*this); }
+
+    vector<BreakableStatement const*> loops;
+
+protected:
+    bool visit(WhileStatement const& _node) override
+    {
+        loops.push_back(&_node);
+        return true;
+    }
+
+    bool visit(ForStatement const& _node) override
+    {
+        loops.push_back(&_node);
+        return true;
+    }
+};
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_FIXTURE_TEST_SUITE(
+    Analysis_LoopBoundsTests, ::dev::solidity::test::AnalysisFramework
+)
+
+// Tests the iteration counts of bounded loops, and that early exits from a loop
+// result in upper bounds.
+BOOST_AUTO_TEST_CASE(bounded_loops)
+{
+    char const* text = R"(
+        contract A {
+            uint constant N = 7;
+            uint[6] arr;
+            function f() public view {
+                for (uint i = 0; i < N; ++i) { }
+                for (uint i = 3; i <= 12; i += 3) { }
+                for (int i = -4; 4 > i; i++) { }
+                for (uint i = 1; i != 9; i += 2) { if (i == 5) break; }
+                for (uint i = 9; i < 3; ++i) { }
+                uint j = 0;
+                while (j < 4) {
+                    for (uint k = 0; k < 2; ++k) { continue; }
+                    j++;
+                }
+                for (uint i = 0; i < 8; ++i) { continue; }
+                for (uint i = 0; i < 8; ++i) { return; }
+                for (uint i = 0; i < arr.length; ++i) { }
+            }
+        }
+    )";
+
+    vector<size_t> const ITERATIONS{ 7, 4, 8, 4, 0, 4, 2, 8, 8, 6 };
+    vector<bool> const EXACT{
+        true, true, true, false, true, true, false, false, false, true
+    };
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& body = ctrt.definedFunctions()[0]->body();
+    auto const LOOPS = LoopCollector(body).loops;
+    BOOST_REQUIRE_EQUAL(LOOPS.size(), ITERATIONS.size());
+
+    LoopBounds bounds(body);
+    for (size_t i = 0; i < LOOPS.size(); ++i)
+    {
+        LoopBounds::Bound bound;
+        BOOST_REQUIRE(bounds.find(*LOOPS[i], bound));
+        BOOST_CHECK_EQUAL(bound.iterations, ITERATIONS[i]);
+        BOOST_CHECK_EQUAL(bound.exact, EXACT[i]);
+    }
+}
+
+// Tests that loops are not bounded if their counters are unknown, if their
+// counters are written, or if their counters may overflow.
+BOOST_AUTO_TEST_CASE(unbounded_loops)
+{
+    char const* text = R"(
+        contract A {
+            uint a;
+            function f(uint n) public {
+                for (uint i = 0; i < n; ++i) { }
+                for (uint i = a; i < 5; ++i) { }
+                for (a = 0; a < 5; ++a) { }
+                for (uint i = 0; i < 5; --i) { }
+                for (uint i = 0; i < 5; ++i) { i += 1; }
+                for (uint i = 0; i != 5; i += 2) { }
+                for (uint8 i = 0; i <= 255; ++i) { }
+                uint j = 0;
+                a = 1;
+                while (j < 4) { j++; }
+                j = 0;
+                while (j < 4) { if (a == 1) continue; j++; }
+                do { j++; } while (j < 4);
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& body = ctrt.definedFunctions()[0]->body();
+    auto const LOOPS = LoopCollector(body).loops;
+    BOOST_REQUIRE_EQUAL(LOOPS.size(), 10);
+
+    LoopBounds bounds(body);
+    for (auto const* loop : LOOPS)
+    {
+        LoopBounds::Bound bound;
+        BOOST_CHECK(!bounds.find(*loop, bound));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
+}
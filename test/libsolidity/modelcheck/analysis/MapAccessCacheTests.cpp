@@ -0,0 +1,218 @@
+/**
+ * Tests for libsolidity/modelcheck/analysis/MapAccessCache.
+ *
+ * @date 2021
+ */
+
+#include <libsolidity/modelcheck/analysis/MapAccessCache.h>
+
+#include <boost/test/unit_test.hpp>
+#include <test/libsolidity/AnalysisFramework.h>
+
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+namespace test
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+// Collects all complete map accesses, in the order they appear.
+class MapAccessCollector : public ASTConstVisitor
+{
+public:
+    explicit MapAccessCollector(ASTNode const& _node) { _node.accept(*this); }
+
+    vector<IndexAccess const*> accesses;
+
+protected:
+    bool visit(IndexAccess const& _node) override
+    {
+        auto const* TYPE = _node.annotation().type;
+        if (TYPE->category() != Type::Category::Mapping)
+        {
+            accesses.push_back(&_node);
+        }
+        return true;
+    }
+};
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_FIXTURE_TEST_SUITE(
+    Analysis_MapAccessCacheTests, ::dev::solidity::test::AnalysisFramework
+)
+
+// Tests that repeated reads are served by a single slot, which is loaded before
+// the first statement to access the entry.
+BOOST_AUTO_TEST_CASE(repeated_reads)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) a;
+            function f(address i) public view returns (uint) {
+                uint x = a[i];
+                require(a[i] > 0);
+                return a[msg.sender] + x;
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& body = ctrt.definedFunctions()[0]->body();
+    auto const& stmts = body.statements();
+    auto const ACCESSES = MapAccessCollector(body).accesses;
+    BOOST_REQUIRE_EQUAL(ACCESSES.size(), 3);
+
+    MapAccessCache cache(body);
+    BOOST_REQUIRE_EQUAL(cache.opens(*stmts[0]).size(), 1);
+    BOOST_CHECK(cache.opens(*stmts[1]).empty());
+    BOOST_CHECK(cache.opens(*stmts[2]).empty());
+
+    auto const& slot = cache.opens(*stmts[0])[0];
+    BOOST_CHECK_EQUAL(slot.access, ACCESSES[0]);
+    BOOST_CHECK(slot.load);
+
+    size_t id;
+    BOOST_CHECK(cache.reads_slot(*ACCESSES[0], id));
+    BOOST_CHECK_EQUAL(id, slot.id);
+    BOOST_CHECK(cache.reads_slot(*ACCESSES[1], id));
+    BOOST_CHECK_EQUAL(id, slot.id);
+    BOOST_CHECK(!cache.reads_slot(*ACCESSES[2], id));
+    BOOST_CHECK_EQUAL(MapAccessCache::name(slot.id), "mapvar_0");
+}
+
+// Tests that a write followed by a read is forwarded through a slot.
+BOOST_AUTO_TEST_CASE(write_forwarding)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => mapping(address => uint)) a;
+            function f(address i, address j) public returns (uint) {
+                a[i][j] = 5;
+                a[i][j] += 1;
+                a[i][j] = 2;
+                return a[i][j];
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& body = ctrt.definedFunctions()[0]->body();
+    auto const& stmts = body.statements();
+    auto const ACCESSES = MapAccessCollector(body).accesses;
+    BOOST_REQUIRE_EQUAL(ACCESSES.size(), 4);
+
+    MapAccessCache cache(body);
+    BOOST_REQUIRE_EQUAL(cache.opens(*stmts[0]).size(), 1);
+    BOOST_CHECK(!cache.opens(*stmts[0])[0].load);
+
+    size_t id;
+    BOOST_CHECK(cache.writes_slot(*ACCESSES[0], id));
+    BOOST_CHECK(cache.reads_slot(*ACCESSES[1], id));
+    BOOST_CHECK(cache.writes_slot(*ACCESSES[1], id));
+    BOOST_CHECK(cache.writes_slot(*ACCESSES[2], id));
+    BOOST_CHECK(cache.reads_slot(*ACCESSES[3], id));
+    BOOST_CHECK(!cache.reads_slot(*ACCESSES[0], id));
+}
+
+// Tests that entries are dropped by aliasing writes, by writes to their keys,
+// by calls, and by the end of straight-line code.
+BOOST_AUTO_TEST_CASE(invalidation)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) a;
+            function g() public { }
+            function f(address i, address j) public {
+                uint x = a[i];
+                a[j] = 1;
+                x = a[i];
+                i = j;
+                x = a[i];
+                g();
+                x = a[i];
+                if (x > 0) { x = a[i]; }
+                x = a[i];
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& body = ctrt.definedFunctions()[1]->body();
+    auto const ACCESSES = MapAccessCollector(body).accesses;
+    BOOST_REQUIRE_EQUAL(ACCESSES.size(), 7);
+
+    MapAccessCache cache(body);
+    for (auto const* access : ACCESSES)
+    {
+        size_t id;
+        BOOST_CHECK(!cache.reads_slot(*access, id));
+        BOOST_CHECK(!cache.writes_slot(*access, id));
+    }
+    for (auto const& stmt : body.statements())
+    {
+        BOOST_CHECK(cache.opens(*stmt).empty());
+    }
+}
+
+// Tests that reads which may not be evaluated are never served by a slot, and
+// never open a slot.
+BOOST_AUTO_TEST_CASE(conditional_reads)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) a;
+            function f(address i, address j) public view returns (uint) {
+                uint x = (i == j) ? a[i] : 0;
+                require(a[i] > 0 || a[j] > 0);
+                return a[i] + ((x > 0 && a[j] > 1) ? 1 : 0);
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& body = ctrt.definedFunctions()[0]->body();
+    auto const& stmts = body.statements();
+    auto const ACCESSES = MapAccessCollector(body).accesses;
+    BOOST_REQUIRE_EQUAL(ACCESSES.size(), 5);
+
+    MapAccessCache cache(body);
+    BOOST_CHECK(cache.opens(*stmts[0]).empty());
+    BOOST_REQUIRE_EQUAL(cache.opens(*stmts[1]).size(), 1);
+    BOOST_CHECK(cache.opens(*stmts[2]).empty());
+
+    auto const& slot = cache.opens(*stmts[1])[0];
+    BOOST_CHECK_EQUAL(slot.access, ACCESSES[1]);
+    BOOST_CHECK(slot.load);
+
+    size_t id;
+    BOOST_CHECK(!cache.reads_slot(*ACCESSES[0], id));
+    BOOST_CHECK(cache.reads_slot(*ACCESSES[1], id));
+    BOOST_CHECK(!cache.reads_slot(*ACCESSES[2], id));
+    BOOST_CHECK(cache.reads_slot(*ACCESSES[3], id));
+    BOOST_CHECK(!cache.reads_slot(*ACCESSES[4], id));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
+}
@@ -235,6 +235,40 @@ BOOST_AUTO_TEST_CASE(disallows_map_struct_map_pattern)
     BOOST_CHECK_THROW(lookup.query(*m), runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE(field_names)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => mapping(address => uint)) a;
+        }
+    )";
+
+    const auto& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto mapping = ctrt->stateVariables()[0];
+
+    MapDeflate lookup;
+    auto const& rec = *lookup.query(*(Mapping const*)(mapping->typeName()));
+
+    auto const& fields_2 = rec.fields(2);
+    BOOST_CHECK_EQUAL(fields_2.size(), 4);
+    BOOST_CHECK_EQUAL(fields_2[0], "data_0_0");
+    BOOST_CHECK_EQUAL(fields_2[1], "data_0_1");
+    BOOST_CHECK_EQUAL(fields_2[2], "data_1_0");
+    BOOST_CHECK_EQUAL(fields_2[3], "data_1_1");
+    BOOST_CHECK_EQUAL(&rec.fields(2), &fields_2);
+
+    auto const& fields_3 = rec.fields(3);
+    BOOST_CHECK_EQUAL(fields_3.size(), 9);
+    BOOST_CHECK_EQUAL(fields_3[5], "data_1_2");
+
+    // A table of one width remains valid after requesting another width.
+    BOOST_CHECK_EQUAL(fields_2.size(), 4);
+    BOOST_CHECK_EQUAL(fields_2[3], "data_1_1");
+    BOOST_CHECK_EQUAL(&rec.fields(2), &fields_2);
+    BOOST_CHECK_EQUAL(&rec.fields(3), &fields_3);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //
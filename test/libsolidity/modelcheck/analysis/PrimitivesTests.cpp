@@ -5,6 +5,7 @@
  */
 
 #include <libsolidity/modelcheck/analysis/Primitives.h>
+#include <libsolidity/modelcheck/utils/Primitives.h>
 
 #include <boost/test/unit_test.hpp>
 #include <test/libsolidity/AnalysisFramework.h>
@@ -510,6 +511,28 @@ BOOST_AUTO_TEST_CASE(fixed_formatting)
     }
 }
 
+BOOST_AUTO_TEST_CASE(unwrapped_formatting)
+{
+    char const* text = R"( contract A { uint24 v1; } )";
+    auto const& ast = *parseAndAnalyse(text);
+
+    PrimitiveTypeGenerator gen;
+    gen.record(ast);
+
+    ostringstream actual, expected;
+    PrimitiveToRaw::unwrap(actual, true);
+    gen.print(actual);
+    expected << "typedef sol_raw_uint24_t sol_uint24_t;";
+    expected << "static inline sol_uint24_t Init_sol_uint24_t(sol_raw_uint24_t v)";
+    expected << "{";
+    expected << "sol_uint24_t tmp;";
+    expected << "((tmp))=(v);";
+    expected << "return tmp;";
+    expected << "}";
+    BOOST_CHECK(actual.str().find(expected.str()) != string::npos);
+    BOOST_CHECK(actual.str().find("struct") == string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //
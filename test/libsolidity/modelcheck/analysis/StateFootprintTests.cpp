@@ -0,0 +1,245 @@
+/**
+ * Tests for libsolidity/modelcheck/analysis/StateFootprint.
+ *
+ * @date 2021
+ */
+
+#include <libsolidity/modelcheck/analysis/StateFootprint.h>
+
+#include <boost/test/unit_test.hpp>
+#include <test/libsolidity/AnalysisFramework.h>
+
+#include <libsolidity/modelcheck/analysis/Inheritance.h>
+#include <libsolidity/modelcheck/analysis/Structure.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+namespace test
+{
+
+// -------------------------------------------------------------------------- //
+
+BOOST_FIXTURE_TEST_SUITE(
+    Analysis_StateFootprintTests, ::dev::solidity::test::AnalysisFramework
+)
+
+BOOST_AUTO_TEST_CASE(disjoint_variables)
+{
+    char const* text = R"(
+        contract A {
+            uint x;
+            uint y;
+            function f() public { x = 1; }
+            function g() public { y += 2; }
+            function h() public view returns (uint) { return x; }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& x = *ctrt.stateVariables()[0];
+    auto const& y = *ctrt.stateVariables()[1];
+
+    FlatContract flat(ctrt, make_shared<StructureStore>());
+    StateFootprint f(flat, *ctrt.definedFunctions()[0]);
+    StateFootprint g(flat, *ctrt.definedFunctions()[1]);
+    StateFootprint h(flat, *ctrt.definedFunctions()[2]);
+
+    BOOST_CHECK(f.reads() == StateFootprint::VariableSet({ &x }));
+    BOOST_CHECK(f.writes() == StateFootprint::VariableSet({ &x }));
+    BOOST_CHECK(g.reads() == StateFootprint::VariableSet({ &y }));
+    BOOST_CHECK(g.writes() == StateFootprint::VariableSet({ &y }));
+    BOOST_CHECK(h.reads() == StateFootprint::VariableSet({ &x }));
+    BOOST_CHECK(h.writes().empty());
+
+    BOOST_CHECK(!f.conflicts(g, true));
+    BOOST_CHECK(f.conflicts(h, true));
+    BOOST_CHECK(h.conflicts(f, true));
+    BOOST_CHECK(!g.conflicts(h, true));
+    BOOST_CHECK(!h.conflicts(h, true));
+    BOOST_CHECK(f.conflicts(f, true));
+    BOOST_CHECK(!f.conflicts(f, false));
+}
+
+BOOST_AUTO_TEST_CASE(follows_modifiers_and_calls)
+{
+    char const* text = R"(
+        library L {
+            function set(mapping(uint => uint) storage m) internal { m[0] = 1; }
+        }
+        contract A {
+            uint x;
+            uint y;
+            uint z;
+            mapping(uint => uint) m;
+            modifier check() { require(z > 0); _; }
+            function set() internal { y = x; }
+            function f() public check() { set(); }
+            function g() public { L.set(m); }
+            function h() public view returns (uint) { return m[x]; }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& x = *ctrt.stateVariables()[0];
+    auto const& y = *ctrt.stateVariables()[1];
+    auto const& z = *ctrt.stateVariables()[2];
+    auto const& m = *ctrt.stateVariables()[3];
+
+    FlatContract flat(ctrt, make_shared<StructureStore>());
+    StateFootprint f(flat, *ctrt.definedFunctions()[1]);
+    StateFootprint g(flat, *ctrt.definedFunctions()[2]);
+    StateFootprint h(flat, *ctrt.definedFunctions()[3]);
+
+    BOOST_CHECK(f.reads() == StateFootprint::VariableSet({ &x, &y, &z }));
+    BOOST_CHECK(f.writes() == StateFootprint::VariableSet({ &y }));
+    BOOST_CHECK(g.reads() == StateFootprint::VariableSet({ &m }));
+    BOOST_CHECK(g.writes() == StateFootprint::VariableSet({ &m }));
+    BOOST_CHECK(h.reads() == StateFootprint::VariableSet({ &x, &m }));
+    BOOST_CHECK(h.writes().empty());
+
+    BOOST_CHECK(!f.is_opaque());
+    BOOST_CHECK(!g.is_opaque());
+    BOOST_CHECK(!h.is_opaque());
+    BOOST_CHECK(!f.conflicts(g, true));
+    BOOST_CHECK(g.conflicts(h, true));
+}
+
+BOOST_AUTO_TEST_CASE(storage_pointers_escape)
+{
+    char const* text = R"(
+        contract A {
+            struct S { uint a; }
+            S s;
+            S t;
+            function f() public {
+                S storage p = s;
+                p.a = 1;
+            }
+            function g() public view returns (uint) { return t.a; }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+    auto const& s = *ctrt.stateVariables()[0];
+    auto const& t = *ctrt.stateVariables()[1];
+
+    FlatContract flat(ctrt, make_shared<StructureStore>());
+    StateFootprint f(flat, *ctrt.definedFunctions()[0]);
+    StateFootprint g(flat, *ctrt.definedFunctions()[1]);
+
+    BOOST_CHECK(f.writes() == StateFootprint::VariableSet({ &s }));
+    BOOST_CHECK(g.reads() == StateFootprint::VariableSet({ &t }));
+    BOOST_CHECK(g.writes().empty());
+}
+
+BOOST_AUTO_TEST_CASE(environment)
+{
+    char const* text = R"(
+        contract B {
+            function f() public {}
+        }
+        contract A {
+            B b;
+            function f() public { b.f(); }
+            function g() public { msg.sender.transfer(1); }
+            function h() public payable {}
+            function p() public view returns (uint) { return address(this).balance; }
+            function q() public view returns (uint) { return now; }
+            function r() public view returns (uint) { return block.number; }
+            function s() public view returns (address) { return msg.sender; }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+
+    FlatContract flat(ctrt, make_shared<StructureStore>());
+    StateFootprint f(flat, *ctrt.definedFunctions()[0]);
+    StateFootprint g(flat, *ctrt.definedFunctions()[1]);
+    StateFootprint h(flat, *ctrt.definedFunctions()[2]);
+    StateFootprint p(flat, *ctrt.definedFunctions()[3]);
+    StateFootprint q(flat, *ctrt.definedFunctions()[4]);
+    StateFootprint r(flat, *ctrt.definedFunctions()[5]);
+    StateFootprint s(flat, *ctrt.definedFunctions()[6]);
+
+    BOOST_CHECK(f.is_opaque());
+    BOOST_CHECK(g.is_opaque());
+    BOOST_CHECK(!h.is_opaque());
+    BOOST_CHECK(h.writes_balance());
+    BOOST_CHECK(p.reads_balance());
+    BOOST_CHECK(!p.writes_balance());
+    BOOST_CHECK(q.reads_time());
+    BOOST_CHECK(r.reads_time());
+    BOOST_CHECK(!s.reads_time());
+
+    BOOST_CHECK(f.conflicts(s, false));
+    BOOST_CHECK(s.conflicts(g, false));
+    BOOST_CHECK(h.conflicts(p, false));
+    BOOST_CHECK(h.conflicts(h, false));
+    BOOST_CHECK(!p.conflicts(p, false));
+    BOOST_CHECK(q.conflicts(r, true));
+    BOOST_CHECK(!q.conflicts(s, true));
+    BOOST_CHECK(!h.conflicts(q, true));
+}
+
+BOOST_AUTO_TEST_CASE(preserves_state)
+{
+    char const* text = R"(
+        contract A {
+            uint x;
+            uint[] arr;
+            modifier check() { assert(x > 0); _; }
+            function f() public view returns (uint) { return x; }
+            function g() public view returns (uint) { assert(x > 0); return x; }
+            function h() public check returns (uint) { return x; }
+            function p() public payable {}
+            function q() public returns (uint) { uint[] storage a = arr; return a[0]; }
+            function r() public view returns (uint) { uint[] storage a = arr; return a[0]; }
+            function s() public { require(x > 0); }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(unit, "A");
+
+    FlatContract flat(ctrt, make_shared<StructureStore>());
+    StateFootprint f(flat, *ctrt.definedFunctions()[0]);
+    StateFootprint g(flat, *ctrt.definedFunctions()[1]);
+    StateFootprint h(flat, *ctrt.definedFunctions()[2]);
+    StateFootprint p(flat, *ctrt.definedFunctions()[3]);
+    StateFootprint q(flat, *ctrt.definedFunctions()[4]);
+    StateFootprint r(flat, *ctrt.definedFunctions()[5]);
+    StateFootprint s(flat, *ctrt.definedFunctions()[6]);
+
+    BOOST_CHECK(!f.asserts());
+    BOOST_CHECK(g.asserts());
+    BOOST_CHECK(h.asserts());
+    BOOST_CHECK(!s.asserts());
+
+    BOOST_CHECK(f.preserves_state(true));
+    BOOST_CHECK(f.preserves_state(false));
+    BOOST_CHECK(!g.preserves_state(true));
+    BOOST_CHECK(!h.preserves_state(false));
+    BOOST_CHECK(!p.preserves_state(false));
+    BOOST_CHECK(!q.preserves_state(false));
+    BOOST_CHECK(r.preserves_state(true));
+    BOOST_CHECK(s.preserves_state(false));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
+}
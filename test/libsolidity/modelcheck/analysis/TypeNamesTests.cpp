@@ -408,6 +408,49 @@ BOOST_AUTO_TEST_CASE(name_escape)
     BOOST_CHECK_EQUAL(converter.get_name(mapv), "Map_1");
 }
 
+// Ensures that names and initial values are shared between nodes of the same
+// type.
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+    char const* text = R"(
+        contract A {
+            struct S { int i; }
+            int a;
+            int b;
+            uint c;
+            S s;
+            S t;
+        }
+    )";
+
+    auto const& ast = *parseAndAnalyse(text);
+    auto const& ctrt = *retrieveContractByName(ast, "A");
+    auto const& a = *ctrt.stateVariables()[0];
+    auto const& b = *ctrt.stateVariables()[1];
+    auto const& c = *ctrt.stateVariables()[2];
+    auto const& s = *ctrt.stateVariables()[3];
+    auto const& t = *ctrt.stateVariables()[4];
+
+    auto store = make_shared<StructureStore>();
+    vector<ContractDefinition const*> model({ &ctrt });
+    auto alloc_graph = make_shared<AllocationGraph>(model);
+    auto flat_model = make_shared<FlatModel>(model, *alloc_graph, store);
+    auto r = make_shared<ContractExpressionAnalyzer>(flat_model, alloc_graph);
+    CallGraph call_graph(r, flat_model);
+    TypeAnalyzer converter({ &ast }, call_graph);
+
+    BOOST_CHECK_EQUAL(&converter.get_type(a), &converter.get_type(b));
+    BOOST_CHECK_NE(&converter.get_type(a), &converter.get_type(c));
+    BOOST_CHECK_EQUAL(&converter.get_name(s), &converter.get_name(t));
+
+    BOOST_CHECK_EQUAL(converter.get_init_val(a), converter.get_init_val(b));
+    BOOST_CHECK_NE(converter.get_init_val(a), converter.get_init_val(c));
+    BOOST_CHECK_EQUAL(converter.get_init_val(s), converter.get_init_val(t));
+    BOOST_CHECK_EQUAL(
+        converter.get_init_val(*a.typeName()), converter.get_init_val(a)
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -5,6 +5,8 @@
 
 #include <libsolidity/modelcheck/codegen/Details.h>
 
+#include <libsolidity/modelcheck/utils/Primitives.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <sstream>
@@ -96,6 +98,156 @@ BOOST_AUTO_TEST_CASE(var_decl_types)
     ostringstream set_val_actual;
     set_val_actual << set_val;
     BOOST_CHECK_EQUAL(set_val_actual.str(), "type name=42;");
+
+    BOOST_CHECK_EQUAL(basic1.name(), "name");
+    BOOST_CHECK_EQUAL(ptr.name(), "name");
+}
+
+// Tests array declarations and index accesses.
+BOOST_AUTO_TEST_CASE(array_types)
+{
+    CVarDecl arr1("type", "name", vector<size_t>{3});
+    CVarDecl arr2("type", "name", vector<size_t>{3, 4});
+
+    ostringstream arr1_actual;
+    arr1_actual << arr1;
+    BOOST_CHECK_EQUAL(arr1_actual.str(), "type name[3];");
+
+    ostringstream arr2_actual;
+    arr2_actual << arr2;
+    BOOST_CHECK_EQUAL(arr2_actual.str(), "type name[3][4];");
+
+    auto idx = make_shared<CIdentifier>("i", false);
+    auto access = make_shared<CIndexAccess>(
+        make_shared<CIndexAccess>(arr2.id(), idx), make_shared<CIntLiteral>(2)
+    );
+
+    ostringstream access_actual;
+    access_actual << *access->access("v");
+    BOOST_CHECK_EQUAL(access_actual.str(), "(((name)[i])[2]).v");
+}
+
+// Tests that value accesses are elided when primitives are unwrapped.
+BOOST_AUTO_TEST_CASE(unwrapped_primitives)
+{
+    auto val = make_shared<CIdentifier>("val", false);
+    auto ptr = make_shared<CIdentifier>("ptr", true);
+
+    ostringstream val_actual, ptr_actual, fld_actual;
+    PrimitiveToRaw::unwrap(val_actual, true);
+    PrimitiveToRaw::unwrap(ptr_actual, true);
+    PrimitiveToRaw::unwrap(fld_actual, true);
+    val_actual << *val->access("v");
+    ptr_actual << *ptr->access("v");
+    fld_actual << *ptr->access("user_v")->access("v");
+
+    BOOST_CHECK_EQUAL(val_actual.str(), "(val)");
+    BOOST_CHECK_EQUAL(ptr_actual.str(), "(*(ptr))");
+    BOOST_CHECK_EQUAL(fld_actual.str(), "((ptr)->user_v)");
+
+    // The setting is local to each stream.
+    ostringstream wrapped_actual;
+    wrapped_actual << *val->access("v");
+    BOOST_CHECK_EQUAL(wrapped_actual.str(), "(val).v");
+}
+
+// Tests constant folding and the removal of identities from expressions.
+BOOST_AUTO_TEST_CASE(simplify_expressions)
+{
+    auto x = make_shared<CIdentifier>("x", false);
+    auto c = make_shared<CIdentifier>("c", false);
+    auto lit = [](long long int _v) { return make_shared<CIntLiteral>(_v); };
+
+    auto sum = make_shared<CBinaryOp>(lit(2), "+", lit(3));
+    auto id = make_shared<CBinaryOp>(x, "+", lit(0));
+    auto cmp = make_shared<CBinaryOp>(c, "==", lit(1));
+    auto lazy = make_shared<CBinaryOp>(
+        lit(0), "||", make_shared<CBinaryOp>(lit(1), "&&", cmp)
+    );
+    auto div = make_shared<CBinaryOp>(lit(1), "/", lit(0));
+    auto cond = make_shared<CCond>(lit(0), x, c);
+    auto deref = make_shared<CDereference>(make_shared<CReference>(x));
+    auto cast = make_shared<CCast>(make_shared<CCast>(x, "int"), "int");
+
+    ostringstream sum_actual, id_actual, lazy_actual, div_actual;
+    sum_actual << *simplify(sum);
+    id_actual << *simplify(id);
+    lazy_actual << *simplify(lazy);
+    div_actual << *simplify(div);
+    BOOST_CHECK_EQUAL(sum_actual.str(), "5");
+    BOOST_CHECK_EQUAL(id_actual.str(), "x");
+    BOOST_CHECK_EQUAL(lazy_actual.str(), "(c)==(1)");
+    BOOST_CHECK_EQUAL(div_actual.str(), "(1)/(0)");
+
+    ostringstream cond_actual, deref_actual, cast_actual;
+    cond_actual << *simplify(cond);
+    deref_actual << *simplify(deref);
+    cast_actual << *simplify(cast);
+    BOOST_CHECK_EQUAL(cond_actual.str(), "c");
+    BOOST_CHECK_EQUAL(deref_actual.str(), "x");
+    BOOST_CHECK_EQUAL(cast_actual.str(), "((int)(x))");
+
+    BOOST_CHECK_EQUAL(simplify(x), x);
+}
+
+// Tests that wrapping an unwrapped value is folded, when the types agree.
+BOOST_AUTO_TEST_CASE(simplify_rewrap)
+{
+    auto x = make_shared<CIdentifier>("x", false);
+    auto ptr = make_shared<CIdentifier>("ptr", true);
+    auto wrap = [](string _init, CExprPtr _expr) {
+        return make_shared<CFuncCall>(_init, CArgList{_expr});
+    };
+
+    auto same = wrap("Init_T", make_shared<CMemberAccess>(x, "v", "Init_T"));
+    auto other = wrap("Init_S", make_shared<CMemberAccess>(x, "v", "Init_T"));
+    auto plain = wrap("Init_T", x->access("v"));
+    auto deref = wrap(
+        "Init_T", make_shared<CMemberAccess>(ptr, "v", "Init_T")
+    );
+
+    BOOST_CHECK_EQUAL(simplify(same), x);
+    BOOST_CHECK_EQUAL(simplify(other), other);
+    BOOST_CHECK_EQUAL(simplify(plain), plain);
+    BOOST_CHECK_EQUAL(simplify(deref), deref);
+}
+
+// Tests the removal of dead branches, empty blocks and unreachable code.
+BOOST_AUTO_TEST_CASE(simplify_statements)
+{
+    auto x = make_shared<CIdentifier>("x", false);
+    auto set = make_shared<CAssign>(x, make_shared<CIntLiteral>(1))->stmt();
+    auto ret = make_shared<CReturn>(x);
+    auto decl = make_shared<CVarDecl>("int", "y");
+
+    auto dead_if = make_shared<CIf>(make_shared<CIntLiteral>(0), set);
+    auto live_if = make_shared<CIf>(
+        make_shared<CIntLiteral>(1), set, make_shared<CReturn>(nullptr)
+    );
+    auto scoped = make_shared<CBlock>(CBlockList{decl, set});
+    auto block = make_shared<CBlock>(CBlockList{
+        dead_if,
+        make_shared<CBlock>(CBlockList{live_if}),
+        scoped,
+        ret,
+        set
+    });
+
+    ostringstream block_actual;
+    block_actual << *simplify(block);
+    BOOST_CHECK_EQUAL(
+        block_actual.str(), "{(x)=(1);{int y;(x)=(1);}return x;}"
+    );
+
+    auto id = make_shared<CVarDecl>("int", "f");
+    auto body = make_shared<CBlock>(CBlockList{ret, set});
+
+    ostringstream simple_actual, raw_actual;
+    CFuncDef::simplify_bodies(simple_actual, true);
+    simple_actual << CFuncDef(id, CParams{}, body);
+    raw_actual << CFuncDef(id, CParams{}, body);
+    BOOST_CHECK_EQUAL(simple_actual.str(), "int f(void){return x;}");
+    BOOST_CHECK_EQUAL(raw_actual.str(), "int f(void){return x;(x)=(1);}");
 }
 
 BOOST_AUTO_TEST_SUITE_END();
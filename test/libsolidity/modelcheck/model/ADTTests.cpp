@@ -249,6 +249,82 @@ BOOST_AUTO_TEST_CASE(constants)
     BOOST_CHECK_EQUAL(actual.str(), expect.str());
 }
 
+// Tests that fixed-length arrays are embedded by value, as contiguous C arrays.
+BOOST_AUTO_TEST_CASE(array_internal_repr)
+{
+    char const* text = R"(
+        contract A {
+            uint8[3] a; int b; bool[2] c;
+        }
+    )";
+
+    auto const &unit = *parseAndAnalyse(text);
+    auto ctrt_a = retrieveContractByName(unit, "A");
+
+    vector<ContractDefinition const*> model({ ctrt_a });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream actual, expect;
+    ADTConverter(stack, false, 1, false).print(actual);
+    expect << "struct Array_sol_uint8_t_3{sol_uint8_t data[3];};"
+           << "struct Array_sol_bool_t_2{sol_bool_t data[2];};"
+           << "struct A"
+           << "{"
+           << "sol_address_t model_address;"
+           << "sol_uint256_t model_balance;"
+           << "struct Array_sol_uint8_t_3 user_a;"
+           << "sol_int256_t user_b;"
+           << "struct Array_sol_bool_t_2 user_c;"
+           << "};";
+
+    BOOST_CHECK_EQUAL(actual.str(), expect.str());
+}
+
+// Ensures that arrays of the same element type and length are declared once.
+BOOST_AUTO_TEST_CASE(array_shared_repr)
+{
+    char const* text = R"(
+        contract A {
+            uint[3] a; uint[3] b; uint[2] c;
+        }
+    )";
+
+    auto const &unit = *parseAndAnalyse(text);
+    auto ctrt_a = retrieveContractByName(unit, "A");
+
+    vector<ContractDefinition const*> model({ ctrt_a });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream actual, expect;
+    ADTConverter(stack, false, 1, false).print(actual);
+    expect << "struct Array_sol_uint256_t_3{sol_uint256_t data[3];};"
+           << "struct Array_sol_uint256_t_2{sol_uint256_t data[2];};"
+           << "struct A"
+           << "{"
+           << "sol_address_t model_address;"
+           << "sol_uint256_t model_balance;"
+           << "struct Array_sol_uint256_t_3 user_a;"
+           << "struct Array_sol_uint256_t_3 user_b;"
+           << "struct Array_sol_uint256_t_2 user_c;"
+           << "};";
+
+    BOOST_CHECK_EQUAL(actual.str(), expect.str());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //
@@ -202,6 +202,93 @@ BOOST_AUTO_TEST_CASE(loop_statement)
     BOOST_CHECK_EQUAL(actual_for.str(), expected_for.str());
 }
 
+// Tests that small loops of an exact bound are unrolled, that loops of an upper
+// bound count their iterations, and that loops which may overflow are not
+// bounded.
+BOOST_AUTO_TEST_CASE(loop_bounds)
+{
+    char const* text = R"(
+        contract A {
+            uint a;
+            function f() public {
+                for (uint8 i = 0; i < 2; ++i) { a += i; }
+                uint8 j = 4;
+                while (j <= 6) { a += j; j += 2; }
+                for (uint8 i = 0; i != 20; i += 2) { if (i == a) break; }
+                for (uint8 i = 0; i < 12; ++i) { if (i == a) continue; }
+                for (uint8 i = 0; i < 250; i += 20) { a += i; }
+                for (uint8 i = 5; i < 5; ++i) { break; }
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    settings.bound_loops = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    auto func = ctrt->definedFunctions()[0];
+
+    ostringstream actual, expect;
+    actual << *FunctionBlockConverter(*func, stack).convert();
+    expect << "{";
+    expect << "{sol_uint8_t func_user_i=Init_sol_uint8_t(0);"
+           << "{((self->user_a).v)=(((self->user_a).v)+((func_user_i).v));}"
+           << "++((func_user_i).v);"
+           << "{((self->user_a).v)=(((self->user_a).v)+((func_user_i).v));}"
+           << "++((func_user_i).v);}";
+    expect << "sol_uint8_t func_user_j=Init_sol_uint8_t(4);";
+    expect << "{{((self->user_a).v)=(((self->user_a).v)+((func_user_j).v));"
+           << "((func_user_j).v)=(((func_user_j).v)+(2));}"
+           << "{((self->user_a).v)=(((self->user_a).v)+((func_user_j).v));"
+           << "((func_user_j).v)=(((func_user_j).v)+(2));}}";
+    expect << "{uint64_t loop_0=0;"
+           << "for(sol_uint8_t func_user_i=Init_sol_uint8_t(0);"
+           << "((func_user_i).v)!=(20);"
+           << "((func_user_i).v)=(((func_user_i).v)+(2)))"
+           << "{++(loop_0);ll_assume((loop_0)<=(10));"
+           << "{if(((func_user_i).v)==((self->user_a).v))break;}}}";
+    expect << "{uint64_t loop_1=0;"
+           << "for(sol_uint8_t func_user_i=Init_sol_uint8_t(0);"
+           << "((func_user_i).v)<(12);++((func_user_i).v))"
+           << "{++(loop_1);ll_assume((loop_1)<=(12));"
+           << "{if(((func_user_i).v)==((self->user_a).v))continue;}}}";
+    expect << "for(sol_uint8_t func_user_i=Init_sol_uint8_t(0);"
+           << "((func_user_i).v)<(250);"
+           << "((func_user_i).v)=(((func_user_i).v)+(20)))"
+           << "{((self->user_a).v)=(((self->user_a).v)+((func_user_i).v));}";
+    expect << "for(sol_uint8_t func_user_i=Init_sol_uint8_t(5);"
+           << "((func_user_i).v)<(5);++((func_user_i).v)){break;}";
+    expect << "}";
+    BOOST_CHECK_EQUAL(actual.str(), expect.str());
+
+    // If instrumented, then each bound is labeled by a site.
+    settings.instrument = true;
+    auto instr_stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream instr;
+    instr << *FunctionBlockConverter(*func, instr_stack).convert();
+    auto expect_instr = expect.str();
+    for (size_t site = 0; site < 2; ++site)
+    {
+        string const CALL = "ll_assume(";
+        auto const POS = expect_instr.find(CALL);
+        BOOST_REQUIRE(POS != string::npos);
+        auto const LABEL = "SOL_ASSUME(" + to_string(site) + ",";
+        expect_instr.replace(POS, CALL.size(), LABEL);
+    }
+    BOOST_CHECK_EQUAL(instr.str(), expect_instr);
+}
+
 // Ensures continue statements remain unchanged.
 BOOST_AUTO_TEST_CASE(continue_statement)
 {
@@ -868,6 +955,141 @@ BOOST_AUTO_TEST_CASE(map_assignment)
     BOOST_CHECK_EQUAL(actual.str(), expected.str());
 }
 
+// Tests that map entries are served from temporaries within straight-line code,
+// and that the temporaries are dropped when the keys may alias.
+BOOST_AUTO_TEST_CASE(map_read_caching)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) a;
+            function f(address i) public {
+                require(a[msg.sender] >= 1);
+                a[msg.sender] -= 1;
+                a[i] += 1;
+                require(a[i] > 0);
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto const& func = *ctrt->definedFunctions()[0];
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto uncached_stack = make_shared<AnalysisStack>(model, full, settings);
+    settings.cache_map_reads = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    string const SENDER = ",Init_sol_address_t((sender).v)";
+    string const USER = ",Init_sol_address_t((func_user_i).v)";
+
+    ostringstream actual, expected;
+    actual << *FunctionBlockConverter(func, stack).convert();
+    expected << "{";
+    expected << "sol_uint256_t mapvar_0=Read_Map_1(&(self->user_a)"
+             << SENDER << ");";
+    expected << "sol_require(((mapvar_0).v)>=(1),0);";
+    expected << "Write_Map_1(&(self->user_a)" << SENDER
+             << ",Init_sol_uint256_t(((mapvar_0).v)-(1)));";
+    expected << "sol_uint256_t mapvar_1=Read_Map_1(&(self->user_a)"
+             << USER << ");";
+    expected << "Write_Map_1(&(self->user_a)" << USER
+             << ",(mapvar_1)=(Init_sol_uint256_t(((mapvar_1).v)+(1))));";
+    expected << "sol_require(((mapvar_1).v)>(0),0);";
+    expected << "}";
+    BOOST_CHECK_EQUAL(actual.str(), expected.str());
+
+    ostringstream uncached;
+    uncached << *FunctionBlockConverter(func, uncached_stack).convert();
+    BOOST_CHECK(uncached.str().find("mapvar_") == string::npos);
+}
+
+// Ensures that fixed-length arrays are accessed directly, through checked
+// indices, and that their lengths are constant.
+BOOST_AUTO_TEST_CASE(array_access)
+{
+    char const* text = R"(
+        contract A {
+            uint[4] a;
+            bool[2] b;
+            function f(uint8 i) public {
+                a[i] = 2;
+                a[i] += a.length;
+                b[1] = a[0] > 1;
+            }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto const& func = *ctrt->definedFunctions()[0];
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    string const A_I = "((((self->user_a).data)[Index_Array_sol_uint256_t_4("
+                       "Init_sol_uint256_t((func_user_i).v))]).v)";
+
+    ostringstream actual, expected;
+    actual << *FunctionBlockConverter(func, stack).convert();
+    expected << "{";
+    expected << A_I << "=(2);";
+    expected << A_I << "=(" << A_I << "+(4));";
+    expected << "((((self->user_b).data)"
+             << "[Index_Array_sol_bool_t_2(Init_sol_uint256_t(1))]).v)"
+             << "=(((((self->user_a).data)"
+             << "[Index_Array_sol_uint256_t_4(Init_sol_uint256_t(0))]).v)"
+             << ">(1));";
+    expected << "}";
+    BOOST_CHECK_EQUAL(actual.str(), expected.str());
+}
+
+// Ensures that arrays of the same type share a representation, so that one
+// array may be assigned to another.
+BOOST_AUTO_TEST_CASE(array_assignment)
+{
+    char const* text = R"(
+        contract A {
+            uint[3] a;
+            uint[3] b;
+            function f() public { b = a; }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto const& func = *ctrt->definedFunctions()[0];
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream actual, expected;
+    actual << *FunctionBlockConverter(func, stack).convert();
+    expected << "{(self->user_b)=(self->user_a);}";
+    BOOST_CHECK_EQUAL(actual.str(), expected.str());
+}
+
 // Tests all supported typecasts in their most explicit forms.
 BOOST_AUTO_TEST_CASE(type_casting)
 {
@@ -1233,6 +1455,63 @@ BOOST_AUTO_TEST_CASE(modifier_args)
     BOOST_CHECK_EQUAL(actual.str(), expected.str());
 }
 
+BOOST_AUTO_TEST_CASE(modifier_fusion)
+{
+    char const* text = R"(
+        contract A {
+            modifier modA(int a) {
+                require(a > 0);
+                _;
+            }
+            modifier modB() {
+                _;
+                return;
+            }
+            function f(int a) modA(a) public returns (int) { return a; }
+            function g() modA(1) modB() public { }
+        }
+    )";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto const& func_f = *ctrt->definedFunctions()[0];
+    auto const& func_g = *ctrt->definedFunctions()[1];
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    FunctionSpecialization spec_f(func_f);
+    FunctionSpecialization spec_g(func_g);
+    ModifierBlockConverter::Factory f_factory(stack, spec_f);
+    ModifierBlockConverter::Factory g_factory(stack, spec_g);
+    BOOST_CHECK(f_factory.fusable());
+    BOOST_CHECK(!g_factory.fusable());
+
+    auto next = make_shared<CBlock>(CBlockList{
+        make_shared<CReturn>(make_shared<CIdentifier>("func_user_a", false))
+    });
+
+    ostringstream expected, actual;
+    actual << *f_factory.generate(0, stack, next).convert();
+    expected << "{";
+    expected << "sol_int256_t func_model_rv;";
+    expected << "sol_int256_t func_user_a=Init_sol_int256_t("
+             << "(func_model_a).v);";
+    expected << "sol_require(((func_user_a).v)>(0),0);";
+    expected << "{return func_user_a;}";
+    expected << "return func_model_rv;";
+    expected << "}";
+
+    BOOST_CHECK_EQUAL(actual.str(), expected.str());
+}
+
 BOOST_AUTO_TEST_CASE(library_calls)
 {
     char const* text = R"(
@@ -1307,6 +1586,56 @@ BOOST_AUTO_TEST_CASE(crypto_calls)
     BOOST_CHECK_EQUAL(actual.str(), expected.str());
 }
 
+// Ensures that with native crypto, the operands of keccak256 are encoded as in
+// the ABI, and that all other hashes are still overapproximated.
+BOOST_AUTO_TEST_CASE(native_crypto_calls)
+{
+    char const* text = R"(
+        contract A {
+            function f(uint v, bytes4 t, bool b, int8 d) public pure {
+                keccak256(abi.encodePacked(v, b, t));
+                keccak256(abi.encode(t, d));
+                keccak256("");
+            }
+        }
+	)";
+
+    auto const& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "A");
+    auto func = ctrt->definedFunctions()[0];
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    settings.native_crypto = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream actual, expected;
+    actual << *FunctionBlockConverter(*func, stack).convert();
+
+    string const V = "((sol_raw_uint256_t)((func_user_v).v))";
+    string const T = "((sol_raw_uint256_t)((func_user_t).v))";
+    string const B = "((sol_raw_uint256_t)((func_user_b).v))";
+    string const D = "((sol_raw_uint256_t)((func_user_d).v))";
+    string const INIT = "SOL_KECCAK_INIT()";
+    expected << "{";
+    expected << "SOL_KECCAK_FINAL(SOL_KECCAK_UPDATE(SOL_KECCAK_UPDATE("
+             << "SOL_KECCAK_UPDATE(" << INIT << "," << V << ",32,0),"
+             << B << ",1,0)," << T << ",4,0));";
+    expected << "SOL_KECCAK_FINAL(SOL_KECCAK_UPDATE(SOL_KECCAK_UPDATE("
+             << "SOL_KECCAK_UPDATE(" << INIT << "," << T << ",4,0),0,28,0),"
+             << D << ",32,1));";
+    expected << "sol_crypto();";
+    expected << "}";
+
+    BOOST_CHECK_EQUAL(actual.str(), expected.str());
+}
+
 BOOST_AUTO_TEST_CASE(constants)
 {
     char const* text = R"(
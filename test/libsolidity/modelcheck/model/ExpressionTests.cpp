@@ -7,9 +7,11 @@
 #include <libsolidity/modelcheck/model/Expression.h>
 
 #include <boost/test/unit_test.hpp>
+#include <test/libsolidity/AnalysisFramework.h>
 
 #include <libsolidity/modelcheck/analysis/AnalysisStack.h>
 #include <libsolidity/modelcheck/analysis/VariableScope.h>
+#include <libsolidity/modelcheck/utils/Function.h>
 
 #include <sstream>
 #include <vector>
@@ -82,6 +84,7 @@ string _convert_bin_op(Token tok)
     id_b->annotation().type = new IntegerType(32);
 
     BinaryOperation op(SourceLocation(), id_a, tok, id_b);
+    op.annotation().commonType = id_a->annotation().type;
 
     AnalysisSettings settings;
     settings.aux_user_count = 0;
@@ -207,7 +210,14 @@ BOOST_AUTO_TEST_CASE(assignment_expression)
         _convert_assignment(Token::AssignMod),
         "((func_user_a).v)=(((func_user_a).v)%(((func_user_a).v)^((func_user_a).v)))"
     );
-    // TODO(scottwe): SAR, SHR
+    BOOST_CHECK_EQUAL(
+        _convert_assignment(Token::AssignSar),
+        "((func_user_a).v)=(sol_shr_u32((func_user_a).v,((func_user_a).v)^((func_user_a).v)))"
+    );
+    BOOST_CHECK_EQUAL(
+        _convert_assignment(Token::AssignShr),
+        "((func_user_a).v)=(sol_shr_u32((func_user_a).v,((func_user_a).v)^((func_user_a).v)))"
+    );
 }
 
 // Ensures that tuples of varying sizes are handled correctly.
@@ -288,8 +298,14 @@ BOOST_AUTO_TEST_CASE(binary_expression)
     BOOST_CHECK_EQUAL(
         _convert_bin_op(Token::SHL), "((func_user_a).v)<<((self->user_b).v)"
     );
-    // TODO(scottwe): Token::SAR test
-    // TODO(scottwe): Token::SHR test
+    BOOST_CHECK_EQUAL(
+        _convert_bin_op(Token::SAR),
+        "sol_shr_u32((func_user_a).v,(self->user_b).v)"
+    );
+    BOOST_CHECK_EQUAL(
+        _convert_bin_op(Token::SHR),
+        "sol_shr_u32((func_user_a).v,(self->user_b).v)"
+    );
     BOOST_CHECK_EQUAL(
         _convert_bin_op(Token::Add), "((func_user_a).v)+((self->user_b).v)"
     );
@@ -305,7 +321,10 @@ BOOST_AUTO_TEST_CASE(binary_expression)
     BOOST_CHECK_EQUAL(
         _convert_bin_op(Token::Mod), "((func_user_a).v)%((self->user_b).v)"
     );
-    // TODO(scottwe): Token::EXP test
+    BOOST_CHECK_EQUAL(
+        _convert_bin_op(Token::Exp),
+        "sol_exp_u32((func_user_a).v,(self->user_b).v)"
+    );
     BOOST_CHECK_EQUAL(
         _convert_bin_op(Token::Equal), "((func_user_a).v)==((self->user_b).v)"
     );
@@ -328,6 +347,85 @@ BOOST_AUTO_TEST_CASE(binary_expression)
     );
 }
 
+// Ensures that signed right shifts are arithmetic, and that exponentiation and
+// right shifts are folded when their right operand is constant.
+BOOST_AUTO_TEST_CASE(intrinsic_expression)
+{
+    auto name_a = make_shared<string>("a");
+    auto id_a = make_shared<Identifier>(SourceLocation(), name_a);
+    auto id_b = make_shared<Identifier>(
+        SourceLocation(), make_shared<string>("b")
+    );
+    id_a->annotation().type = new IntegerType(32);
+    id_b->annotation().type = new IntegerType(
+        32, IntegerType::Modifier::Signed
+    );
+
+    auto lit = [](string _val) {
+        auto lit = make_shared<Literal>(
+            SourceLocation(), Token::Number, make_shared<string>(_val)
+        );
+        lit->annotation().type = new RationalNumberType(
+            rational(stoi(_val))
+        );
+        return lit;
+    };
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto s = make_shared<AnalysisStack>(TEST_MODEL, TEST_UNITS, settings);
+    auto r = _prime_resolver(name_a);
+
+    auto convert = [&](
+        shared_ptr<Expression> _lhs, Token _op, shared_ptr<Expression> _rhs
+    ) {
+        BinaryOperation op(SourceLocation(), _lhs, _op, _rhs);
+        op.annotation().commonType = _lhs->annotation().type;
+        ostringstream oss;
+        oss << *ExpressionConverter(op, s, r).convert();
+        return oss.str();
+    };
+
+    BOOST_CHECK_EQUAL(
+        convert(id_b, Token::SAR, id_a),
+        "sol_sar_i32((self->user_b).v,(func_user_a).v)"
+    );
+    BOOST_CHECK_EQUAL(
+        convert(id_b, Token::SAR, lit("3")), "((self->user_b).v)>>(3)"
+    );
+    BOOST_CHECK_EQUAL(
+        convert(id_b, Token::SAR, lit("32")), "sol_sar_i32((self->user_b).v,32)"
+    );
+    BOOST_CHECK_EQUAL(
+        convert(id_a, Token::SAR, lit("31")), "((func_user_a).v)>>(31)"
+    );
+    BOOST_CHECK_EQUAL(
+        convert(id_a, Token::Exp, lit("3")), "sol_exp_u32((func_user_a).v,3)"
+    );
+    BOOST_CHECK_EQUAL(convert(id_a, Token::Exp, lit("1")), "(func_user_a).v");
+    BOOST_CHECK_THROW(convert(id_b, Token::Exp, lit("3")), runtime_error);
+    BOOST_CHECK_THROW(convert(id_b, Token::SHR, lit("3")), runtime_error);
+
+    // Constants are reduced modulo the width of the operation.
+    auto convert_const = [&](Token _op, Type const* _type) {
+        BinaryOperation op(SourceLocation(), lit("3"), _op, lit("6"));
+        op.annotation().commonType = new IntegerType(8);
+        op.annotation().type = _type;
+        ostringstream oss;
+        oss << *ExpressionConverter(op, s, r).convert();
+        return oss.str();
+    };
+    BOOST_CHECK_EQUAL(convert_const(Token::Exp, nullptr), "217");
+    BOOST_CHECK_EQUAL(convert_const(Token::SAR, nullptr), "0");
+
+    // Literal operations are folded by their exact value.
+    auto const* exact = new RationalNumberType(rational(729));
+    BOOST_CHECK_EQUAL(convert_const(Token::Exp, exact), "729");
+}
+
 // Ensures that identifiers are resolved, using the current scope.
 BOOST_AUTO_TEST_CASE(identifier_expression)
 {
@@ -396,6 +494,77 @@ BOOST_AUTO_TEST_CASE(literal_expression)
     );
 }
 
+// Ensures that SafeMath operations are lowered to checked operations, whether
+// they are bound or called directly, and that other library calls are kept.
+BOOST_FIXTURE_TEST_CASE(
+    checked_op_expression, ::dev::solidity::test::AnalysisFramework
+)
+{
+    char const* text = R"(
+        library SafeMath {
+            function add(uint256 a, uint256 b) internal pure returns (uint256) {
+                uint256 c = a + b;
+                require(c >= a, "SafeMath: addition overflow");
+                return c;
+            }
+            function avg(uint256 a, uint256 b) internal pure returns (uint256) {
+                return (a + b) / 2;
+            }
+        }
+        contract A {
+            using SafeMath for uint256;
+            uint256 x;
+            uint256 y;
+            function f() public view returns (uint256) { return x.add(y); }
+            function g() public view returns (uint256) {
+                return SafeMath.add(x, y);
+            }
+            function h() public view returns (uint256) { return x.avg(y); }
+        }
+    )";
+
+    auto const& ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    settings.escalate_reqs = true;
+    auto escalated = make_shared<AnalysisStack>(model, full, settings);
+
+    auto convert = [&](size_t _i, shared_ptr<AnalysisStack const> _stack) {
+        auto const& FUNC = *ctrt->definedFunctions()[_i];
+        auto const& STMT = *FUNC.body().statements()[0];
+        auto const& EXPR = *dynamic_cast<Return const&>(STMT).expression();
+
+        FunctionSpecialization spec(FUNC);
+        VariableScopeResolver resolver;
+        resolver.assign_spec(&spec);
+
+        ostringstream oss;
+        oss << *ExpressionConverter(EXPR, _stack, resolver).convert();
+        return oss.str();
+    };
+
+    string const CHECKED
+        = "sol_checked_add_u256((self->user_x).v,(self->user_y).v)";
+    BOOST_CHECK_EQUAL(convert(0, stack), CHECKED);
+    BOOST_CHECK_EQUAL(convert(1, stack), CHECKED);
+
+    // Other library calls, and all calls with escalated requires, are kept.
+    string const ARGS
+        = "Init_sol_uint256_t((self->user_x).v),"
+          "Init_sol_uint256_t((self->user_y).v)";
+    BOOST_CHECK_EQUAL(
+        convert(2, stack), "(SafeMath_Method_avg(" + ARGS + ")).v"
+    );
+    BOOST_CHECK_EQUAL(
+        convert(0, escalated), "(SafeMath_Method_add(reqfail," + ARGS + ")).v"
+    );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // -------------------------------------------------------------------------- //
@@ -10,6 +10,7 @@
 #include <test/libsolidity/AnalysisFramework.h>
 
 #include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/codegen/Details.h>
 #include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
 
 #include <sstream>
@@ -122,6 +123,105 @@ BOOST_AUTO_TEST_CASE(payable_method)
     BOOST_CHECK_EQUAL(actual.str(), expect.str());
 }
 
+// Checks that when simplification is enabled, each function body is simplified.
+BOOST_AUTO_TEST_CASE(simplified_method)
+{
+    char const* text = R"(
+        contract A {
+            function f() public payable returns (uint40) {
+                return 20;
+            }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+
+    ostringstream actual, expect;
+    CFuncDef::simplify_bodies(actual, true);
+    FunctionConverter(
+        stack, nd_reg, false, 1, FunctionConverter::View::FULL, false
+    ).print(actual);
+    expect << "void Init_A(struct A*self,sol_address_t sender,sol_uint256_t "
+           << "value,sol_uint256_t blocknum,sol_uint256_t timestamp,sol_bool_t "
+           << "paid,sol_address_t origin)";
+    expect << "{";
+    expect << "((self)->model_balance)=(Init_sol_uint256_t(0));";
+    expect << "}";
+    expect << "sol_uint40_t A_Method_f(struct A*self,sol_address_t sender"
+           << ",sol_uint256_t value,sol_uint256_t blocknum,sol_uint256_t "
+           << "timestamp,sol_bool_t paid,sol_address_t origin)";
+    expect << "{";
+    expect << "if(((paid).v)==(1))(((self)->model_balance).v)+=((value).v);";
+    expect << "return Init_sol_uint40_t(20);";
+    expect << "}";
+
+    BOOST_CHECK_EQUAL(actual.str(), expect.str());
+}
+
+// Checks that simplification removes the rewrapping of primitive values.
+BOOST_AUTO_TEST_CASE(simplified_rewrap)
+{
+    char const* text = R"(
+        contract A {
+            uint[3] arr;
+            function f(uint i) public view returns (uint) {
+                uint a = i;
+                return arr[a];
+            }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+
+    ostringstream actual, expect;
+    CFuncDef::simplify_bodies(actual, true);
+    FunctionConverter(
+        stack, nd_reg, false, 1, FunctionConverter::View::EXT, false
+    ).print(actual);
+    expect << "void Init_A(struct A*self,sol_address_t sender,sol_uint256_t "
+           << "value,sol_uint256_t blocknum,sol_uint256_t timestamp,sol_bool_t "
+           << "paid,sol_address_t origin)";
+    expect << "{";
+    expect << "((self)->model_balance)=(Init_sol_uint256_t(0));";
+    expect << "((self)->user_arr)=(ZeroInit_Array_sol_uint256_t_3());";
+    expect << "}";
+    expect << "sol_uint256_t A_Method_f(struct A*self,sol_address_t sender"
+           << ",sol_uint256_t value,sol_uint256_t blocknum,sol_uint256_t "
+           << "timestamp,sol_bool_t paid,sol_address_t origin,sol_uint256_t "
+           << "func_user_i)";
+    expect << "{";
+    expect << "sol_uint256_t func_user_a=func_user_i;";
+    expect << "return ((self->user_arr).data)"
+           << "[Index_Array_sol_uint256_t_3(func_user_a)];";
+    expect << "}";
+
+    BOOST_CHECK_EQUAL(actual.str(), expect.str());
+}
+
 // Ensures that each contract generates a function `Init_<contract>()`. This
 // method should set all simple members to 0, while setting all complex members
 // with their default constructors.
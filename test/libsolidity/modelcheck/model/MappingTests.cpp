@@ -9,6 +9,10 @@
 #include <boost/test/unit_test.hpp>
 #include <test/libsolidity/AnalysisFramework.h>
 
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/analysis/TypeAnalyzer.h>
+#include <libsolidity/modelcheck/codegen/Details.h>
+
 #include <sstream>
 
 using namespace std;
@@ -28,6 +32,155 @@ BOOST_FIXTURE_TEST_SUITE(
     Model_MappingTests, ::dev::solidity::test::AnalysisFramework
 )
 
+// Tests that array-backed maps store each entry in an array indexed by key, and
+// that out-of-bounds keys are caught.
+BOOST_AUTO_TEST_CASE(array_backed_map)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) m;
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    auto const* m = dynamic_cast<Mapping const*>(
+        ctrt->stateVariables()[0]->typeName()
+    );
+    BOOST_REQUIRE(m != nullptr);
+
+    MapGenerator gen(*m, false, 4, *stack->types(), true);
+
+    ostringstream actual_decl, actual_zero, actual_read, actual_write;
+    actual_decl << gen.declare(false);
+    actual_zero << gen.declare_zero_initializer(false);
+    actual_read << gen.declare_read(false);
+    actual_write << gen.declare_write(false);
+
+    ostringstream expect_decl, expect_zero, expect_read, expect_write;
+    expect_decl << "struct Map_1{sol_uint256_t data[4];};";
+    expect_zero << "struct Map_1 ZeroInit_Map_1(void)"
+                << "{"
+                << "struct Map_1 tmp;"
+                << "for(uint64_t i_0=0;(i_0)<(4);++(i_0))"
+                << "(((tmp).data)[i_0])=(Init_sol_uint256_t(0));"
+                << "return tmp;"
+                << "}";
+    expect_read << "sol_uint256_t Read_Map_1"
+                << "(struct Map_1*arr,sol_address_t key_0)"
+                << "{"
+                << "{"
+                << "sol_assert((4)>=((key_0).v),"
+                << "\"Model failure, mapping key out of bounds.\");"
+                << "if(((key_0).v)<(4))"
+                << "return ((arr)->data)[((uint64_t)((key_0).v))];"
+                << "}"
+                << "return Init_sol_uint256_t(0);"
+                << "}";
+    expect_write << "void Write_Map_1"
+                 << "(struct Map_1*arr,sol_address_t key_0,sol_uint256_t dat)"
+                 << "{"
+                 << "{"
+                 << "sol_assert((4)>=((key_0).v),"
+                 << "\"Model failure, mapping key out of bounds.\");"
+                 << "if(((key_0).v)<(4))"
+                 << "{"
+                 << "(((arr)->data)[((uint64_t)((key_0).v))])=(dat);"
+                 << "}"
+                 << "}"
+                 << "}";
+
+    BOOST_CHECK_EQUAL(actual_decl.str(), expect_decl.str());
+    BOOST_CHECK_EQUAL(actual_zero.str(), expect_zero.str());
+    BOOST_CHECK_EQUAL(actual_read.str(), expect_read.str());
+    BOOST_CHECK_EQUAL(actual_write.str(), expect_write.str());
+}
+
+// Tests that array-backed maps with several keys use one array dimension per
+// key, and that every key is bounds checked.
+BOOST_AUTO_TEST_CASE(array_backed_nested_map)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => mapping(address => bool)) m;
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    auto const* m = dynamic_cast<Mapping const*>(
+        ctrt->stateVariables()[0]->typeName()
+    );
+    BOOST_REQUIRE(m != nullptr);
+
+    MapGenerator gen(*m, false, 2, *stack->types(), true);
+
+    ostringstream actual_decl, actual_zero, actual_read, actual_write;
+    actual_decl << gen.declare(false);
+    actual_zero << gen.declare_zero_initializer(false);
+    actual_read << gen.declare_read(false);
+    actual_write << gen.declare_write(false);
+
+    string const BOUND_CHECK
+        = "\"Model failure, mapping key out of bounds.\");";
+    string const KEY_0 = "[((uint64_t)((key_0).v))]";
+    string const KEY_1 = "[((uint64_t)((key_1).v))]";
+
+    ostringstream expect_decl, expect_zero, expect_read, expect_write;
+    expect_decl << "struct Map_1{sol_bool_t data[2][2];};";
+    expect_zero << "struct Map_1 ZeroInit_Map_1(void)"
+                << "{"
+                << "struct Map_1 tmp;"
+                << "for(uint64_t i_0=0;(i_0)<(2);++(i_0))"
+                << "for(uint64_t i_1=0;(i_1)<(2);++(i_1))"
+                << "((((tmp).data)[i_0])[i_1])=(Init_sol_bool_t(0));"
+                << "return tmp;"
+                << "}";
+    expect_read << "sol_bool_t Read_Map_1"
+                << "(struct Map_1*arr,sol_address_t key_0,sol_address_t key_1)"
+                << "{"
+                << "{"
+                << "sol_assert((2)>=((key_0).v)," << BOUND_CHECK
+                << "sol_assert((2)>=((key_1).v)," << BOUND_CHECK
+                << "if((((key_0).v)<(2))&&(((key_1).v)<(2)))"
+                << "return (((arr)->data)" << KEY_0 << ")" << KEY_1 << ";"
+                << "}"
+                << "return Init_sol_bool_t(0);"
+                << "}";
+    expect_write << "void Write_Map_1"
+                 << "(struct Map_1*arr,sol_address_t key_0,"
+                 << "sol_address_t key_1,sol_bool_t dat)"
+                 << "{"
+                 << "{"
+                 << "sol_assert((2)>=((key_0).v)," << BOUND_CHECK
+                 << "sol_assert((2)>=((key_1).v)," << BOUND_CHECK
+                 << "if((((key_0).v)<(2))&&(((key_1).v)<(2)))"
+                 << "{"
+                 << "((((arr)->data)" << KEY_0 << ")" << KEY_1 << ")=(dat);"
+                 << "}"
+                 << "}"
+                 << "}";
+
+    BOOST_CHECK_EQUAL(actual_decl.str(), expect_decl.str());
+    BOOST_CHECK_EQUAL(actual_zero.str(), expect_zero.str());
+    BOOST_CHECK_EQUAL(actual_read.str(), expect_read.str());
+    BOOST_CHECK_EQUAL(actual_write.str(), expect_write.str());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //
@@ -35,4 +188,4 @@ BOOST_AUTO_TEST_SUITE_END();
 }
 }
 }
-}
\ No newline at end of file
+}
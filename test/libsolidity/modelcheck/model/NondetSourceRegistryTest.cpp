@@ -331,6 +331,90 @@ BOOST_AUTO_TEST_CASE(source_decls)
     BOOST_CHECK_EQUAL(actual.str(), expect.str());
 }
 
+BOOST_AUTO_TEST_CASE(batchable)
+{
+    IntegerType uint_type(32, IntegerType::Modifier::Unsigned);
+    IntegerType sint_type(32, IntegerType::Modifier::Signed);
+    AddressType addr_type(StateMutability::Payable);
+    BoolType bool_type;
+
+    BOOST_CHECK(NondetSourceRegistry::is_batchable(uint_type));
+    BOOST_CHECK(NondetSourceRegistry::is_batchable(sint_type));
+    BOOST_CHECK(!NondetSourceRegistry::is_batchable(addr_type));
+    BOOST_CHECK(!NondetSourceRegistry::is_batchable(bool_type));
+}
+
+BOOST_AUTO_TEST_CASE(raw_array)
+{
+    char const* text = "contract X {}";
+    const auto& unit = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(unit, "X");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &unit });
+
+    AnalysisSettings settings;
+    settings.aux_user_count = 0;
+    settings.use_concrete_users = false;
+    settings.use_global_contracts = false;
+    settings.escalate_reqs = false;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    IntegerType uint_type(32, IntegerType::Modifier::Unsigned);
+    IntegerType sint_type(32, IntegerType::Modifier::Signed);
+    BoolType bool_type;
+
+    NondetSourceRegistry reg(stack);
+    reg.byte("");
+
+    CBlockList block;
+    auto ubatch = reg.raw_array(block, uint_type, 3, "Blah");
+    auto sbatch = reg.raw_array(block, sint_type, 2, "Blah");
+    BOOST_CHECK_THROW(
+        reg.raw_array(block, bool_type, 2, "Blah"), std::runtime_error
+    );
+
+    std::ostringstream actual_block, expect_block;
+    actual_block << CBlock(move(block));
+    expect_block << "{"
+                 << "sol_raw_uint32_t nd_batch_1[3];"
+                 << "GET_ND_UINT_ARRAY(1,32,3,nd_batch_1,\"Blah\");"
+                 << "sol_raw_int32_t nd_batch_4[2];"
+                 << "GET_ND_INT_ARRAY(4,32,2,nd_batch_4,\"Blah\");"
+                 << "}";
+    BOOST_CHECK_EQUAL(actual_block.str(), expect_block.str());
+
+    auto idx = make_shared<CIntLiteral>(2);
+    auto elem = NondetSourceRegistry::simple_elem(uint_type, *ubatch, idx);
+
+    std::ostringstream actual_elem;
+    actual_elem << *elem;
+    BOOST_CHECK_EQUAL(actual_elem.str(), "Init_sol_uint32_t((nd_batch_1)[2])");
+
+    std::ostringstream actual_decls, expect_decls;
+    reg.print(actual_decls);
+    // Each value of a batch has its own source, and external requests are
+    // expanded to scalar requests.
+    expect_decls << "extern sol_raw_uint8_t sea_nd_0(void);"
+                 << "extern sol_raw_uint32_t sea_nd_1(void);"
+                 << "extern sol_raw_uint32_t sea_nd_2(void);"
+                 << "extern sol_raw_uint32_t sea_nd_3(void);"
+                 << "extern sol_raw_int32_t sea_nd_4(void);"
+                 << "extern sol_raw_int32_t sea_nd_5(void);"
+                 << endl << "#ifdef MC_USE_EXTERNAL_NONDET" << endl
+                 << "#define SEA_ND_BATCH_1(__out,__msg) do{"
+                 << "(__out)[0]=GET_ND_UINT(1,32,__msg);"
+                 << "(__out)[1]=GET_ND_UINT(2,32,__msg);"
+                 << "(__out)[2]=GET_ND_UINT(3,32,__msg);"
+                 << "}while(0)" << endl
+                 << "#define SEA_ND_BATCH_4(__out,__msg) do{"
+                 << "(__out)[0]=GET_ND_INT(4,32,__msg);"
+                 << "(__out)[1]=GET_ND_INT(5,32,__msg);"
+                 << "}while(0)" << endl
+                 << "#endif" << endl;
+    BOOST_CHECK_EQUAL(actual_decls.str(), expect_decls.str());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //
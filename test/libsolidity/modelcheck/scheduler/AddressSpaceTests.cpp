@@ -0,0 +1,160 @@
+/**
+ * Specific tests for libsolidity/modelcheck/scheduler/AddressSpace.
+ *
+ * @date 2021
+ */
+
+#include <libsolidity/modelcheck/scheduler/AddressSpace.h>
+
+#include <boost/test/unit_test.hpp>
+#include <test/libsolidity/AnalysisFramework.h>
+
+#include <libsolidity/modelcheck/analysis/AbstractAddressDomain.h>
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
+
+#include <sstream>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+namespace test
+{
+
+// -------------------------------------------------------------------------- //
+
+BOOST_FIXTURE_TEST_SUITE(
+    Scheduler_AddressSpaceTests, ::dev::solidity::test::AnalysisFramework
+)
+
+// Tests that with symmetry reduction, the next unused user is tracked, and each
+// selection of a user is either distinguished, already used, or the next user.
+BOOST_AUTO_TEST_CASE(canonicalize_users)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) m;
+            function f(address a, address b) public {
+                m[a] = 1;
+                m[b] = 2;
+            }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    settings.reduce_users = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+
+    auto const MIN_USER = stack->addresses()->implicit_count();
+    BOOST_REQUIRE_LT(MIN_USER + 1, stack->addresses()->max_sender());
+
+    AddressSpace addrspace(stack, nd_reg);
+    auto user = make_shared<CIdentifier>("user", false);
+
+    CBlockList decls;
+    addrspace.declare(decls);
+
+    CBlockList checks;
+    addrspace.canonicalize(checks, user);
+
+    ostringstream actual, expect;
+    actual << CBlock(decls) << CBlock(checks);
+    expect << "{"
+           << "sol_raw_uint160_t next_user;"
+           << "(next_user)=(" << MIN_USER << ");"
+           << "}";
+    expect << "{"
+           << "sol_require(((user)<(" << MIN_USER << "))"
+           << "||((user)<=(next_user)),\"Non-canonical user selection.\");"
+           << "if((user)==(next_user))(next_user)=((next_user)+(1));"
+           << "}";
+
+    BOOST_CHECK_EQUAL(actual.str(), expect.str());
+}
+
+// Tests that without symmetry reduction, no constraints are generated.
+BOOST_AUTO_TEST_CASE(canonicalize_disabled)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) m;
+            function f(address a, address b) public {
+                m[a] = 1;
+                m[b] = 2;
+            }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+
+    AddressSpace addrspace(stack, nd_reg);
+    auto user = make_shared<CIdentifier>("user", false);
+
+    CBlockList block;
+    addrspace.declare(block);
+    addrspace.canonicalize(block, user);
+    BOOST_CHECK(block.empty());
+}
+
+// Tests that a single interchangeable user is never canonicalized, as there is
+// no other user to which it could be relabeled.
+BOOST_AUTO_TEST_CASE(canonicalize_single_user)
+{
+    char const* text = R"(
+        contract A {
+            uint x;
+            function f() public { x = 1; }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    settings.reduce_users = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+
+    auto const MIN_USER = stack->addresses()->implicit_count();
+    BOOST_REQUIRE_EQUAL(MIN_USER + 1, stack->addresses()->max_sender());
+
+    AddressSpace addrspace(stack, nd_reg);
+    auto user = make_shared<CIdentifier>("user", false);
+
+    CBlockList block;
+    addrspace.declare(block);
+    addrspace.canonicalize(block, user);
+    BOOST_CHECK(block.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
+}
@@ -0,0 +1,431 @@
+/**
+ * Specific tests for libsolidity/modelcheck/scheduler/MainFunction.
+ *
+ * @date 2021
+ */
+
+#include <libsolidity/modelcheck/scheduler/MainFunction.h>
+
+#include <boost/test/unit_test.hpp>
+#include <test/libsolidity/AnalysisFramework.h>
+
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/model/Block.h>
+#include <libsolidity/modelcheck/model/NondetSourceRegistry.h>
+#include <libsolidity/modelcheck/scheduler/ActorModel.h>
+#include <libsolidity/modelcheck/scheduler/PartialOrderReduction.h>
+#include <libsolidity/modelcheck/utils/Function.h>
+
+#include <sstream>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace modelcheck
+{
+namespace test
+{
+
+// -------------------------------------------------------------------------- //
+
+namespace
+{
+// Returns the number of times _needle appears in _haystack.
+size_t count_of(string const& _haystack, string const& _needle)
+{
+    size_t count = 0;
+    auto pos = _haystack.find(_needle);
+    while (pos != string::npos)
+    {
+        ++count;
+        pos = _haystack.find(_needle, pos + _needle.size());
+    }
+    return count;
+}
+}
+
+// -------------------------------------------------------------------------- //
+
+BOOST_FIXTURE_TEST_SUITE(
+    Scheduler_MainFunctionTests, ::dev::solidity::test::AnalysisFramework
+)
+
+// Tests that with symmetry reduction, each sender and each address argument is
+// canonicalized as it is chosen.
+BOOST_AUTO_TEST_CASE(reduce_users)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) m;
+            function f(address a, address b) public {
+                m[a] = 1;
+                m[b] = 2;
+            }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    settings.reduce_users = true;
+    auto reduced_stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream reduced, plain;
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(reduced_stack);
+        MainFunctionGenerator(
+            false, CompInvarGenerator::Settings(), reduced_stack, nd_reg
+        ).print_main(reduced);
+    }
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+        MainFunctionGenerator(
+            false, CompInvarGenerator::Settings(), stack, nd_reg
+        ).print_main(plain);
+    }
+
+    string const MSG = "\"Non-canonical user selection.\"";
+    BOOST_CHECK_EQUAL(count_of(plain.str(), "next_user"), 0);
+    BOOST_CHECK_EQUAL(count_of(plain.str(), MSG), 0);
+
+    // Without invariants, there is no interference to check.
+    BOOST_CHECK_EQUAL(count_of(plain.str(), "if(sol_can_infer()){}"), 0);
+
+    // The sender of the constructor, the sender of f, and both arguments.
+    BOOST_CHECK_EQUAL(count_of(reduced.str(), MSG), 4);
+    BOOST_CHECK(
+        reduced.str().find("sol_raw_uint160_t next_user;") != string::npos
+    );
+    BOOST_CHECK(reduced.str().find(
+        "sol_require((((arg_a).v)<(2))||(((arg_a).v)<=(next_user)),"
+    ) != string::npos);
+    BOOST_CHECK(reduced.str().find(
+        "if(((arg_b).v)==(next_user))(next_user)=((next_user)+(1));"
+    ) != string::npos);
+}
+
+// Tests that with partial order reduction, a transaction may not follow a
+// larger transaction it commutes with, and that conflicting transactions are
+// scheduled in any order.
+BOOST_AUTO_TEST_CASE(partial_order_reduction)
+{
+    char const* text = R"(
+        contract A {
+            uint x;
+            uint y;
+            function f() public { x = 1; }
+            function g() public { y = 1; }
+            function h() public { x = 2; }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    settings.reduce_order = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    // Transactions f and g commute, whereas f and h both write to x.
+    auto actors_reg = make_shared<NondetSourceRegistry>(stack);
+    PartialOrderReduction por(stack, ActorModel(stack, actors_reg));
+    BOOST_CHECK_EQUAL(por.size(), 3);
+    BOOST_CHECK(por.commutes(0, 1));
+    BOOST_CHECK(por.commutes(1, 0));
+    BOOST_CHECK(!por.commutes(0, 2));
+    BOOST_CHECK(por.commutes(1, 2));
+
+    ostringstream actual;
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+    MainFunctionGenerator(
+        false, CompInvarGenerator::Settings(), stack, nd_reg
+    ).print_main(actual);
+
+    // Only the commuting successors of each transaction are excluded.
+    string const MSG = "\"Non-canonical transaction order.\"";
+    BOOST_CHECK(actual.str().find(
+        "uint8_t last_call;(last_call)=(3);"
+    ) != string::npos);
+    BOOST_CHECK(actual.str().find(
+        "sol_require((last_call)!=(1)," + MSG + ");(last_call)=(0);"
+    ) != string::npos);
+    BOOST_CHECK(actual.str().find(
+        "sol_require((last_call)!=(2)," + MSG + ");(last_call)=(1);"
+    ) != string::npos);
+    BOOST_CHECK(actual.str().find(
+        "sol_require((last_call)!=(0)"
+    ) == string::npos);
+    BOOST_CHECK_EQUAL(count_of(actual.str(), MSG), 2);
+}
+
+// Tests that with array-backed mappings, interference is applied by looping
+// over the backing array, rather than by unrolling each entry.
+BOOST_AUTO_TEST_CASE(array_map_interference)
+{
+    char const* text = R"(
+        contract A {
+            mapping(address => uint) m;
+            function f(address a) public { m[a] = m[a] + 1; }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    CompInvarGenerator::Settings invar_settings;
+    invar_settings.rule = CompInvarGenerator::InvarRule::Checked;
+    invar_settings.inferred = true;
+    invar_settings.array_maps = true;
+
+    ostringstream actual;
+    auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+    MainFunctionGenerator(
+        false, invar_settings, stack, nd_reg
+    ).print_main(actual);
+
+    // The invariant is checked for an arbitrary entry of the array.
+    string const DATA = "(((contract_1).user_m).data)[i_0]";
+    BOOST_CHECK(actual.str().find(
+        "uint64_t i_0;(i_0)=(GET_ND_RANGE(5,0,4,\"entry\"));"
+        "(v0)=((" + DATA + ").v);sassert(Inv_1(v0));"
+    ) != string::npos);
+
+    // Interference draws each entry as a batch, and then applies the batch in
+    // a single loop.
+    ostringstream expect;
+    expect << "if(sol_can_infer())"
+           << "{"
+           << "{"
+           << "sol_raw_uint256_t nd_batch_7[4];"
+           << "GET_ND_UINT_ARRAY(7,256,4,nd_batch_7,\"A::m::data\");"
+           << "for(uint64_t i_0=0;(i_0)<(4);++(i_0))"
+           << "{"
+           << "(" << DATA << ")=(Init_sol_uint256_t((nd_batch_7)[i_0]));"
+           << "assume(Inv_1((" << DATA << ").v));"
+           << "}"
+           << "}"
+           << "}";
+    BOOST_CHECK(actual.str().find(expect.str()) != string::npos);
+
+    // If entries are guarded, then each entry is drawn only if it is applied.
+    invar_settings.type = CompInvarGenerator::InvarType::RoleBased;
+
+    ostringstream guarded;
+    auto guarded_reg = make_shared<NondetSourceRegistry>(stack);
+    MainFunctionGenerator(
+        false, invar_settings, stack, guarded_reg
+    ).print_main(guarded);
+    BOOST_CHECK(guarded.str().find("nd_batch") == string::npos);
+    BOOST_CHECK(guarded.str().find(
+        "{(" + DATA + ")=(Init_sol_uint256_t(GET_ND_UINT("
+    ) != string::npos);
+}
+
+// Tests that in reentrant mode, all globals are lifted into a context which is
+// owned by run_model, and that each global resolves to its field.
+BOOST_AUTO_TEST_CASE(reentrant_context)
+{
+    char const* text = R"(
+        contract A {
+            address x;
+            function f() public { x = address(5); }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    settings.reentrant = true;
+    auto lifted_stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream plain_globals, lifted_globals, lifted_main;
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+        MainFunctionGenerator(
+            false, CompInvarGenerator::Settings(), stack, nd_reg
+        ).print_globals(plain_globals);
+    }
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(lifted_stack);
+        MainFunctionGenerator gen(
+            false, CompInvarGenerator::Settings(), lifted_stack, nd_reg
+        );
+        gen.print_globals(lifted_globals);
+        gen.print_main(lifted_main);
+    }
+
+    ostringstream expect_plain, expect_lifted;
+    expect_plain << "sol_raw_uint160_t g_literal_address_0;"
+                 << "sol_raw_uint160_t g_literal_address_5;";
+    expect_lifted << "struct sol_model_ctx"
+                  << "{"
+                  << "sol_raw_uint160_t g_literal_address_0;"
+                  << "sol_raw_uint160_t g_literal_address_5;"
+                  << "};"
+                  << "static SOL_THREAD_LOCAL "
+                  << "struct sol_model_ctx*g_model_ctx;";
+
+    BOOST_CHECK_EQUAL(plain_globals.str(), expect_plain.str());
+    BOOST_CHECK_EQUAL(lifted_globals.str(), expect_lifted.str());
+
+    // The context is a local of run_model, and is bound before any global is
+    // initialized.
+    string const PREFIX = "void run_model(void)"
+                          "{"
+                          "struct sol_model_ctx model_ctx;"
+                          "(g_model_ctx)=(&(model_ctx));";
+    BOOST_CHECK_EQUAL(lifted_main.str().find(PREFIX), 0);
+    BOOST_CHECK(lifted_main.str().find(
+        "(g_model_ctx->g_literal_address_0)=(0);"
+    ) != string::npos);
+    BOOST_CHECK(lifted_main.str().find(
+        "(g_model_ctx->g_literal_address_5)=(GET_ND_RANGE("
+    ) != string::npos);
+
+    // Each use of a global in the model resolves to its field.
+    auto const& func = *ctrt->definedFunctions()[0];
+    ostringstream plain_func, lifted_func;
+    plain_func << *FunctionBlockConverter(func, stack).convert();
+    lifted_func << *FunctionBlockConverter(func, lifted_stack).convert();
+    BOOST_CHECK_EQUAL(
+        plain_func.str(),
+        "{((self->user_x).v)=(g_literal_address_5);}"
+    );
+    BOOST_CHECK_EQUAL(
+        lifted_func.str(),
+        "{((self->user_x).v)=(g_model_ctx->g_literal_address_5);}"
+    );
+}
+
+// Tests that each transaction is marked for coverage, only if instrumented.
+BOOST_AUTO_TEST_CASE(instrumented_transactions)
+{
+    char const* text = R"(
+        contract A {
+            uint x;
+            function f() public { x = 1; }
+            function g() public { x = 2; }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+    settings.instrument = true;
+    auto instr_stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream plain, instrumented;
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+        MainFunctionGenerator(
+            false, CompInvarGenerator::Settings(), stack, nd_reg
+        ).print_main(plain);
+    }
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(instr_stack);
+        MainFunctionGenerator(
+            false, CompInvarGenerator::Settings(), instr_stack, nd_reg
+        ).print_main(instrumented);
+    }
+
+    BOOST_CHECK_EQUAL(count_of(plain.str(), "SOL_COVER_CALL"), 0);
+    BOOST_CHECK_EQUAL(count_of(instrumented.str(), "SOL_COVER_CALL"), 2);
+    BOOST_CHECK(
+        instrumented.str().find("case 0:{SOL_COVER_CALL(0);") != string::npos
+    );
+    BOOST_CHECK(
+        instrumented.str().find("case 1:{SOL_COVER_CALL(1);") != string::npos
+    );
+}
+
+// Tests that with snapshots, child actors are not saved to the world, as their
+// pointers would dangle once restored. Instead, each pointer is reassigned.
+BOOST_AUTO_TEST_CASE(snapshots_with_children)
+{
+    char const* text = R"(
+        contract B {
+            uint y;
+            function g() public { y = 1; }
+        }
+        contract A {
+            B child;
+            constructor() public { child = new B(); }
+            function f() public { child.g(); }
+        }
+    )";
+
+    auto const &ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    settings.snapshots = true;
+    auto stack = make_shared<AnalysisStack>(model, full, settings);
+
+    ostringstream actual;
+    {
+        auto nd_reg = make_shared<NondetSourceRegistry>(stack);
+        MainFunctionGenerator(
+            false, CompInvarGenerator::Settings(), stack, nd_reg
+        ).print_main(actual);
+    }
+
+    ostringstream expect_world;
+    expect_world << "struct sol_world"
+                 << "{"
+                 << "sol_raw_uint160_t g_literal_address_0;"
+                 << "sol_address_t last_sender;"
+                 << "sol_uint256_t blocknum;"
+                 << "sol_uint256_t timestamp;"
+                 << "sol_bool_t paid;"
+                 << "struct A contract_1;"
+                 << "};";
+    BOOST_CHECK_EQUAL(actual.str().find(expect_world.str()), 0);
+
+    // The child is declared once, and then bound by both setup and restore.
+    string const BIND = "(contract_2)=(&((contract_1).user_child));";
+    BOOST_CHECK_EQUAL(count_of(actual.str(), "struct B*contract_2;"), 1);
+    BOOST_CHECK_EQUAL(count_of(actual.str(), BIND), 2);
+    BOOST_CHECK(actual.str().find(
+        "(contract_1)=((world).contract_1);" + BIND + "}else {"
+    ) != string::npos);
+    BOOST_CHECK_EQUAL(count_of(actual.str(), "(world).contract_2"), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+// -------------------------------------------------------------------------- //
+
+}
+}
+}
+}
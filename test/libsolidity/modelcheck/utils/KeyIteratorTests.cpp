@@ -164,6 +164,24 @@ BOOST_AUTO_TEST_CASE(dim_3X2_offset_2)
     BOOST_CHECK(!itr.next());
 }
 
+BOOST_AUTO_TEST_CASE(ordinals)
+{
+    KeyIterator itr(3, 3, 1);
+
+    size_t expected = 0;
+    while (itr.next())
+    {
+        if (itr.size() == 3)
+        {
+            auto const& idx = itr.view();
+            BOOST_CHECK_EQUAL(itr.ordinal(), expected);
+            BOOST_CHECK_EQUAL(itr.ordinal(), idx[0] * 9 + idx[1] * 3 + idx[2]);
+            ++expected;
+        }
+    }
+    BOOST_CHECK_EQUAL(expected, 27);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // -------------------------------------------------------------------------- //
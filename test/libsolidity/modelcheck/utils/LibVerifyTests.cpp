@@ -9,6 +9,13 @@
 #include <boost/test/unit_test.hpp>
 #include <test/libsolidity/AnalysisFramework.h>
 
+#include <libsolidity/modelcheck/analysis/AnalysisStack.h>
+#include <libsolidity/modelcheck/codegen/Literals.h>
+
+#include <sstream>
+
+using namespace std;
+
 namespace dev
 {
 namespace solidity
@@ -24,6 +31,53 @@ BOOST_FIXTURE_TEST_SUITE(
     Utils_LibVerifyTests, ::dev::solidity::test::AnalysisFramework
 )
 
+BOOST_AUTO_TEST_CASE(instrumented_sites)
+{
+    char const* text = "contract A {}";
+
+    auto const& ast = *parseAndAnalyse(text);
+    auto ctrt = retrieveContractByName(ast, "A");
+
+    vector<ContractDefinition const*> model({ ctrt });
+    vector<SourceUnit const*> full({ &ast });
+
+    AnalysisSettings settings;
+    auto plain_stack = make_shared<AnalysisStack>(model, full, settings);
+    settings.instrument = true;
+    auto instr_stack = make_shared<AnalysisStack>(model, full, settings);
+
+    CBlockList plain_block, instr_block;
+    for (auto stack : { plain_stack, instr_stack })
+    {
+        auto & block = (stack == plain_stack) ? plain_block : instr_block;
+        LibVerify::add_cover_call(block, 3);
+        LibVerify::add_require(*stack, block, Literals::ONE);
+        LibVerify::add_require(*stack, block, Literals::ZERO, "msg");
+        LibVerify::add_assert(block, Literals::ONE);
+        LibVerify::add_assume(*stack, block, Literals::ONE);
+    }
+
+    // Sites are assigned once, so that reprinting a require preserves its site.
+    ostringstream plain, actual, expected;
+    for (auto stmt : plain_block) plain << *stmt;
+    for (auto stmt : instr_block) actual << *stmt;
+    for (auto stmt : instr_block) actual << *stmt;
+
+    expected << "SOL_COVER_CALL(3);";
+    expected << "SOL_REQUIRE(0,1,0);";
+    expected << "SOL_REQUIRE(1,0,\"msg\");";
+    expected << "sol_assert(1,0);";
+    expected << "SOL_ASSUME(2,1);";
+
+    BOOST_CHECK_EQUAL(
+        plain.str(),
+        "SOL_COVER_CALL(3);sol_require(1,0);"
+        "sol_require(0,\"msg\");sol_assert(1,0);ll_assume(1);"
+    );
+    BOOST_CHECK_EQUAL(actual.str(), expected.str() + expected.str());
+    BOOST_CHECK_EQUAL(instr_stack->next_site(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 // -------------------------------------------------------------------------- //